@@ -0,0 +1,486 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "bench_support.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "fission/nuklear_ui.h"
+
+#define FISSION_BENCH_FONT_HEIGHT 14.0f
+#define FISSION_BENCH_GLYPH_WIDTH 7.0f
+
+static const float fission_bench_dock_targets[FISSION_NK_PANEL_SLOT_COUNT][2] = {
+    {0.04f, 0.50f},
+    {0.50f, 0.50f},
+    {0.96f, 0.50f},
+    {0.50f, 0.04f},
+    {0.50f, 0.96f},
+    {0.04f, 0.04f},
+    {0.96f, 0.04f},
+    {0.04f, 0.96f},
+    {0.96f, 0.96f}
+};
+
+unsigned long long fission_bench_now_ns(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (unsigned long long)(
+        (double)counter.QuadPart * 1000000000.0 / (double)frequency.QuadPart
+    );
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)now.tv_sec * 1000000000ull + (unsigned long long)now.tv_nsec;
+#endif
+}
+
+static float fission_bench_font_width(
+    nk_handle handle,
+    float height,
+    const char *text,
+    int len
+)
+{
+    (void)handle;
+    (void)height;
+    (void)text;
+    return (float)len * FISSION_BENCH_GLYPH_WIDTH;
+}
+
+static void fission_bench_font_query(
+    nk_handle handle,
+    float font_height,
+    struct nk_user_font_glyph *glyph,
+    nk_rune codepoint,
+    nk_rune next_codepoint
+)
+{
+    (void)handle;
+    (void)codepoint;
+    (void)next_codepoint;
+
+    memset(glyph, 0, sizeof(*glyph));
+    glyph->width = FISSION_BENCH_GLYPH_WIDTH;
+    glyph->height = font_height;
+    glyph->xadvance = FISSION_BENCH_GLYPH_WIDTH;
+}
+
+static void fission_bench_panel_draw(
+    struct nk_context *ctx,
+    fission_nk_panel_workspace_t *workspace,
+    const char *panel_id,
+    int window_width,
+    int window_height,
+    void *user_data
+)
+{
+    fission_bench_panel_t *panel;
+    int row;
+
+    (void)panel_id;
+    (void)window_width;
+    (void)window_height;
+
+    panel = (fission_bench_panel_t *)user_data;
+    if (fission_nk_panel_workspace_begin_window_handle(ctx, workspace, panel->handle, NULL, 0u, NULL) != 0) {
+        nk_layout_row_dynamic(ctx, 20.0f, 2);
+        for (row = 0; row < panel->rows; ++row) {
+            nk_labelf(ctx, NK_TEXT_LEFT, "%s row %d", panel->title, row);
+            (void)nk_button_label(ctx, "Action");
+        }
+    }
+    fission_nk_panel_workspace_end_window_handle(ctx, workspace, panel->handle);
+    panel->draw_count += 1u;
+}
+
+void fission_bench_scene_panel_desc(
+    fission_bench_scene_t *scene,
+    size_t index,
+    fission_nk_panel_desc_t *out_desc
+)
+{
+    fission_bench_panel_t *panel;
+
+    panel = &scene->panels[index];
+    memset(out_desc, 0, sizeof(*out_desc));
+    out_desc->id = panel->id;
+    out_desc->title = panel->title;
+    out_desc->draw = fission_bench_panel_draw;
+    out_desc->user_data = panel;
+    out_desc->default_slot = (fission_nk_panel_slot_t)(index % FISSION_NK_PANEL_SLOT_COUNT);
+    out_desc->default_visible = 1;
+    out_desc->default_detachable = 1;
+    out_desc->default_detached_bounds.x = 80.0f + 36.0f * (float)(index % 32u);
+    out_desc->default_detached_bounds.y = 90.0f + 24.0f * (float)(index % 32u);
+    out_desc->default_detached_bounds.w = 320.0f;
+    out_desc->default_detached_bounds.h = 240.0f;
+}
+
+int fission_bench_scene_init(
+    fission_bench_scene_t *scene,
+    size_t panel_count,
+    int rows_per_panel,
+    int window_width,
+    int window_height
+)
+{
+    struct nk_allocator allocator;
+    fission_nk_panel_desc_t *descs;
+    fission_nk_panel_status_t status;
+    size_t i;
+
+    if (scene == NULL || panel_count == 0u || panel_count > FISSION_BENCH_MAX_PANELS) {
+        return 0;
+    }
+    if (window_width <= 0 || window_height <= 0) {
+        return 0;
+    }
+
+    memset(scene, 0, sizeof(*scene));
+    scene->window_width = window_width;
+    scene->window_height = window_height;
+    scene->mouse_x = window_width / 2;
+    scene->mouse_y = window_height / 2;
+
+    scene->font.userdata.ptr = NULL;
+    scene->font.height = FISSION_BENCH_FONT_HEIGHT;
+    scene->font.width = fission_bench_font_width;
+    scene->font.query = fission_bench_font_query;
+    scene->font.texture.id = 0;
+
+    fission_nk_counting_allocator_init(&scene->allocator);
+    fission_nk_counting_allocator_bind(&scene->allocator, &allocator);
+    if (!nk_init(&scene->ctx, &allocator, &scene->font)) {
+        return 0;
+    }
+    fission_nk_apply_theme(&scene->ctx);
+
+    /* Past the inline capacity the registry grows through the same counting allocator. */
+    if (panel_count > FISSION_NK_MAX_PANELS) {
+        fission_nk_counting_allocator_bind(&scene->allocator, &scene->panel_allocator);
+        if (
+            fission_nk_panel_workspace_init_dynamic(
+                &scene->workspace,
+                &scene->panel_allocator,
+                panel_count
+            ) != FISSION_NK_PANEL_STATUS_OK
+        ) {
+            fission_bench_scene_shutdown(scene);
+            return 0;
+        }
+    } else {
+        fission_nk_panel_workspace_init(&scene->workspace);
+    }
+
+    scene->panels = (fission_bench_panel_t *)calloc(panel_count, sizeof(*scene->panels));
+    if (scene->panels == NULL) {
+        fission_bench_scene_shutdown(scene);
+        return 0;
+    }
+
+    descs = (fission_nk_panel_desc_t *)malloc(panel_count * sizeof(*descs));
+    if (descs == NULL) {
+        fission_bench_scene_shutdown(scene);
+        return 0;
+    }
+    for (i = 0u; i < panel_count; ++i) {
+        fission_bench_panel_t *panel;
+
+        panel = &scene->panels[i];
+        (void)snprintf(panel->id, sizeof(panel->id), "bench.panel.%02u", (unsigned int)i);
+        (void)snprintf(panel->title, sizeof(panel->title), "Panel %02u", (unsigned int)i);
+        panel->rows = rows_per_panel;
+        fission_bench_scene_panel_desc(scene, i, &descs[i]);
+    }
+
+    status = fission_nk_panel_workspace_register_many(&scene->workspace, descs, panel_count);
+    free(descs);
+    if (status != FISSION_NK_PANEL_STATUS_OK) {
+        fission_bench_scene_shutdown(scene);
+        return 0;
+    }
+    for (i = 0u; i < panel_count; ++i) {
+        scene->panels[i].handle = fission_nk_panel_workspace_handle_at(&scene->workspace, i);
+        if ((i % 5u) == 4u) {
+            (void)fission_nk_panel_workspace_set_panel_detached_at(&scene->workspace, i, 1);
+        }
+    }
+    scene->panel_count = panel_count;
+
+    return 1;
+}
+
+void fission_bench_scene_shutdown(fission_bench_scene_t *scene)
+{
+    if (scene == NULL) {
+        return;
+    }
+
+    fission_nk_panel_workspace_shutdown(&scene->workspace);
+    nk_free(&scene->ctx);
+    free(scene->panels);
+    scene->panels = NULL;
+    scene->panel_count = 0u;
+}
+
+static int fission_bench_triangle_wave(unsigned long step, int amplitude)
+{
+    unsigned long period;
+    unsigned long t;
+
+    period = (unsigned long)amplitude * 2u;
+    if (period == 0u) {
+        return 0;
+    }
+    t = step % period;
+    if (t < (unsigned long)amplitude) {
+        return (int)t;
+    }
+    return (int)(period - t);
+}
+
+static int fission_bench_find_docked_panel(
+    const fission_bench_scene_t *scene,
+    size_t start,
+    fission_nk_panel_bounds_t *out_bounds
+)
+{
+    size_t i;
+
+    for (i = 0u; i < scene->panel_count; ++i) {
+        size_t index;
+
+        index = (start + i) % scene->panel_count;
+        if (
+            fission_nk_panel_workspace_panel_is_visible_at(&scene->workspace, index) == 0 ||
+            fission_nk_panel_workspace_panel_is_detached_at(&scene->workspace, index) != 0
+        ) {
+            continue;
+        }
+        if (
+            fission_nk_panel_workspace_get_panel_bounds(
+                &scene->workspace,
+                scene->panels[index].id,
+                out_bounds
+            ) == FISSION_NK_PANEL_STATUS_OK
+        ) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void fission_bench_scene_script_input(
+    fission_bench_scene_t *scene,
+    unsigned long frame
+)
+{
+    struct nk_context *ctx;
+    const fission_nk_panel_workspace_t *workspace;
+    unsigned long phase;
+    unsigned long cycle;
+    int x;
+    int y;
+    int down;
+    float scroll;
+
+    if (scene == NULL) {
+        return;
+    }
+
+    ctx = &scene->ctx;
+    workspace = &scene->workspace;
+    phase = frame % FISSION_BENCH_SCRIPT_PERIOD;
+    cycle = frame / FISSION_BENCH_SCRIPT_PERIOD;
+    x = scene->mouse_x;
+    y = scene->mouse_y;
+    down = 0;
+    scroll = 0.0f;
+
+    if (phase < 160u) {
+        x = 16 + (int)((phase * 37u) % (unsigned long)(scene->window_width - 32));
+        y = 48 + (int)((phase * 23u) % (unsigned long)(scene->window_height - 64));
+        if ((phase % 6u) == 0u) {
+            scroll = -1.0f;
+        }
+    } else if (phase < 240u) {
+        if (phase == 160u) {
+            const fission_nk_panel_bounds_t *splitter;
+
+            splitter = ((cycle % 2u) == 0u) ?
+                &workspace->splitter_left_bounds :
+                &workspace->splitter_bottom_bounds;
+            if (splitter->w > 0.0f && splitter->h > 0.0f) {
+                scene->drag_origin_x = (int)(splitter->x + splitter->w * 0.5f);
+                scene->drag_origin_y = (int)(splitter->y + splitter->h * 0.5f);
+            } else {
+                scene->drag_origin_x = x;
+                scene->drag_origin_y = y;
+            }
+            x = scene->drag_origin_x;
+            y = scene->drag_origin_y;
+        } else if (phase < 239u) {
+            int offset;
+
+            offset = fission_bench_triangle_wave(phase - 161u, 40) * 2;
+            x = scene->drag_origin_x;
+            y = scene->drag_origin_y;
+            if ((cycle % 2u) == 0u) {
+                x += offset;
+            } else {
+                y -= offset;
+            }
+            down = 1;
+        }
+    } else if (phase < 320u) {
+        if (phase == 240u) {
+            fission_nk_panel_bounds_t bounds;
+
+            if (fission_bench_find_docked_panel(scene, (size_t)cycle, &bounds) != 0) {
+                scene->drag_origin_x = (int)bounds.x + 24;
+                scene->drag_origin_y = (int)bounds.y + 10;
+            } else {
+                scene->drag_origin_x = x;
+                scene->drag_origin_y = y;
+            }
+            x = scene->drag_origin_x;
+            y = scene->drag_origin_y;
+        } else if (phase < 319u) {
+            const float *target;
+            float t;
+            float target_x;
+            float target_y;
+
+            target = fission_bench_dock_targets[cycle % FISSION_NK_PANEL_SLOT_COUNT];
+            target_x = workspace->dock_workspace_bounds.x + workspace->dock_workspace_bounds.w * target[0];
+            target_y = workspace->dock_workspace_bounds.y + workspace->dock_workspace_bounds.h * target[1];
+            t = (float)(phase - 241u) / 60.0f;
+            if (t > 1.0f) {
+                t = 1.0f;
+            }
+            x = scene->drag_origin_x + (int)((target_x - (float)scene->drag_origin_x) * t);
+            y = scene->drag_origin_y + (int)((target_y - (float)scene->drag_origin_y) * t);
+            down = 1;
+        }
+    } else {
+        x = 24 + (int)(((phase - 320u) * 19u) % (unsigned long)(scene->window_width - 48));
+        y = 64 + (int)(((phase - 320u) * 11u) % (unsigned long)(scene->window_height - 96));
+        if ((phase % 3u) == 0u) {
+            scroll = ((phase % 2u) == 0u) ? -1.0f : 1.0f;
+        }
+    }
+
+    nk_input_begin(ctx);
+    nk_input_motion(ctx, x, y);
+    nk_input_button(ctx, NK_BUTTON_LEFT, x, y, down != 0);
+    if (scroll != 0.0f) {
+        nk_input_scroll(ctx, nk_vec2(0.0f, scroll));
+    }
+    nk_input_end(ctx);
+
+    scene->mouse_x = x;
+    scene->mouse_y = y;
+    scene->mouse_down = down;
+}
+
+size_t fission_bench_scene_window_count(const fission_bench_scene_t *scene)
+{
+    const struct nk_window *window;
+    size_t count;
+
+    if (scene == NULL) {
+        return 0u;
+    }
+
+    count = 0u;
+    for (window = scene->ctx.begin; window != NULL; window = window->next) {
+        if (window->seq == scene->ctx.seq) {
+            count += 1u;
+        }
+    }
+    return count;
+}
+
+size_t fission_bench_scene_command_bytes(const fission_bench_scene_t *scene)
+{
+    if (scene == NULL) {
+        return 0u;
+    }
+    return (size_t)scene->ctx.memory.allocated;
+}
+
+static int fission_bench_compare_u64(const void *a, const void *b)
+{
+    unsigned long long lhs;
+    unsigned long long rhs;
+
+    lhs = *(const unsigned long long *)a;
+    rhs = *(const unsigned long long *)b;
+    if (lhs < rhs) {
+        return -1;
+    }
+    return (lhs > rhs) ? 1 : 0;
+}
+
+static unsigned long long fission_bench_percentile(
+    const unsigned long long *sorted,
+    size_t count,
+    unsigned int percent
+)
+{
+    size_t rank;
+
+    rank = (count * percent + 99u) / 100u;
+    if (rank == 0u) {
+        rank = 1u;
+    }
+    return sorted[rank - 1u];
+}
+
+void fission_bench_summarize(
+    unsigned long long *samples,
+    size_t count,
+    fission_bench_summary_t *out_summary
+)
+{
+    size_t i;
+    double total;
+
+    if (out_summary == NULL) {
+        return;
+    }
+    memset(out_summary, 0, sizeof(*out_summary));
+    if (samples == NULL || count == 0u) {
+        return;
+    }
+
+    qsort(samples, count, sizeof(samples[0]), fission_bench_compare_u64);
+
+    total = 0.0;
+    for (i = 0u; i < count; ++i) {
+        total += (double)samples[i];
+    }
+
+    out_summary->min = samples[0];
+    out_summary->p50 = fission_bench_percentile(samples, count, 50u);
+    out_summary->p90 = fission_bench_percentile(samples, count, 90u);
+    out_summary->p99 = fission_bench_percentile(samples, count, 99u);
+    out_summary->max = samples[count - 1u];
+    out_summary->mean = total / (double)count;
+}
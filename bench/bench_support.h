@@ -0,0 +1,81 @@
+#ifndef FISSION_BENCH_SUPPORT_H
+#define FISSION_BENCH_SUPPORT_H
+
+#include <stddef.h>
+
+#include "fission/nuklear.h"
+#include "fission/nuklear_alloc.h"
+#include "fission/nuklear_panels.h"
+
+#define FISSION_BENCH_PANEL_ID_MAX 32
+#define FISSION_BENCH_PANEL_TITLE_MAX 48
+#define FISSION_BENCH_SCRIPT_PERIOD 480u
+#define FISSION_BENCH_MAX_PANELS 4096u
+
+typedef struct fission_bench_panel {
+    char id[FISSION_BENCH_PANEL_ID_MAX];
+    char title[FISSION_BENCH_PANEL_TITLE_MAX];
+    fission_nk_panel_handle_t handle;
+    int rows;
+    unsigned long long draw_count;
+} fission_bench_panel_t;
+
+typedef struct fission_bench_scene {
+    struct nk_context ctx;
+    fission_nk_counting_allocator_t allocator;
+    struct nk_allocator panel_allocator;
+    struct nk_user_font font;
+    fission_nk_panel_workspace_t workspace;
+    fission_bench_panel_t *panels;
+    size_t panel_count;
+    int window_width;
+    int window_height;
+    int mouse_x;
+    int mouse_y;
+    int mouse_down;
+    int drag_origin_x;
+    int drag_origin_y;
+} fission_bench_scene_t;
+
+typedef struct fission_bench_summary {
+    unsigned long long min;
+    unsigned long long p50;
+    unsigned long long p90;
+    unsigned long long p99;
+    unsigned long long max;
+    double mean;
+} fission_bench_summary_t;
+
+unsigned long long fission_bench_now_ns(void);
+
+int fission_bench_scene_init(
+    fission_bench_scene_t *scene,
+    size_t panel_count,
+    int rows_per_panel,
+    int window_width,
+    int window_height
+);
+void fission_bench_scene_shutdown(fission_bench_scene_t *scene);
+
+/* The desc scene_init registers for panel `index`, for benches that re-register panels. */
+void fission_bench_scene_panel_desc(
+    fission_bench_scene_t *scene,
+    size_t index,
+    fission_nk_panel_desc_t *out_desc
+);
+
+void fission_bench_scene_script_input(
+    fission_bench_scene_t *scene,
+    unsigned long frame
+);
+
+size_t fission_bench_scene_window_count(const fission_bench_scene_t *scene);
+size_t fission_bench_scene_command_bytes(const fission_bench_scene_t *scene);
+
+void fission_bench_summarize(
+    unsigned long long *samples,
+    size_t count,
+    fission_bench_summary_t *out_summary
+);
+
+#endif
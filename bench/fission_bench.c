@@ -0,0 +1,358 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_support.h"
+#include "fission/nuklear_input_record.h"
+
+typedef struct fission_bench_options {
+    size_t panel_count;
+    unsigned long frames;
+    unsigned long warmup_frames;
+    int rows_per_panel;
+    int window_width;
+    int window_height;
+    const char *record_path;
+    const char *replay_path;
+} fission_bench_options_t;
+
+static void fission_bench_print_usage(const char *program)
+{
+    fprintf(
+        stderr,
+        "usage: %s [--panels N] [--frames N] [--warmup N] [--rows N] [--width W] [--height H]"
+        " [--record FILE | --replay FILE]\n",
+        program
+    );
+}
+
+static int fission_bench_parse_ulong(const char *text, unsigned long *out_value)
+{
+    char *end;
+    unsigned long value;
+
+    if (text == NULL || text[0] == '\0') {
+        return 0;
+    }
+    value = strtoul(text, &end, 10);
+    if (end == NULL || *end != '\0') {
+        return 0;
+    }
+    *out_value = value;
+    return 1;
+}
+
+static int fission_bench_parse_options(
+    int argc,
+    char **argv,
+    fission_bench_options_t *options
+)
+{
+    int i;
+
+    options->panel_count = 28u;
+    options->frames = 5000u;
+    options->warmup_frames = 240u;
+    options->rows_per_panel = 12;
+    options->window_width = 1600;
+    options->window_height = 900;
+    options->record_path = NULL;
+    options->replay_path = NULL;
+
+    for (i = 1; i < argc; ++i) {
+        unsigned long value;
+
+        if (i + 1 < argc && strcmp(argv[i], "--record") == 0) {
+            options->record_path = argv[i + 1];
+            i += 1;
+            continue;
+        }
+        if (i + 1 < argc && strcmp(argv[i], "--replay") == 0) {
+            options->replay_path = argv[i + 1];
+            i += 1;
+            continue;
+        }
+        if (i + 1 >= argc || fission_bench_parse_ulong(argv[i + 1], &value) == 0) {
+            return 0;
+        }
+
+        if (strcmp(argv[i], "--panels") == 0) {
+            if (value == 0u || value > FISSION_BENCH_MAX_PANELS) {
+                return 0;
+            }
+            options->panel_count = (size_t)value;
+        } else if (strcmp(argv[i], "--frames") == 0) {
+            if (value == 0u) {
+                return 0;
+            }
+            options->frames = value;
+        } else if (strcmp(argv[i], "--warmup") == 0) {
+            options->warmup_frames = value;
+        } else if (strcmp(argv[i], "--rows") == 0) {
+            options->rows_per_panel = (int)value;
+        } else if (strcmp(argv[i], "--width") == 0) {
+            if (value < 320u) {
+                return 0;
+            }
+            options->window_width = (int)value;
+        } else if (strcmp(argv[i], "--height") == 0) {
+            if (value < 240u) {
+                return 0;
+            }
+            options->window_height = (int)value;
+        } else {
+            return 0;
+        }
+        i += 1;
+    }
+
+    return options->record_path == NULL || options->replay_path == NULL;
+}
+
+static void fission_bench_print_summary(
+    const char *label,
+    const fission_bench_summary_t *summary
+)
+{
+    printf(
+        "%-14s min=%llu p50=%llu p90=%llu p99=%llu max=%llu mean=%.1f\n",
+        label,
+        summary->min,
+        summary->p50,
+        summary->p90,
+        summary->p99,
+        summary->max,
+        summary->mean
+    );
+}
+
+int main(int argc, char **argv)
+{
+    fission_bench_options_t options;
+    fission_bench_scene_t *scene;
+    unsigned long long *frame_ns;
+    unsigned long long *command_bytes;
+    unsigned long long *window_counts;
+    unsigned long long *chrome_bytes;
+    unsigned long long *heap_churn;
+    fission_nk_alloc_stats_t heap_stats;
+    fission_nk_frame_breakdown_t breakdown;
+    fission_nk_panel_counters_t counters;
+    fission_nk_input_recorder_t recorder;
+    fission_nk_input_player_t player;
+    int recording;
+    int replaying;
+    fission_bench_summary_t summary;
+    unsigned long total_frames;
+    unsigned long frame;
+    size_t sample_count;
+
+    if (fission_bench_parse_options(argc, argv, &options) == 0) {
+        fission_bench_print_usage(argv[0]);
+        return 2;
+    }
+
+    scene = (fission_bench_scene_t *)calloc(1u, sizeof(*scene));
+    frame_ns = (unsigned long long *)calloc(options.frames, sizeof(*frame_ns));
+    command_bytes = (unsigned long long *)calloc(options.frames, sizeof(*command_bytes));
+    window_counts = (unsigned long long *)calloc(options.frames, sizeof(*window_counts));
+    chrome_bytes = (unsigned long long *)calloc(options.frames, sizeof(*chrome_bytes));
+    heap_churn = (unsigned long long *)calloc(options.frames, sizeof(*heap_churn));
+    if (
+        scene == NULL ||
+        frame_ns == NULL ||
+        command_bytes == NULL ||
+        window_counts == NULL ||
+        chrome_bytes == NULL ||
+        heap_churn == NULL
+    ) {
+        fprintf(stderr, "fission_bench: out of memory\n");
+        free(heap_churn);
+        free(chrome_bytes);
+        free(window_counts);
+        free(command_bytes);
+        free(frame_ns);
+        free(scene);
+        return 1;
+    }
+
+    recording = 0;
+    replaying = 0;
+    if (options.replay_path != NULL) {
+        if (fission_nk_input_player_open(&player, options.replay_path) == 0) {
+            fprintf(stderr, "fission_bench: cannot read input session '%s'\n", options.replay_path);
+            free(heap_churn);
+            free(chrome_bytes);
+            free(window_counts);
+            free(command_bytes);
+            free(frame_ns);
+            free(scene);
+            return 1;
+        }
+        options.window_width = player.initial_width;
+        options.window_height = player.initial_height;
+        replaying = 1;
+    }
+
+    if (
+        fission_bench_scene_init(
+            scene,
+            options.panel_count,
+            options.rows_per_panel,
+            options.window_width,
+            options.window_height
+        ) == 0
+    ) {
+        fprintf(stderr, "fission_bench: failed to initialize benchmark scene\n");
+        if (replaying != 0) {
+            fission_nk_input_player_close(&player);
+        }
+        free(heap_churn);
+        free(chrome_bytes);
+        free(window_counts);
+        free(command_bytes);
+        free(frame_ns);
+        free(scene);
+        return 1;
+    }
+
+    fission_nk_panel_counters_reset(&counters);
+    fission_nk_panel_workspace_set_counters(&scene->workspace, &counters);
+
+    if (options.record_path != NULL) {
+        if (
+            fission_nk_input_recorder_open(
+                &recorder,
+                options.record_path,
+                options.window_width,
+                options.window_height
+            ) == 0
+        ) {
+            fprintf(stderr, "fission_bench: cannot write input session '%s'\n", options.record_path);
+        } else {
+            recording = 1;
+        }
+    }
+
+    total_frames = options.warmup_frames + options.frames;
+    sample_count = 0u;
+    for (frame = 0u; frame < total_frames; ++frame) {
+        unsigned long long start_ns;
+        unsigned long long end_ns;
+
+        if (replaying != 0) {
+            if (
+                fission_nk_input_player_next(
+                    &player,
+                    &scene->ctx,
+                    &scene->window_width,
+                    &scene->window_height
+                ) == 0
+            ) {
+                break;
+            }
+        } else {
+            fission_bench_scene_script_input(scene, frame);
+        }
+        if (recording != 0) {
+            (void)fission_nk_input_recorder_capture(
+                &recorder,
+                &scene->ctx,
+                scene->window_width,
+                scene->window_height
+            );
+        }
+
+        if (frame == options.warmup_frames) {
+            fission_nk_panel_counters_reset(&counters);
+        }
+        start_ns = fission_bench_now_ns();
+        fission_nk_panel_workspace_draw_all(
+            &scene->workspace,
+            &scene->ctx,
+            scene->window_width,
+            scene->window_height
+        );
+        end_ns = fission_bench_now_ns();
+
+        if (frame >= options.warmup_frames) {
+            frame_ns[sample_count] = end_ns - start_ns;
+            command_bytes[sample_count] = (unsigned long long)fission_bench_scene_command_bytes(scene);
+            window_counts[sample_count] = (unsigned long long)fission_bench_scene_window_count(scene);
+            (void)fission_nk_measure_frame(&scene->ctx, NULL, NULL, 0u, &breakdown);
+            chrome_bytes[sample_count] = (unsigned long long)breakdown.chrome.totals.command_bytes;
+        }
+
+        nk_clear(&scene->ctx);
+        fission_nk_counting_allocator_end_frame(&scene->allocator);
+
+        if (frame >= options.warmup_frames) {
+            fission_nk_counting_allocator_snapshot(&scene->allocator, &heap_stats);
+            heap_churn[sample_count] = heap_stats.frame_allocated_bytes + heap_stats.frame_freed_bytes;
+            sample_count += 1u;
+        }
+    }
+
+    if (replaying != 0) {
+        if (player.failed != 0) {
+            fprintf(stderr, "fission_bench: input session '%s' is malformed\n", options.replay_path);
+        }
+        fission_nk_input_player_close(&player);
+    }
+    if (recording != 0 && fission_nk_input_recorder_close(&recorder) == 0) {
+        fprintf(stderr, "fission_bench: failed writing input session '%s'\n", options.record_path);
+    }
+
+    printf(
+        "fission_bench: panels=%u rows=%d frames=%lu warmup=%lu window=%dx%d\n",
+        (unsigned int)options.panel_count,
+        options.rows_per_panel,
+        (unsigned long)sample_count,
+        options.warmup_frames,
+        options.window_width,
+        options.window_height
+    );
+
+    fission_bench_summarize(frame_ns, sample_count, &summary);
+    fission_bench_print_summary("frame ns", &summary);
+    fission_bench_summarize(command_bytes, sample_count, &summary);
+    fission_bench_print_summary("command bytes", &summary);
+    fission_bench_summarize(window_counts, sample_count, &summary);
+    fission_bench_print_summary("windows", &summary);
+    fission_bench_summarize(chrome_bytes, sample_count, &summary);
+    fission_bench_print_summary("chrome bytes", &summary);
+    fission_bench_summarize(heap_churn, sample_count, &summary);
+    fission_bench_print_summary("heap churn", &summary);
+
+    fission_nk_counting_allocator_snapshot(&scene->allocator, &heap_stats);
+    printf(
+        "%-14s live=%lu peak=%lu blocks=%lu allocs=%llu frees=%llu\n",
+        "heap bytes",
+        (unsigned long)heap_stats.live_bytes,
+        (unsigned long)heap_stats.peak_bytes,
+        (unsigned long)heap_stats.live_allocations,
+        heap_stats.allocation_count,
+        heap_stats.free_count
+    );
+
+    if (fission_nk_panel_counters_instrumentation_enabled() != 0 && counters.frames > 0u) {
+        int counter;
+
+        for (counter = 0; counter < FISSION_NK_PANEL_COUNTER_COUNT; ++counter) {
+            printf(
+                "%-22s %.1f/frame\n",
+                fission_nk_panel_counter_name((fission_nk_panel_counter_t)counter),
+                (double)counters.total[counter] / (double)counters.frames
+            );
+        }
+    }
+
+    fission_bench_scene_shutdown(scene);
+    free(heap_churn);
+    free(chrome_bytes);
+    free(window_counts);
+    free(command_bytes);
+    free(frame_ns);
+    free(scene);
+    return 0;
+}
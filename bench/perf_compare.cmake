@@ -0,0 +1,179 @@
+# Runs fission_perf_suite and checks its JSON results against a baseline.
+#
+# Each baseline case is an object. ns_per_iter is compared with the tolerance; the *_per_kiter
+# work counters do not depend on the machine and are upper bounds compared exactly. Every case
+# the suite runs needs at least one seeded metric, otherwise the test fails.
+#
+# Required: -DFISSION_PERF_SUITE=<exe> -DFISSION_PERF_RESULTS=<json> -DFISSION_PERF_BASELINE=<json>
+# Optional: -DFISSION_PERF_TOLERANCE_PERCENT=<n> (overrides the baseline's tolerance_percent)
+#           -DFISSION_PERF_MODE=UPDATE (rewrites the baseline from this run instead of comparing)
+cmake_minimum_required(VERSION 3.20)
+
+foreach(fission_perf_var IN ITEMS FISSION_PERF_SUITE FISSION_PERF_RESULTS FISSION_PERF_BASELINE)
+    if(NOT DEFINED ${fission_perf_var})
+        message(FATAL_ERROR "perf_compare.cmake: ${fission_perf_var} is required")
+    endif()
+endforeach()
+
+if(NOT DEFINED FISSION_PERF_MODE OR FISSION_PERF_MODE STREQUAL "")
+    set(FISSION_PERF_MODE COMPARE)
+endif()
+
+execute_process(
+    COMMAND "${FISSION_PERF_SUITE}" --output "${FISSION_PERF_RESULTS}"
+    RESULT_VARIABLE fission_perf_exit
+)
+if(NOT fission_perf_exit EQUAL 0)
+    message(FATAL_ERROR "fission_perf_suite failed (${fission_perf_exit})")
+endif()
+
+file(READ "${FISSION_PERF_RESULTS}" fission_perf_results)
+if(EXISTS "${FISSION_PERF_BASELINE}")
+    file(READ "${FISSION_PERF_BASELINE}" fission_perf_baseline)
+else()
+    set(fission_perf_baseline "{\"tolerance_percent\": 25, \"cases\": {}}")
+endif()
+
+string(JSON fission_perf_case_count LENGTH "${fission_perf_results}" cases)
+if(fission_perf_case_count EQUAL 0)
+    message(FATAL_ERROR "fission_perf_suite reported no cases")
+endif()
+math(EXPR fission_perf_last "${fission_perf_case_count} - 1")
+
+set(fission_perf_metrics ns_per_iter layout_resolves_per_kiter layout_cache_misses_per_kiter heap_allocations_per_kiter)
+
+if(FISSION_PERF_MODE STREQUAL "UPDATE")
+    foreach(fission_perf_index RANGE ${fission_perf_last})
+        string(JSON fission_perf_name MEMBER "${fission_perf_results}" cases ${fission_perf_index})
+        string(
+            JSON fission_perf_ns
+            ERROR_VARIABLE fission_perf_error
+            GET "${fission_perf_results}" cases ${fission_perf_name} ns_per_iter
+        )
+        if(fission_perf_error)
+            message(STATUS "${fission_perf_name}: skipped, baseline entry left unchanged")
+            continue()
+        endif()
+        string(
+            JSON fission_perf_type
+            ERROR_VARIABLE fission_perf_error
+            TYPE "${fission_perf_baseline}" cases ${fission_perf_name}
+        )
+        if(fission_perf_error OR NOT fission_perf_type STREQUAL "OBJECT")
+            string(JSON fission_perf_baseline SET "${fission_perf_baseline}" cases ${fission_perf_name} "{}")
+        endif()
+        foreach(fission_perf_metric IN LISTS fission_perf_metrics)
+            string(
+                JSON fission_perf_value
+                ERROR_VARIABLE fission_perf_error
+                GET "${fission_perf_results}" cases ${fission_perf_name} ${fission_perf_metric}
+            )
+            if(NOT fission_perf_error)
+                string(
+                    JSON fission_perf_baseline
+                    SET "${fission_perf_baseline}" cases ${fission_perf_name} ${fission_perf_metric} "${fission_perf_value}"
+                )
+            endif()
+        endforeach()
+        message(STATUS "${fission_perf_name}: baseline ${fission_perf_ns} ns")
+    endforeach()
+    file(WRITE "${FISSION_PERF_BASELINE}" "${fission_perf_baseline}\n")
+    return()
+endif()
+
+if(DEFINED FISSION_PERF_TOLERANCE_PERCENT AND NOT FISSION_PERF_TOLERANCE_PERCENT STREQUAL "")
+    set(fission_perf_tolerance "${FISSION_PERF_TOLERANCE_PERCENT}")
+else()
+    string(
+        JSON fission_perf_tolerance
+        ERROR_VARIABLE fission_perf_error
+        GET "${fission_perf_baseline}" tolerance_percent
+    )
+    if(fission_perf_error)
+        set(fission_perf_tolerance 25)
+    endif()
+endif()
+
+set(fission_perf_failures "")
+foreach(fission_perf_index RANGE ${fission_perf_last})
+    string(JSON fission_perf_name MEMBER "${fission_perf_results}" cases ${fission_perf_index})
+    string(
+        JSON fission_perf_ns
+        ERROR_VARIABLE fission_perf_error
+        GET "${fission_perf_results}" cases ${fission_perf_name} ns_per_iter
+    )
+    if(fission_perf_error)
+        message(STATUS "${fission_perf_name}: skipped")
+        continue()
+    endif()
+
+    set(fission_perf_checked 0)
+    foreach(fission_perf_metric IN LISTS fission_perf_metrics)
+        string(
+            JSON fission_perf_type
+            ERROR_VARIABLE fission_perf_error
+            TYPE "${fission_perf_baseline}" cases ${fission_perf_name} ${fission_perf_metric}
+        )
+        if(fission_perf_error OR NOT fission_perf_type STREQUAL "NUMBER")
+            continue()
+        endif()
+        string(JSON fission_perf_base GET "${fission_perf_baseline}" cases ${fission_perf_name} ${fission_perf_metric})
+        math(EXPR fission_perf_checked "${fission_perf_checked} + 1")
+
+        string(
+            JSON fission_perf_value
+            ERROR_VARIABLE fission_perf_error
+            GET "${fission_perf_results}" cases ${fission_perf_name} ${fission_perf_metric}
+        )
+        if(fission_perf_error)
+            list(APPEND fission_perf_failures "${fission_perf_name} did not report ${fission_perf_metric}")
+            continue()
+        endif()
+
+        if(fission_perf_metric STREQUAL "ns_per_iter")
+            math(EXPR fission_perf_limit "${fission_perf_base} * (100 + ${fission_perf_tolerance}) / 100")
+            if(fission_perf_base GREATER 0)
+                math(EXPR fission_perf_delta "(${fission_perf_value} - ${fission_perf_base}) * 100 / ${fission_perf_base}")
+            else()
+                set(fission_perf_delta 0)
+            endif()
+            message(
+                STATUS
+                "${fission_perf_name}: ${fission_perf_value} ns vs baseline ${fission_perf_base} ns (${fission_perf_delta}%)"
+            )
+            if(fission_perf_value GREATER fission_perf_limit)
+                list(
+                    APPEND fission_perf_failures
+                    "${fission_perf_name} ${fission_perf_value} ns > ${fission_perf_limit} ns (+${fission_perf_delta}%)"
+                )
+            endif()
+        else()
+            message(
+                STATUS
+                "${fission_perf_name}: ${fission_perf_metric} ${fission_perf_value} (budget ${fission_perf_base})"
+            )
+            if(fission_perf_value GREATER fission_perf_base)
+                list(
+                    APPEND fission_perf_failures
+                    "${fission_perf_name} ${fission_perf_metric} ${fission_perf_value} > ${fission_perf_base}"
+                )
+            endif()
+        endif()
+    endforeach()
+
+    if(fission_perf_checked EQUAL 0)
+        message(STATUS "${fission_perf_name}: ${fission_perf_ns} ns (no baseline)")
+        list(
+            APPEND fission_perf_failures
+            "${fission_perf_name} has no seeded baseline (seed it with the fission_perf_update_baseline target)"
+        )
+    endif()
+endforeach()
+
+if(fission_perf_failures)
+    list(JOIN fission_perf_failures "\n  " fission_perf_report)
+    message(
+        FATAL_ERROR
+        "Performance regression (ns tolerance ${fission_perf_tolerance}%, work budgets exact):\n  ${fission_perf_report}"
+    )
+endif()
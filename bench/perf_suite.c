@@ -0,0 +1,667 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_support.h"
+#include "fission/nuklear_dock_tree.h"
+
+#if defined(FISSION_PERF_HAVE_GL)
+#include <EGL/egl.h>
+#include <GL/gl.h>
+
+#include "fission/nuklear_render.h"
+#endif
+
+#define FISSION_PERF_REPETITIONS 9u
+#define FISSION_PERF_TAB_COUNT 4u
+#define FISSION_PERF_TEXTURE_SIZE 512
+
+typedef enum fission_perf_setup_result {
+    FISSION_PERF_SETUP_READY = 0,
+    FISSION_PERF_SETUP_SKIPPED = 1,
+    FISSION_PERF_SETUP_FAILED = 2
+} fission_perf_setup_result_t;
+
+typedef struct fission_perf_state {
+    fission_bench_scene_t *scene;
+    fission_nk_panel_workspace_tabs_t *tabs;
+    fission_nk_dock_tree_t *dock_tree;
+    size_t dock_leaves[FISSION_NK_PANEL_SLOT_COUNT];
+    fission_nk_panel_layout_input_t layout_input;
+    fission_nk_panel_bounds_t layout_panel_bounds[FISSION_NK_PANEL_SLOT_COUNT * 2u];
+    const char *skip_reason;
+#if defined(FISSION_PERF_HAVE_GL)
+    EGLDisplay display;
+    EGLSurface surface;
+    EGLContext context;
+    fission_nk_texture_t texture;
+    unsigned char *pixels;
+#endif
+} fission_perf_state_t;
+
+/*
+ * Work done by a scene case during its timed repetitions. Unlike ns these counts do not
+ * depend on the machine, so their baselines hold everywhere.
+ */
+typedef struct fission_perf_work {
+    unsigned long long layout_resolves;
+    unsigned long long layout_cache_misses;
+    unsigned long long heap_allocations;
+} fission_perf_work_t;
+
+typedef struct fission_perf_case {
+    const char *name;
+    unsigned long iterations;
+    fission_perf_setup_result_t (*setup)(fission_perf_state_t *state);
+    void (*run)(fission_perf_state_t *state, unsigned long iteration);
+    void (*teardown)(fission_perf_state_t *state);
+} fission_perf_case_t;
+
+static void fission_perf_idle_input(struct nk_context *ctx)
+{
+    nk_input_begin(ctx);
+    nk_input_motion(ctx, 0, 0);
+    nk_input_end(ctx);
+}
+
+static fission_perf_setup_result_t fission_perf_setup_scene(
+    fission_perf_state_t *state,
+    int rows_per_panel
+)
+{
+    state->scene = (fission_bench_scene_t *)calloc(1u, sizeof(*state->scene));
+    if (state->scene == NULL) {
+        return FISSION_PERF_SETUP_FAILED;
+    }
+    if (fission_bench_scene_init(state->scene, 28u, rows_per_panel, 1600, 900) == 0) {
+        free(state->scene);
+        state->scene = NULL;
+        return FISSION_PERF_SETUP_FAILED;
+    }
+    return FISSION_PERF_SETUP_READY;
+}
+
+static void fission_perf_teardown_scene(fission_perf_state_t *state)
+{
+    if (state->tabs != NULL) {
+        fission_nk_panel_workspace_tabs_shutdown(state->tabs);
+        free(state->tabs);
+        state->tabs = NULL;
+    }
+    if (state->scene != NULL) {
+        fission_bench_scene_shutdown(state->scene);
+        free(state->scene);
+        state->scene = NULL;
+    }
+}
+
+static void fission_perf_sample_work(const fission_perf_state_t *state, fission_perf_work_t *out_work)
+{
+    fission_nk_alloc_stats_t alloc_stats;
+    unsigned long long hits;
+    unsigned long long misses;
+
+    fission_nk_panel_workspace_get_layout_cache_stats(&state->scene->workspace, &hits, &misses);
+    fission_nk_counting_allocator_snapshot(&state->scene->allocator, &alloc_stats);
+    out_work->layout_resolves = hits + misses;
+    out_work->layout_cache_misses = misses;
+    out_work->heap_allocations = alloc_stats.allocation_count;
+}
+
+static void fission_perf_draw_frame(fission_bench_scene_t *scene)
+{
+    fission_nk_panel_workspace_draw_all(
+        &scene->workspace,
+        &scene->ctx,
+        scene->window_width,
+        scene->window_height
+    );
+    nk_clear(&scene->ctx);
+}
+
+static fission_perf_setup_result_t fission_perf_setup_layout(fission_perf_state_t *state)
+{
+    return fission_perf_setup_scene(state, 0);
+}
+
+/* Idle frames over empty panels: dominated by layout resolution and window begin/end. */
+static void fission_perf_run_layout(fission_perf_state_t *state, unsigned long iteration)
+{
+    (void)iteration;
+    fission_perf_idle_input(&state->scene->ctx);
+    fission_perf_draw_frame(state->scene);
+}
+
+static fission_perf_setup_result_t fission_perf_setup_hover_scroll(fission_perf_state_t *state)
+{
+    return fission_perf_setup_scene(state, 12);
+}
+
+static void fission_perf_run_hover_scroll(fission_perf_state_t *state, unsigned long iteration)
+{
+    /* The first 160 script frames are the hover and wheel sweep. */
+    fission_bench_scene_script_input(state->scene, iteration % 160u);
+    fission_perf_draw_frame(state->scene);
+}
+
+static fission_perf_setup_result_t fission_perf_setup_tab_switch(fission_perf_state_t *state)
+{
+    fission_perf_setup_result_t result;
+    size_t i;
+
+    result = fission_perf_setup_scene(state, 4);
+    if (result != FISSION_PERF_SETUP_READY) {
+        return result;
+    }
+
+    state->tabs = (fission_nk_panel_workspace_tabs_t *)calloc(1u, sizeof(*state->tabs));
+    if (state->tabs == NULL) {
+        return FISSION_PERF_SETUP_FAILED;
+    }
+    fission_nk_panel_workspace_tabs_init(state->tabs);
+    for (i = 1u; i < FISSION_PERF_TAB_COUNT; ++i) {
+        if (
+            fission_nk_panel_workspace_tabs_create(
+                state->tabs,
+                &state->scene->workspace,
+                NULL,
+                NULL
+            ) != FISSION_NK_PANEL_STATUS_OK
+        ) {
+            return FISSION_PERF_SETUP_FAILED;
+        }
+        fission_nk_panel_workspace_show_all(&state->scene->workspace);
+    }
+    return FISSION_PERF_SETUP_READY;
+}
+
+static void fission_perf_run_tab_switch(fission_perf_state_t *state, unsigned long iteration)
+{
+    fission_bench_scene_t *scene;
+
+    scene = state->scene;
+    (void)fission_nk_panel_workspace_tabs_set_active(
+        state->tabs,
+        &scene->workspace,
+        (size_t)(iteration % FISSION_PERF_TAB_COUNT)
+    );
+    fission_perf_idle_input(&scene->ctx);
+    fission_nk_panel_workspace_tabs_draw_all(
+        state->tabs,
+        &scene->workspace,
+        &scene->ctx,
+        scene->window_width,
+        scene->window_height
+    );
+    nk_clear(&scene->ctx);
+}
+
+/* Plugin-style hot reload: unregister one panel and register it again, then draw. */
+static void fission_perf_run_panel_reload(fission_perf_state_t *state, unsigned long iteration)
+{
+    fission_bench_scene_t *scene;
+    fission_bench_panel_t *panel;
+    fission_nk_panel_desc_t desc;
+    size_t index;
+
+    scene = state->scene;
+    index = (size_t)(iteration % (unsigned long)scene->panel_count);
+    panel = &scene->panels[index];
+    (void)fission_nk_panel_workspace_unregister_handle(&scene->workspace, panel->handle);
+    fission_bench_scene_panel_desc(scene, index, &desc);
+    (void)fission_nk_panel_workspace_register_handle(&scene->workspace, &desc, &panel->handle);
+    fission_perf_idle_input(&scene->ctx);
+    fission_perf_draw_frame(scene);
+}
+
+static fission_perf_setup_result_t fission_perf_setup_layout_solve(fission_perf_state_t *state)
+{
+    size_t slot;
+
+    memset(&state->layout_input, 0, sizeof(state->layout_input));
+    state->layout_input.window_height = 900;
+    state->layout_input.left_column_ratio = 0.24f;
+    state->layout_input.right_column_ratio = 0.23f;
+    state->layout_input.top_row_ratio = 0.22f;
+    state->layout_input.bottom_row_ratio = 0.20f;
+    for (slot = 0u; slot < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++slot) {
+        state->layout_input.slot_counts[slot] = 2u;
+        state->layout_input.slot_touch_serial[slot] = (unsigned long long)slot;
+    }
+    return FISSION_PERF_SETUP_READY;
+}
+
+/* The pure slot solver while one slot toggles and the window width sweeps, as in a resize. */
+static void fission_perf_run_layout_solve(fission_perf_state_t *state, unsigned long iteration)
+{
+    fission_nk_panel_layout_result_t result;
+    size_t slot;
+
+    slot = (size_t)(iteration % (unsigned long)FISSION_NK_PANEL_SLOT_COUNT);
+    state->layout_input.slot_counts[slot] = 2u;
+    if (((iteration / (unsigned long)FISSION_NK_PANEL_SLOT_COUNT) & 1u) != 0u) {
+        state->layout_input.slot_counts[slot] = 0u;
+    }
+    state->layout_input.window_width = 1224 + (int)(iteration % 400u);
+    (void)fission_nk_panel_layout_solve(&state->layout_input, &result, state->layout_panel_bounds);
+}
+
+static void fission_perf_teardown_layout_solve(fission_perf_state_t *state)
+{
+    (void)state;
+}
+
+static fission_perf_setup_result_t fission_perf_setup_dock_tree(fission_perf_state_t *state)
+{
+    fission_perf_setup_result_t result;
+
+    result = fission_perf_setup_scene(state, 0);
+    if (result != FISSION_PERF_SETUP_READY) {
+        return result;
+    }
+
+    state->dock_tree = (fission_nk_dock_tree_t *)calloc(1u, sizeof(*state->dock_tree));
+    if (state->dock_tree == NULL) {
+        return FISSION_PERF_SETUP_FAILED;
+    }
+    fission_nk_dock_tree_slot_preset(state->dock_tree, 0.24f, 0.23f, 0.22f, 0.20f, state->dock_leaves);
+    fission_nk_dock_tree_sync_slot_preset(state->dock_tree, state->dock_leaves, &state->scene->workspace);
+    fission_nk_panel_workspace_set_dock_tree(&state->scene->workspace, state->dock_tree);
+    return FISSION_PERF_SETUP_READY;
+}
+
+/* Workspace docked on the slot preset while the window width sweeps, so every frame resolves the tree. */
+static void fission_perf_run_dock_tree(fission_perf_state_t *state, unsigned long iteration)
+{
+    fission_bench_scene_t *scene;
+
+    scene = state->scene;
+    scene->window_width = 1400 + (int)(iteration % 200u);
+    fission_perf_idle_input(&scene->ctx);
+    fission_perf_draw_frame(scene);
+}
+
+static void fission_perf_teardown_dock_tree(fission_perf_state_t *state)
+{
+    fission_perf_teardown_scene(state);
+    free(state->dock_tree);
+    state->dock_tree = NULL;
+}
+
+static void fission_perf_run_menu_bar(fission_perf_state_t *state, unsigned long iteration)
+{
+    fission_bench_scene_t *scene;
+
+    (void)iteration;
+    scene = state->scene;
+    fission_perf_idle_input(&scene->ctx);
+    fission_nk_panel_workspace_draw_menu_bar(
+        &scene->ctx,
+        &scene->workspace,
+        scene->window_width,
+        NULL,
+        NULL,
+        NULL
+    );
+    nk_clear(&scene->ctx);
+}
+
+static void fission_perf_run_tabs_menu_bar(fission_perf_state_t *state, unsigned long iteration)
+{
+    fission_bench_scene_t *scene;
+
+    (void)iteration;
+    scene = state->scene;
+    fission_perf_idle_input(&scene->ctx);
+    fission_nk_panel_workspace_tabs_draw_menu_bar(
+        &scene->ctx,
+        state->tabs,
+        &scene->workspace,
+        scene->window_width,
+        NULL,
+        NULL,
+        NULL
+    );
+    nk_clear(&scene->ctx);
+}
+
+#if defined(FISSION_PERF_HAVE_GL)
+static fission_perf_setup_result_t fission_perf_setup_texture(fission_perf_state_t *state)
+{
+    static const EGLint config_attribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+    static const EGLint surface_attribs[] = {
+        EGL_WIDTH, 16,
+        EGL_HEIGHT, 16,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint config_count;
+    size_t pixel_bytes;
+    size_t i;
+
+    state->skip_reason = "no headless OpenGL context available";
+    state->display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (state->display == EGL_NO_DISPLAY || eglInitialize(state->display, NULL, NULL) != EGL_TRUE) {
+        state->display = EGL_NO_DISPLAY;
+        return FISSION_PERF_SETUP_SKIPPED;
+    }
+    if (
+        eglBindAPI(EGL_OPENGL_API) != EGL_TRUE ||
+        eglChooseConfig(state->display, config_attribs, &config, 1, &config_count) != EGL_TRUE ||
+        config_count < 1
+    ) {
+        return FISSION_PERF_SETUP_SKIPPED;
+    }
+    state->surface = eglCreatePbufferSurface(state->display, config, surface_attribs);
+    state->context = eglCreateContext(state->display, config, EGL_NO_CONTEXT, NULL);
+    if (
+        state->surface == EGL_NO_SURFACE ||
+        state->context == EGL_NO_CONTEXT ||
+        eglMakeCurrent(state->display, state->surface, state->surface, state->context) != EGL_TRUE ||
+        glGetString(GL_VERSION) == NULL
+    ) {
+        return FISSION_PERF_SETUP_SKIPPED;
+    }
+
+    pixel_bytes = (size_t)FISSION_PERF_TEXTURE_SIZE * (size_t)FISSION_PERF_TEXTURE_SIZE * 4u;
+    state->pixels = (unsigned char *)malloc(pixel_bytes);
+    if (state->pixels == NULL) {
+        return FISSION_PERF_SETUP_FAILED;
+    }
+    for (i = 0u; i < pixel_bytes; ++i) {
+        state->pixels[i] = (unsigned char)(i * 31u);
+    }
+    fission_nk_texture_init(&state->texture);
+    state->skip_reason = NULL;
+    return FISSION_PERF_SETUP_READY;
+}
+
+static void fission_perf_run_texture(fission_perf_state_t *state, unsigned long iteration)
+{
+    (void)iteration;
+    (void)fission_nk_texture_upload_rgba8(
+        &state->texture,
+        FISSION_PERF_TEXTURE_SIZE,
+        FISSION_PERF_TEXTURE_SIZE,
+        state->pixels,
+        FISSION_NK_TEXTURE_SAMPLING_PIXEL_ART
+    );
+    glFinish();
+}
+
+static void fission_perf_teardown_texture(fission_perf_state_t *state)
+{
+    if (state->pixels != NULL) {
+        fission_nk_texture_destroy(&state->texture);
+        free(state->pixels);
+        state->pixels = NULL;
+    }
+    if (state->display != EGL_NO_DISPLAY) {
+        (void)eglMakeCurrent(state->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (state->context != EGL_NO_CONTEXT) {
+            (void)eglDestroyContext(state->display, state->context);
+        }
+        if (state->surface != EGL_NO_SURFACE) {
+            (void)eglDestroySurface(state->display, state->surface);
+        }
+        (void)eglTerminate(state->display);
+    }
+}
+#else
+static fission_perf_setup_result_t fission_perf_setup_texture(fission_perf_state_t *state)
+{
+    state->skip_reason = "built without OpenGL/EGL";
+    return FISSION_PERF_SETUP_SKIPPED;
+}
+
+static void fission_perf_run_texture(fission_perf_state_t *state, unsigned long iteration)
+{
+    (void)state;
+    (void)iteration;
+}
+
+static void fission_perf_teardown_texture(fission_perf_state_t *state)
+{
+    (void)state;
+}
+#endif
+
+static const fission_perf_case_t fission_perf_cases[] = {
+    {
+        "layout_resolve",
+        400u,
+        fission_perf_setup_layout,
+        fission_perf_run_layout,
+        fission_perf_teardown_scene
+    },
+    {
+        "hover_scroll",
+        320u,
+        fission_perf_setup_hover_scroll,
+        fission_perf_run_hover_scroll,
+        fission_perf_teardown_scene
+    },
+    {
+        "tab_switch",
+        200u,
+        fission_perf_setup_tab_switch,
+        fission_perf_run_tab_switch,
+        fission_perf_teardown_scene
+    },
+    {
+        "panel_reload",
+        400u,
+        fission_perf_setup_layout,
+        fission_perf_run_panel_reload,
+        fission_perf_teardown_scene
+    },
+    {
+        "layout_solve",
+        20000u,
+        fission_perf_setup_layout_solve,
+        fission_perf_run_layout_solve,
+        fission_perf_teardown_layout_solve
+    },
+    {
+        "dock_tree_resolve",
+        400u,
+        fission_perf_setup_dock_tree,
+        fission_perf_run_dock_tree,
+        fission_perf_teardown_dock_tree
+    },
+    {
+        "menu_bar",
+        2000u,
+        fission_perf_setup_layout,
+        fission_perf_run_menu_bar,
+        fission_perf_teardown_scene
+    },
+    {
+        "tabs_menu_bar",
+        2000u,
+        fission_perf_setup_tab_switch,
+        fission_perf_run_tabs_menu_bar,
+        fission_perf_teardown_scene
+    },
+    {
+        "texture_upload_512",
+        60u,
+        fission_perf_setup_texture,
+        fission_perf_run_texture,
+        fission_perf_teardown_texture
+    }
+};
+
+static int fission_perf_run_case(
+    const fission_perf_case_t *perf_case,
+    double scale,
+    FILE *out,
+    int first
+)
+{
+    fission_perf_state_t state;
+    fission_perf_setup_result_t setup;
+    unsigned long long samples[FISSION_PERF_REPETITIONS];
+    fission_bench_summary_t summary;
+    fission_perf_work_t work_start;
+    fission_perf_work_t work_end;
+    unsigned long long measured;
+    const char *skip_reason;
+    int has_work;
+    unsigned long iterations;
+    unsigned long iteration;
+    unsigned long warmup;
+    unsigned int rep;
+
+    memset(&state, 0, sizeof(state));
+#if defined(FISSION_PERF_HAVE_GL)
+    state.display = EGL_NO_DISPLAY;
+    state.surface = EGL_NO_SURFACE;
+    state.context = EGL_NO_CONTEXT;
+#endif
+    iterations = (unsigned long)((double)perf_case->iterations * scale);
+    if (iterations == 0u) {
+        iterations = 1u;
+    }
+
+    fprintf(out, "%s\n    \"%s\": ", (first != 0) ? "" : ",", perf_case->name);
+    setup = perf_case->setup(&state);
+    if (setup != FISSION_PERF_SETUP_READY) {
+        perf_case->teardown(&state);
+        if (setup == FISSION_PERF_SETUP_SKIPPED) {
+            skip_reason = (state.skip_reason != NULL) ? state.skip_reason : "unavailable";
+            fprintf(out, "{\"skipped\": true, \"reason\": \"%s\"}", skip_reason);
+            printf("%-20s skipped (%s)\n", perf_case->name, skip_reason);
+            return 1;
+        }
+        fprintf(stderr, "fission_perf_suite: setup failed for %s\n", perf_case->name);
+        return 0;
+    }
+
+    iteration = 0u;
+    for (warmup = 0u; warmup < iterations / 4u + 1u && warmup < 64u; ++warmup) {
+        perf_case->run(&state, iteration++);
+    }
+    memset(&work_start, 0, sizeof(work_start));
+    has_work = (state.scene != NULL);
+    if (has_work != 0) {
+        fission_perf_sample_work(&state, &work_start);
+    }
+    for (rep = 0u; rep < FISSION_PERF_REPETITIONS; ++rep) {
+        unsigned long long start_ns;
+        unsigned long i;
+
+        start_ns = fission_bench_now_ns();
+        for (i = 0u; i < iterations; ++i) {
+            perf_case->run(&state, iteration++);
+        }
+        samples[rep] = (fission_bench_now_ns() - start_ns) / iterations;
+    }
+    memset(&work_end, 0, sizeof(work_end));
+    if (has_work != 0) {
+        fission_perf_sample_work(&state, &work_end);
+    }
+    perf_case->teardown(&state);
+
+    fission_bench_summarize(samples, FISSION_PERF_REPETITIONS, &summary);
+    fprintf(
+        out,
+        "{\"ns_per_iter\": %llu, \"min_ns_per_iter\": %llu, \"max_ns_per_iter\": %llu,"
+        " \"iterations\": %lu, \"repetitions\": %u",
+        summary.p50,
+        summary.min,
+        summary.max,
+        iterations,
+        FISSION_PERF_REPETITIONS
+    );
+    /* Scene cases also report their work per 1000 iterations, the machine-independent gate. */
+    if (has_work != 0) {
+        measured = (unsigned long long)iterations * FISSION_PERF_REPETITIONS;
+        fprintf(
+            out,
+            ",\n      \"layout_resolves_per_kiter\": %llu, \"layout_cache_misses_per_kiter\": %llu,"
+            " \"heap_allocations_per_kiter\": %llu",
+            (work_end.layout_resolves - work_start.layout_resolves) * 1000u / measured,
+            (work_end.layout_cache_misses - work_start.layout_cache_misses) * 1000u / measured,
+            (work_end.heap_allocations - work_start.heap_allocations) * 1000u / measured
+        );
+    }
+    fputc('}', out);
+    printf(
+        "%-20s median=%llu ns min=%llu max=%llu (%lu x %u)\n",
+        perf_case->name,
+        summary.p50,
+        summary.min,
+        summary.max,
+        iterations,
+        FISSION_PERF_REPETITIONS
+    );
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    const char *output_path;
+    const char *only;
+    double scale;
+    FILE *out;
+    size_t i;
+    int first;
+    int ok;
+
+    output_path = "fission_perf_results.json";
+    only = NULL;
+    scale = 1.0;
+    for (i = 1u; i < (size_t)argc; ++i) {
+        if (strcmp(argv[i], "--output") == 0 && i + 1u < (size_t)argc) {
+            output_path = argv[++i];
+        } else if (strcmp(argv[i], "--case") == 0 && i + 1u < (size_t)argc) {
+            only = argv[++i];
+        } else if (strcmp(argv[i], "--scale") == 0 && i + 1u < (size_t)argc) {
+            scale = atof(argv[++i]);
+            if (scale <= 0.0) {
+                scale = 1.0;
+            }
+        } else {
+            fprintf(stderr, "usage: %s [--output FILE] [--case NAME] [--scale X]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    out = fopen(output_path, "wb");
+    if (out == NULL) {
+        fprintf(stderr, "fission_perf_suite: cannot write '%s'\n", output_path);
+        return 1;
+    }
+
+    fputs("{\n  \"suite\": \"fission_perf\",\n  \"version\": 1,\n  \"cases\": {", out);
+    first = 1;
+    ok = 1;
+    for (i = 0u; i < sizeof(fission_perf_cases) / sizeof(fission_perf_cases[0]); ++i) {
+        if (only != NULL && strcmp(only, fission_perf_cases[i].name) != 0) {
+            continue;
+        }
+        if (fission_perf_run_case(&fission_perf_cases[i], scale, out, first) == 0) {
+            ok = 0;
+            break;
+        }
+        first = 0;
+    }
+    fputs("\n  }\n}\n", out);
+
+    if (ferror(out) != 0) {
+        ok = 0;
+    }
+    if (fclose(out) != 0) {
+        ok = 0;
+    }
+    return (ok != 0) ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_support.h"
+
+#define FISSION_RECT_BENCH_POINTS 256u
+
+static int fission_rect_bench_contains(const struct nk_rect *rect, float x, float y)
+{
+    if (rect->w <= 0.0f || rect->h <= 0.0f) {
+        return 0;
+    }
+    return (
+        x >= rect->x &&
+        y >= rect->y &&
+        x <= (rect->x + rect->w) &&
+        y <= (rect->y + rect->h)
+    );
+}
+
+static float fission_rect_bench_random(unsigned int *state, float range)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return (float)(*state >> 8) / 16777216.0f * range;
+}
+
+int main(int argc, char **argv)
+{
+    struct nk_rect *rects;
+    struct nk_rect *clipped;
+    unsigned char *hits;
+    float points[FISSION_RECT_BENCH_POINTS][2];
+    struct nk_rect clip;
+    unsigned long long start_ns;
+    unsigned long long scalar_hit_ns;
+    unsigned long long batch_hit_ns;
+    unsigned long long scalar_clip_ns;
+    unsigned long long batch_clip_ns;
+    unsigned long long scalar_sum;
+    unsigned long long batch_sum;
+    unsigned int seed;
+    int status;
+    size_t count;
+    size_t i;
+    size_t p;
+
+    count = 4096u;
+    if (argc > 1) {
+        count = (size_t)strtoul(argv[1], NULL, 10);
+        if (count == 0u) {
+            fprintf(stderr, "usage: %s [rect_count]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    status = 1;
+    rects = (struct nk_rect *)malloc(count * sizeof(*rects));
+    clipped = (struct nk_rect *)malloc(count * sizeof(*clipped));
+    hits = (unsigned char *)malloc(count);
+    if (rects == NULL || clipped == NULL || hits == NULL) {
+        fprintf(stderr, "fission_rect_bench: out of memory\n");
+        goto cleanup;
+    }
+
+    seed = 12345u;
+    for (i = 0u; i < count; ++i) {
+        rects[i] = nk_rect(
+            fission_rect_bench_random(&seed, 3800.0f),
+            fission_rect_bench_random(&seed, 2100.0f),
+            8.0f + fission_rect_bench_random(&seed, 180.0f),
+            8.0f + fission_rect_bench_random(&seed, 120.0f)
+        );
+    }
+    for (p = 0u; p < FISSION_RECT_BENCH_POINTS; ++p) {
+        points[p][0] = fission_rect_bench_random(&seed, 4000.0f);
+        points[p][1] = fission_rect_bench_random(&seed, 2200.0f);
+    }
+    clip = nk_rect(600.0f, 300.0f, 1600.0f, 900.0f);
+
+    /* Hit testing: count every rect under each point, the node-graph hover pattern. */
+    scalar_sum = 0u;
+    start_ns = fission_bench_now_ns();
+    for (p = 0u; p < FISSION_RECT_BENCH_POINTS; ++p) {
+        for (i = 0u; i < count; ++i) {
+            scalar_sum += (unsigned long long)fission_rect_bench_contains(&rects[i], points[p][0], points[p][1]);
+        }
+    }
+    scalar_hit_ns = fission_bench_now_ns() - start_ns;
+
+    batch_sum = 0u;
+    start_ns = fission_bench_now_ns();
+    for (p = 0u; p < FISSION_RECT_BENCH_POINTS; ++p) {
+        batch_sum += (unsigned long long)fission_nk_rects_contain_point(
+            rects,
+            count,
+            points[p][0],
+            points[p][1],
+            hits
+        );
+    }
+    batch_hit_ns = fission_bench_now_ns() - start_ns;
+    if (scalar_sum != batch_sum) {
+        fprintf(stderr, "fission_rect_bench: hit mismatch (%llu vs %llu)\n", scalar_sum, batch_sum);
+        goto cleanup;
+    }
+
+    scalar_sum = 0u;
+    start_ns = fission_bench_now_ns();
+    for (p = 0u; p < FISSION_RECT_BENCH_POINTS; ++p) {
+        for (i = 0u; i < count; ++i) {
+            fission_nk_rect_intersection(&rects[i], &clip, &clipped[i]);
+            scalar_sum += (clipped[i].w > 0.0f) ? 1u : 0u;
+        }
+        clip.x += 1.0f;
+    }
+    scalar_clip_ns = fission_bench_now_ns() - start_ns;
+
+    clip.x -= (float)FISSION_RECT_BENCH_POINTS;
+    batch_sum = 0u;
+    start_ns = fission_bench_now_ns();
+    for (p = 0u; p < FISSION_RECT_BENCH_POINTS; ++p) {
+        batch_sum += (unsigned long long)fission_nk_rects_intersect(rects, count, &clip, clipped);
+        clip.x += 1.0f;
+    }
+    batch_clip_ns = fission_bench_now_ns() - start_ns;
+    if (scalar_sum != batch_sum) {
+        fprintf(stderr, "fission_rect_bench: clip mismatch (%llu vs %llu)\n", scalar_sum, batch_sum);
+        goto cleanup;
+    }
+
+    printf(
+        "fission_rect_bench: rects=%u passes=%u backend=%s\n",
+        (unsigned int)count,
+        FISSION_RECT_BENCH_POINTS,
+        fission_nk_rect_batch_backend()
+    );
+    printf(
+        "%-14s scalar=%.2f ns/rect batched=%.2f ns/rect speedup=%.2fx\n",
+        "point in rect",
+        (double)scalar_hit_ns / (double)(count * FISSION_RECT_BENCH_POINTS),
+        (double)batch_hit_ns / (double)(count * FISSION_RECT_BENCH_POINTS),
+        (batch_hit_ns > 0u) ? (double)scalar_hit_ns / (double)batch_hit_ns : 0.0
+    );
+    printf(
+        "%-14s scalar=%.2f ns/rect batched=%.2f ns/rect speedup=%.2fx\n",
+        "clip rects",
+        (double)scalar_clip_ns / (double)(count * FISSION_RECT_BENCH_POINTS),
+        (double)batch_clip_ns / (double)(count * FISSION_RECT_BENCH_POINTS),
+        (batch_clip_ns > 0u) ? (double)scalar_clip_ns / (double)batch_clip_ns : 0.0
+    );
+    status = 0;
+
+cleanup:
+    free(hits);
+    free(clipped);
+    free(rects);
+    return status;
+}
@@ -0,0 +1,56 @@
+#ifndef FISSION_NUKLEAR_ALLOC_H
+#define FISSION_NUKLEAR_ALLOC_H
+
+#include <stddef.h>
+
+struct nk_allocator;
+
+typedef struct fission_nk_alloc_stats {
+    size_t live_bytes;
+    size_t peak_bytes;
+    size_t live_allocations;
+    unsigned long long allocation_count;
+    unsigned long long free_count;
+    unsigned long long failed_count;
+    unsigned long long frame_allocated_bytes;
+    unsigned long long frame_freed_bytes;
+    unsigned long long frame_allocation_count;
+    unsigned long long frame_free_count;
+    unsigned long long frames;
+} fission_nk_alloc_stats_t;
+
+/*
+ * Counting nk_allocator backed by malloc/free. Each block carries a small size
+ * header so frees can be attributed. Not thread-safe; use one per nk_context.
+ *
+ * The frame_* fields of a snapshot describe the last frame closed with
+ * fission_nk_counting_allocator_end_frame, not the frame in progress.
+ */
+typedef struct fission_nk_counting_allocator {
+    fission_nk_alloc_stats_t stats;
+    unsigned long long pending_allocated_bytes;
+    unsigned long long pending_freed_bytes;
+    unsigned long long pending_allocation_count;
+    unsigned long long pending_free_count;
+} fission_nk_counting_allocator_t;
+
+void fission_nk_counting_allocator_init(fission_nk_counting_allocator_t *allocator);
+
+/* Fills out_allocator so it can be passed to nk_init / nk_buffer_init. */
+void fission_nk_counting_allocator_bind(
+    fission_nk_counting_allocator_t *allocator,
+    struct nk_allocator *out_allocator
+);
+
+/* Publishes churn accumulated since the previous call into the frame_* stats. */
+void fission_nk_counting_allocator_end_frame(fission_nk_counting_allocator_t *allocator);
+
+void fission_nk_counting_allocator_snapshot(
+    const fission_nk_counting_allocator_t *allocator,
+    fission_nk_alloc_stats_t *out_stats
+);
+
+/* Restarts peak tracking from the current live byte count. */
+void fission_nk_counting_allocator_reset_peak(fission_nk_counting_allocator_t *allocator);
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef FISSION_NUKLEAR_DOCK_TREE_H
+#define FISSION_NUKLEAR_DOCK_TREE_H
+
+#include <stddef.h>
+
+#include "fission/nuklear_panels.h"
+
+#define FISSION_NK_DOCK_TREE_MAX_NODES 128
+#define FISSION_NK_DOCK_TREE_GAP 10.0f
+#define FISSION_NK_DOCK_NODE_NONE 0xffffu
+
+typedef enum fission_nk_dock_axis {
+    /* Children side by side; the splitter between them is a vertical bar. */
+    FISSION_NK_DOCK_AXIS_ROW = 0,
+    /* Children stacked top to bottom; the splitter is a horizontal bar. */
+    FISSION_NK_DOCK_AXIS_COLUMN = 1
+} fission_nk_dock_axis_t;
+
+typedef enum fission_nk_dock_node_kind {
+    FISSION_NK_DOCK_NODE_FREE = 0,
+    FISSION_NK_DOCK_NODE_LEAF = 1,
+    FISSION_NK_DOCK_NODE_SPLIT = 2
+} fission_nk_dock_node_kind_t;
+
+/*
+ * A split gives first `ratio` of its extent along axis (minus the gap) and second the rest.
+ * occupied counts the occupied leaves below a node; a split with one empty side hands all
+ * of its space to the other side, so empty regions collapse without editing the tree.
+ * bounds and splitter are written by resolve.
+ */
+typedef struct fission_nk_dock_node {
+    unsigned char kind;
+    unsigned char axis;
+    unsigned short parent;
+    unsigned short first;
+    unsigned short second;
+    unsigned short occupied;
+    float ratio;
+    int tag;
+    fission_nk_panel_bounds_t bounds;
+    fission_nk_panel_bounds_t splitter;
+} fission_nk_dock_node_t;
+
+/*
+ * Binary split tree over a fixed node pool. Leaf indices are stable for the life of the
+ * leaf: splitting a leaf inserts a new split node above it and removing one collapses its
+ * parent, so callers can keep leaf indices as handles. Freed nodes are reused.
+ */
+typedef struct fission_nk_dock_tree {
+    fission_nk_dock_node_t nodes[FISSION_NK_DOCK_TREE_MAX_NODES];
+    size_t node_count;
+    unsigned short root;
+    unsigned short free_head;
+    float gap;
+    float min_ratio;
+} fission_nk_dock_tree_t;
+
+/* Starts with a single occupied leaf carrying root_tag at tree->root. New leaves start occupied. */
+void fission_nk_dock_tree_init(fission_nk_dock_tree_t *tree, int root_tag);
+
+/*
+ * Splits leaf into a split node holding the existing leaf and a new leaf with tag. The new
+ * leaf goes first (left/top) when new_first is non-zero. ratio is the first child's share.
+ * Returns the new leaf index, or FISSION_NK_DOCK_NODE_NONE when leaf is invalid or the
+ * node pool is full.
+ */
+size_t fission_nk_dock_tree_split(
+    fission_nk_dock_tree_t *tree,
+    size_t leaf,
+    fission_nk_dock_axis_t axis,
+    float ratio,
+    int tag,
+    int new_first
+);
+
+/* Removes a leaf; its sibling takes the parent's place. The last leaf cannot be removed. */
+fission_nk_panel_status_t fission_nk_dock_tree_remove(fission_nk_dock_tree_t *tree, size_t leaf);
+
+fission_nk_panel_status_t fission_nk_dock_tree_set_occupied(
+    fission_nk_dock_tree_t *tree,
+    size_t leaf,
+    int occupied
+);
+fission_nk_panel_status_t fission_nk_dock_tree_set_ratio(
+    fission_nk_dock_tree_t *tree,
+    size_t split,
+    float ratio
+);
+
+/*
+ * Lays the tree out inside bounds in one pre-order pass. Unoccupied subtrees get zero
+ * bounds, and only splits with both sides occupied get a splitter rect.
+ */
+void fission_nk_dock_tree_resolve(
+    fission_nk_dock_tree_t *tree,
+    const fission_nk_panel_bounds_t *bounds
+);
+
+/* Returns the split whose resolved splitter contains the point, or FISSION_NK_DOCK_NODE_NONE. */
+size_t fission_nk_dock_tree_hit_splitter(const fission_nk_dock_tree_t *tree, float x, float y);
+
+/*
+ * Moves a split's splitter by delta pixels along its axis using the last resolved bounds.
+ * Returns 1 when the ratio changed; the caller re-resolves.
+ */
+int fission_nk_dock_tree_drag_splitter(fission_nk_dock_tree_t *tree, size_t split, float delta);
+
+/*
+ * Builds the nine-slot arrangement as three bands (top, middle, bottom), each split into
+ * left, center and right columns, with the workspace's ratio meanings. Leaf tags are
+ * fission_nk_panel_slot_t values and out_leaves[slot] receives each leaf, so the tree can
+ * be handed to fission_nk_panel_workspace_set_dock_tree. Corners belong to their band and
+ * an empty cell hands its space to its band neighbours, unlike the grid's corner ownership.
+ */
+void fission_nk_dock_tree_slot_preset(
+    fission_nk_dock_tree_t *tree,
+    float left_column_ratio,
+    float right_column_ratio,
+    float top_row_ratio,
+    float bottom_row_ratio,
+    size_t out_leaves[FISSION_NK_PANEL_SLOT_COUNT]
+);
+
+/*
+ * Copies a workspace's column/row ratios and docked slot occupancy onto a slot preset, e.g.
+ * before switching the workspace from the grid to the tree.
+ */
+void fission_nk_dock_tree_sync_slot_preset(
+    fission_nk_dock_tree_t *tree,
+    const size_t leaves[FISSION_NK_PANEL_SLOT_COUNT],
+    const fission_nk_panel_workspace_t *workspace
+);
+
+#endif
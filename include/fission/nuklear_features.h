@@ -4,11 +4,17 @@
 /*
  * Shared Nuklear feature surface for all engine/tool apps.
  * Prefer including "fission/nuklear.h" instead of using this header directly.
+ *
+ * Define FISSION_NK_NO_DEFAULT_ALLOCATOR for every translation unit (including
+ * the one with NK_IMPLEMENTATION) to drop nk_init_default and friends and force
+ * an explicit nk_allocator such as fission_nk_counting_allocator_t.
  */
 #define NK_INCLUDE_FIXED_TYPES
 #define NK_INCLUDE_STANDARD_IO
 #define NK_INCLUDE_STANDARD_VARARGS
+#ifndef FISSION_NK_NO_DEFAULT_ALLOCATOR
 #define NK_INCLUDE_DEFAULT_ALLOCATOR
+#endif
 #define NK_INCLUDE_VERTEX_BUFFER_OUTPUT
 #define NK_INCLUDE_FONT_BAKING
 #define NK_INCLUDE_DEFAULT_FONT
@@ -0,0 +1,76 @@
+#ifndef FISSION_NUKLEAR_INPUT_RECORD_H
+#define FISSION_NUKLEAR_INPUT_RECORD_H
+
+struct nk_context;
+
+#define FISSION_NK_INPUT_RECORD_VERSION 1u
+
+/*
+ * Session file layout (little-endian):
+ *   header: "FNKI", u16 version, u16 reserved, u16 width, u16 height
+ *   frame:  u8 flags, then only the sections named by flags, in this order:
+ *     SIZE    u16 width, u16 height
+ *     MOTION  i16 x, i16 y
+ *     BUTTONS u8 mask, then per set bit: u8 transitions, u8 down, i16 x, i16 y
+ *     SCROLL  f32 x, f32 y
+ *     KEYS    u8 count, then per key: u8 key, u8 transitions, u8 down
+ *     TEXT    u8 length, bytes
+ */
+typedef struct fission_nk_input_recorder {
+    void *file;
+    int width;
+    int height;
+    int mouse_x;
+    int mouse_y;
+    unsigned long frames;
+    int failed;
+} fission_nk_input_recorder_t;
+
+typedef struct fission_nk_input_player {
+    void *file;
+    long first_frame_offset;
+    int initial_width;
+    int initial_height;
+    int width;
+    int height;
+    unsigned long frames;
+    int failed;
+} fission_nk_input_player_t;
+
+int fission_nk_input_recorder_open(
+    fission_nk_input_recorder_t *recorder,
+    const char *path,
+    int width,
+    int height
+);
+
+/*
+ * Appends the input state of the current frame. Call after nk_input_end and
+ * before the workspace draw consumes (and temporarily rewrites) ctx->input.
+ */
+int fission_nk_input_recorder_capture(
+    fission_nk_input_recorder_t *recorder,
+    const struct nk_context *ctx,
+    int width,
+    int height
+);
+int fission_nk_input_recorder_close(fission_nk_input_recorder_t *recorder);
+
+int fission_nk_input_player_open(fission_nk_input_player_t *player, const char *path);
+
+/*
+ * Replays one recorded frame between nk_input_begin/nk_input_end and reports the
+ * window size to pass to fission_nk_panel_workspace_draw_all or
+ * fission_nk_panel_workspace_tabs_draw_all. Returns 0 at end of session or on a
+ * malformed file (player->failed is set in that case).
+ */
+int fission_nk_input_player_next(
+    fission_nk_input_player_t *player,
+    struct nk_context *ctx,
+    int *out_width,
+    int *out_height
+);
+int fission_nk_input_player_rewind(fission_nk_input_player_t *player);
+void fission_nk_input_player_close(fission_nk_input_player_t *player);
+
+#endif
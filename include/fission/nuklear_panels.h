@@ -3,10 +3,16 @@
 
 #include <stddef.h>
 
+#include "fission/nuklear_ui.h"
+
 struct nk_context;
+struct nk_window;
+struct nk_allocator;
+struct fission_nk_trace;
 
 #define FISSION_NK_MAX_PANELS 32
 #define FISSION_NK_PANEL_TITLE_BAR_HEIGHT 28.0f
+#define FISSION_NK_PANEL_TAB_STRIP_HEIGHT 24.0f
 #define FISSION_NK_PANEL_HEADER_BUTTON_WIDTH 56.0f
 #define FISSION_NK_PANEL_HEADER_BUTTON_HEIGHT 18.0f
 #define FISSION_NK_PANEL_HEADER_BUTTON_MARGIN 6.0f
@@ -15,8 +21,24 @@ struct nk_context;
 #define FISSION_NK_MAX_WORKSPACE_TABS 12
 #define FISSION_NK_WORKSPACE_TAB_NAME_MAX 48
 #define FISSION_NK_PANEL_UI_SCROLL_BLOCK_MAX 16
+#define FISSION_NK_PANEL_STATS_WINDOW_FRAMES 120u
+#define FISSION_NK_PANEL_STAT_METRIC_COUNT 4
+#define FISSION_NK_PANEL_COUNTER_COUNT 6
+#define FISSION_NK_PANEL_ID_TABLE_SIZE 64
+#define FISSION_NK_PANEL_DYNAMIC_MAX_PANELS 65534u
+#define FISSION_NK_PANEL_INIT_JOB_MAX 8
+#define FISSION_NK_PANEL_ID_HASH_MAX 32u
 
 typedef struct fission_nk_panel_workspace fission_nk_panel_workspace_t;
+/* Defined in fission/nuklear_dock_tree.h. */
+struct fission_nk_dock_tree;
+
+/*
+ * Stable panel reference: low 16 bits are the entry index + 1, high 16 bits the entry's
+ * registration generation. FISSION_NK_PANEL_HANDLE_NONE is never a valid handle.
+ */
+typedef unsigned int fission_nk_panel_handle_t;
+#define FISSION_NK_PANEL_HANDLE_NONE 0u
 typedef struct fission_nk_panel_workspace_tabs fission_nk_panel_workspace_tabs_t;
 
 typedef enum fission_nk_panel_status {
@@ -44,6 +66,32 @@ typedef struct fission_nk_panel_bounds {
     float h;
 } fission_nk_panel_bounds_t;
 
+/*
+ * Everything the docked slot layout depends on. slot_counts is the number of docked panels
+ * stacked in each slot (a tabbed slot counts one) and slot_touch_serial orders the slots by
+ * last touch, larger meaning more recent; it decides which neighbour takes an empty corner.
+ */
+typedef struct fission_nk_panel_layout_input {
+    int window_width;
+    int window_height;
+    float left_column_ratio;
+    float right_column_ratio;
+    float top_row_ratio;
+    float bottom_row_ratio;
+    size_t slot_counts[FISSION_NK_PANEL_SLOT_COUNT];
+    unsigned long long slot_touch_serial[FISSION_NK_PANEL_SLOT_COUNT];
+} fission_nk_panel_layout_input_t;
+
+/* Empty slots and splitters that separate nothing are left zeroed. */
+typedef struct fission_nk_panel_layout_result {
+    fission_nk_panel_bounds_t dock_workspace_bounds;
+    fission_nk_panel_bounds_t splitter_left_bounds;
+    fission_nk_panel_bounds_t splitter_right_bounds;
+    fission_nk_panel_bounds_t splitter_top_bounds;
+    fission_nk_panel_bounds_t splitter_bottom_bounds;
+    fission_nk_panel_bounds_t slot_bounds[FISSION_NK_PANEL_SLOT_COUNT];
+} fission_nk_panel_layout_result_t;
+
 typedef void (*fission_nk_panel_workspace_reset_layout_fn)(
     fission_nk_panel_workspace_t *workspace,
     void *user_data
@@ -61,6 +109,18 @@ typedef void (*fission_nk_panel_draw_fn)(
     void *user_data
 );
 
+typedef void (*fission_nk_panel_job_fn)(void *job);
+
+/*
+ * Hands `run(job)` to a worker, which must call it exactly once. Returns nonzero when
+ * the job was accepted; on zero the workspace runs init inline instead.
+ */
+typedef int (*fission_nk_panel_schedule_fn)(
+    fission_nk_panel_job_fn run,
+    void *job,
+    void *user_data
+);
+
 typedef struct fission_nk_panel_desc {
     const char *id;
     const char *title;
@@ -74,29 +134,308 @@ typedef struct fission_nk_panel_desc {
     fission_nk_panel_bounds_t default_detached_bounds;
 } fission_nk_panel_desc_t;
 
+/*
+ * FNV-1a hash of a panel id string literal, matching the workspace's runtime id hash.
+ * GCC and Clang fold it to a constant for ids up to FISSION_NK_PANEL_ID_HASH_MAX bytes;
+ * longer ids, and other compilers, yield 0, which adopt_table treats as "not hashed".
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define FISSION_NK_PANEL_ID_CHAR_(s, i) \
+    ((i) < sizeof("" s) - 1u ? (unsigned int)(unsigned char)("" s)[(i) < sizeof("" s) ? (i) : 0u] : 0u)
+#define FISSION_NK_PANEL_ID_STEP_(h, s, i) \
+    (((h) ^ FISSION_NK_PANEL_ID_CHAR_(s, i)) * ((i) < sizeof("" s) - 1u ? 16777619u : 1u))
+#define FISSION_NK_PANEL_ID_STEP4_(h, s, i) \
+    FISSION_NK_PANEL_ID_STEP_(FISSION_NK_PANEL_ID_STEP_(FISSION_NK_PANEL_ID_STEP_(FISSION_NK_PANEL_ID_STEP_( \
+        h, s, (i)), s, (i) + 1u), s, (i) + 2u), s, (i) + 3u)
+#define FISSION_NK_PANEL_ID_STEP16_(h, s, i) \
+    FISSION_NK_PANEL_ID_STEP4_(FISSION_NK_PANEL_ID_STEP4_(FISSION_NK_PANEL_ID_STEP4_(FISSION_NK_PANEL_ID_STEP4_( \
+        h, s, (i)), s, (i) + 4u), s, (i) + 8u), s, (i) + 12u)
+#define FISSION_NK_PANEL_ID_HASH(s) \
+    (sizeof("" s) - 1u > FISSION_NK_PANEL_ID_HASH_MAX ? 0u : \
+        FISSION_NK_PANEL_ID_STEP16_(FISSION_NK_PANEL_ID_STEP16_(2166136261u, s, 0u), s, 16u))
+#else
+#define FISSION_NK_PANEL_ID_HASH(s) (0u * (unsigned int)sizeof("" s))
+#endif
+
+/*
+ * One row of a read-only panel table. id_hash is FISSION_NK_PANEL_ID_HASH(desc.id) or 0.
+ * Build rows with FISSION_NK_PANEL_STATIC_DESC so the two always agree.
+ */
+typedef struct fission_nk_panel_static_desc {
+    fission_nk_panel_desc_t desc;
+    unsigned int id_hash;
+} fission_nk_panel_static_desc_t;
+
+typedef struct fission_nk_panel_table {
+    const fission_nk_panel_static_desc_t *rows;
+    size_t count;
+} fission_nk_panel_table_t;
+
+/*
+ * Declares a static const panel table `name` for fission_nk_panel_workspace_adopt_table:
+ *
+ *     FISSION_NK_PANEL_TABLE(
+ *         editor_panels,
+ *         FISSION_NK_PANEL_STATIC_DESC("scene", .title = "Scene", .draw = draw_scene),
+ *         FISSION_NK_PANEL_STATIC_DESC("log", .title = "Log", .draw = draw_log)
+ *     );
+ *
+ * Ids must be string literals; the remaining desc fields are designated initializers.
+ */
+#define FISSION_NK_PANEL_STATIC_DESC(id_literal, ...) \
+    { { .id = id_literal, __VA_ARGS__ }, FISSION_NK_PANEL_ID_HASH(id_literal) }
+#define FISSION_NK_PANEL_TABLE(name, ...) \
+    static const fission_nk_panel_static_desc_t name##_rows[] = { __VA_ARGS__ }; \
+    static const fission_nk_panel_table_t name = { \
+        name##_rows, \
+        sizeof(name##_rows) / sizeof(name##_rows[0]) \
+    }
+
+/* Per-panel state that is not read every frame; see fission_nk_panel_hot_state_t. */
 typedef struct fission_nk_panel_state {
-    int visible;
-    int detached;
     int detachable;
-    fission_nk_panel_slot_t slot;
     fission_nk_panel_bounds_t detached_bounds;
-    fission_nk_panel_bounds_t resolved_bounds;
 } fission_nk_panel_state_t;
 
+typedef struct fission_nk_panel_stat_range {
+    double last;
+    double min;
+    double avg;
+    double max;
+} fission_nk_panel_stat_range_t;
+
+/*
+ * min/avg/max cover the last completed window of FISSION_NK_PANEL_STATS_WINDOW_FRAMES
+ * drawn frames (or the frames drawn so far, before the first window completes).
+ */
+typedef struct fission_nk_panel_stats {
+    fission_nk_panel_stat_range_t cpu_ns;
+    fission_nk_panel_stat_range_t command_count;
+    fission_nk_panel_stat_range_t vertex_count;
+    fission_nk_panel_stat_range_t element_count;
+    unsigned long long sample_count;
+} fission_nk_panel_stats_t;
+
+typedef struct fission_nk_panel_stats_state {
+    fission_nk_panel_stats_t published;
+    double window_sum[FISSION_NK_PANEL_STAT_METRIC_COUNT];
+    double window_min[FISSION_NK_PANEL_STAT_METRIC_COUNT];
+    double window_max[FISSION_NK_PANEL_STAT_METRIC_COUNT];
+    unsigned int window_samples;
+} fission_nk_panel_stats_state_t;
+
+/*
+ * The panel's nk_window as of its last begin_window. It is only trusted while the
+ * window was begun this frame or the previous one (nk_clear frees windows that skipped
+ * a frame), in the same context, and still carries the same name hash.
+ */
+typedef struct fission_nk_panel_window_cache {
+    const struct nk_context *ctx;
+    struct nk_window *window;
+    unsigned int seq;
+    unsigned int name_hash;
+} fission_nk_panel_window_cache_t;
+
+typedef enum fission_nk_panel_init_state {
+    FISSION_NK_PANEL_INIT_READY = 0,
+    FISSION_NK_PANEL_INIT_PENDING = 1,
+    FISSION_NK_PANEL_INIT_RUNNING = 2,
+    FISSION_NK_PANEL_INIT_FAILED = 3
+} fission_nk_panel_init_state_t;
+
+/* static_desc points into an adopted panel table; desc is only used when it is NULL. */
 typedef struct fission_nk_panel_entry {
     fission_nk_panel_desc_t desc;
+    const fission_nk_panel_desc_t *static_desc;
     fission_nk_panel_state_t state;
+    fission_nk_panel_stats_state_t stats;
+    fission_nk_panel_window_cache_t window_cache;
+    fission_nk_panel_init_state_t init_state;
+    fission_nk_panel_status_t init_status;
+    unsigned short generation;
+    size_t next_free;
 } fission_nk_panel_entry_t;
 
+/* One init call handed to the scheduler; `done` is written by the worker with release order. */
+typedef struct fission_nk_panel_init_job {
+    fission_nk_panel_init_fn init;
+    void *user_data;
+    size_t index;
+    fission_nk_panel_status_t status;
+    int in_use;
+    volatile long claimed;
+    volatile long done;
+} fission_nk_panel_init_job_t;
+
+/*
+ * Deferred init: with `lazy` set, register leaves desc.init for the first frame the
+ * panel is drawn, and draws a placeholder window until it has run. With a scheduler,
+ * up to FISSION_NK_PANEL_INIT_JOB_MAX inits run on workers at once.
+ */
+typedef struct fission_nk_panel_init_runner {
+    int lazy;
+    fission_nk_panel_schedule_fn schedule;
+    void *schedule_user_data;
+    fission_nk_panel_init_job_t jobs[FISSION_NK_PANEL_INIT_JOB_MAX];
+} fission_nk_panel_init_runner_t;
+
+typedef enum fission_nk_panel_counter {
+    FISSION_NK_PANEL_COUNTER_PANEL_LOOKUPS = 0,
+    FISSION_NK_PANEL_COUNTER_PANEL_ID_COMPARES = 1,
+    FISSION_NK_PANEL_COUNTER_WINDOW_LOOKUPS = 2,
+    FISSION_NK_PANEL_COUNTER_WINDOW_LIST_STEPS = 3,
+    FISSION_NK_PANEL_COUNTER_WINDOW_NAME_COMPARES = 4,
+    FISSION_NK_PANEL_COUNTER_ID_FORMATS = 5
+} fission_nk_panel_counter_t;
+
+/*
+ * Hot-path operation counts. `current` accumulates until the end of draw_all, which
+ * publishes it to `last_frame` and adds it to `total`; menu and tab-bar work done
+ * before draw_all lands in that frame.
+ */
+typedef struct fission_nk_panel_counters {
+    unsigned long long current[FISSION_NK_PANEL_COUNTER_COUNT];
+    unsigned long long last_frame[FISSION_NK_PANEL_COUNTER_COUNT];
+    unsigned long long total[FISSION_NK_PANEL_COUNTER_COUNT];
+    unsigned long long frames;
+} fission_nk_panel_counters_t;
+
+typedef unsigned long long fission_nk_panel_mask_word_t;
+
+#define FISSION_NK_PANEL_MASK_WORD_BITS 64u
+#define FISSION_NK_PANEL_MASK_WORDS(count) \
+    (((count) + FISSION_NK_PANEL_MASK_WORD_BITS - 1u) / FISSION_NK_PANEL_MASK_WORD_BITS)
+
+/*
+ * Panel state read by every per-frame scan (layout, hover, drag, draw), kept in parallel
+ * arrays indexed like the entries so those loops stay out of the cold descriptors.
+ * Visibility, detachment and dock-slot membership are bitsets (bit i = entry i), so
+ * counts are popcounts and slot bucketing walks set bits; slot[] keeps each panel's slot
+ * for direct lookup. live marks registered entries; unregistered ones keep every bit clear.
+ */
+typedef struct fission_nk_panel_hot_state {
+    fission_nk_panel_bounds_t resolved_bounds[FISSION_NK_MAX_PANELS];
+    fission_nk_panel_mask_word_t visible[FISSION_NK_PANEL_MASK_WORDS(FISSION_NK_MAX_PANELS)];
+    fission_nk_panel_mask_word_t detached[FISSION_NK_PANEL_MASK_WORDS(FISSION_NK_MAX_PANELS)];
+    fission_nk_panel_mask_word_t live[FISSION_NK_PANEL_MASK_WORDS(FISSION_NK_MAX_PANELS)];
+    fission_nk_panel_mask_word_t slot_members[FISSION_NK_PANEL_SLOT_COUNT][
+        FISSION_NK_PANEL_MASK_WORDS(FISSION_NK_MAX_PANELS)
+    ];
+    unsigned char slot[FISSION_NK_MAX_PANELS];
+} fission_nk_panel_hot_state_t;
+
+/*
+ * Open-addressed (linear probe) index of entry ids. slots hold entry index + 1, 0 marks an
+ * empty slot; hashes cache the FNV-1a hash so probes only strcmp on a hash match.
+ */
+typedef struct fission_nk_panel_id_table {
+    unsigned int hashes[FISSION_NK_PANEL_ID_TABLE_SIZE];
+    unsigned short slots[FISSION_NK_PANEL_ID_TABLE_SIZE];
+} fission_nk_panel_id_table_t;
+
+/*
+ * Workspace-wide instrumentation settings; preserved when a tab is loaded.
+ * last_draw_all_ns is the duration of the previous draw_all while panel stats are enabled.
+ */
+typedef struct fission_nk_panel_diagnostics {
+    int panel_stats_enabled;
+    fission_nk_convert_buffers_t panel_stats_convert;
+    unsigned long long last_draw_all_ns;
+    struct fission_nk_trace *trace;
+    fission_nk_panel_counters_t *counters;
+} fission_nk_panel_diagnostics_t;
+
+#define FISSION_NK_PANEL_LAYOUT_CACHE_SIZE 4
+
+/*
+ * One memoized layout resolve, keyed exactly on window size, ratios, the slot touch order
+ * (as ranks), the tabbed slots and their selections, and each slot's docked visible panel
+ * mask. config_hash is a hash of the key, compared first to reject most misses cheaply.
+ * The docked masks and resolved panel bounds live beside the cache (inline) or in the
+ * storage block (dynamic).
+ */
+typedef struct fission_nk_panel_layout_cache_entry {
+    int valid;
+    int window_width;
+    int window_height;
+    float ratios[4];
+    unsigned char slot_rank[FISSION_NK_PANEL_SLOT_COUNT];
+    unsigned char slot_tabbed[FISSION_NK_PANEL_SLOT_COUNT];
+    size_t tab_selection[FISSION_NK_PANEL_SLOT_COUNT];
+    unsigned long long config_hash;
+    unsigned long long last_used;
+    fission_nk_panel_bounds_t dock_workspace_bounds;
+    fission_nk_panel_bounds_t splitter_bounds[4];
+    fission_nk_panel_bounds_t tab_strip_bounds[FISSION_NK_PANEL_SLOT_COUNT];
+    size_t active_tab[FISSION_NK_PANEL_SLOT_COUNT];
+} fission_nk_panel_layout_cache_entry_t;
+
+/* Small LRU of resolved layouts, consulted whenever the dirty-tracked layout re-resolves. */
+typedef struct fission_nk_panel_layout_cache {
+    fission_nk_panel_layout_cache_entry_t entries[FISSION_NK_PANEL_LAYOUT_CACHE_SIZE];
+    fission_nk_panel_bounds_t bounds[FISSION_NK_PANEL_LAYOUT_CACHE_SIZE][FISSION_NK_MAX_PANELS];
+    fission_nk_panel_mask_word_t docked[FISSION_NK_PANEL_LAYOUT_CACHE_SIZE][FISSION_NK_PANEL_SLOT_COUNT][
+        FISSION_NK_PANEL_MASK_WORDS(FISSION_NK_MAX_PANELS)
+    ];
+    unsigned long long clock;
+    unsigned long long hits;
+    unsigned long long misses;
+    int disabled;
+} fission_nk_panel_layout_cache_t;
+
+/*
+ * Heap storage for workspaces created with fission_nk_panel_workspace_init_dynamic.
+ * One allocator block holds the entries, the hot state arrays, the id table and the
+ * per-frame layout/draw scratch; it doubles when full. A block replaced during draw_all
+ * (a panel registering another panel) is retired and freed at the end of the frame.
+ */
+typedef struct fission_nk_panel_storage {
+    const struct nk_allocator *allocator;
+    void *block;
+    void *retired_block;
+    fission_nk_panel_entry_t *entries;
+    fission_nk_panel_bounds_t *resolved_bounds;
+    fission_nk_panel_bounds_t *layout_cache_bounds;
+    fission_nk_panel_mask_word_t *visible;
+    fission_nk_panel_mask_word_t *detached;
+    fission_nk_panel_mask_word_t *live;
+    fission_nk_panel_mask_word_t *slot_members;
+    unsigned char *slot;
+    size_t mask_words;
+    size_t capacity;
+    unsigned int *id_hashes;
+    unsigned short *id_slots;
+    size_t id_table_size;
+    size_t *layout_scratch;
+    fission_nk_panel_mask_word_t *draw_scratch;
+    fission_nk_panel_mask_word_t *layout_cache_docked;
+    int in_frame;
+} fission_nk_panel_storage_t;
+
+/*
+ * count is the entry index bound, not the number of registered panels: unregister leaves
+ * a hole that the next register reuses. free_head is the first free entry index + 1 (0 when
+ * the free list is empty) and entries chain through next_free the same way.
+ *
+ * slot_active_tab is the panel drawn by a tabbed slot as of the last layout resolve, and
+ * slot_tab_strip_bounds the strip above it.
+ */
 struct fission_nk_panel_workspace {
     fission_nk_panel_entry_t entries[FISSION_NK_MAX_PANELS];
+    fission_nk_panel_hot_state_t hot;
     size_t count;
+    size_t free_head;
+    fission_nk_panel_id_table_t id_table;
+    fission_nk_panel_storage_t storage;
     float left_column_ratio;
     float right_column_ratio;
     float top_row_ratio;
     float bottom_row_ratio;
     int last_window_width;
     int last_window_height;
+    int layout_dirty;
+    unsigned int layout_generation;
+    fission_nk_panel_layout_cache_t layout_cache;
     int active_splitter;
     int hovered_splitter;
     int dragging_panel;
@@ -107,18 +446,49 @@ struct fission_nk_panel_workspace {
     float dragging_start_y;
     unsigned long long slot_touch_serial[FISSION_NK_PANEL_SLOT_COUNT];
     unsigned long long next_slot_touch_serial;
+    unsigned char slot_tabbed[FISSION_NK_PANEL_SLOT_COUNT];
+    size_t slot_active_tab[FISSION_NK_PANEL_SLOT_COUNT];
+    fission_nk_panel_bounds_t slot_tab_strip_bounds[FISSION_NK_PANEL_SLOT_COUNT];
     fission_nk_panel_bounds_t dock_workspace_bounds;
     fission_nk_panel_bounds_t splitter_left_bounds;
     fission_nk_panel_bounds_t splitter_right_bounds;
     fission_nk_panel_bounds_t splitter_top_bounds;
     fission_nk_panel_bounds_t splitter_bottom_bounds;
+    struct fission_nk_dock_tree *dock_tree;
     fission_nk_panel_bounds_t ui_scroll_blocks[FISSION_NK_PANEL_UI_SCROLL_BLOCK_MAX];
     size_t ui_scroll_block_count;
     int ui_popup_open;
+    fission_nk_panel_diagnostics_t diagnostics;
+    fission_nk_panel_init_runner_t init_runner;
 };
 
+/*
+ * One tab's arrangement of the shared panel registry. generation[i] is the registration
+ * of entry i the layout was captured from; panels unregistered or registered since then
+ * come up hidden when the tab is loaded.
+ */
+typedef struct fission_nk_panel_tab_layout {
+    float left_column_ratio;
+    float right_column_ratio;
+    float top_row_ratio;
+    float bottom_row_ratio;
+    unsigned long long slot_touch_serial[FISSION_NK_PANEL_SLOT_COUNT];
+    unsigned long long next_slot_touch_serial;
+    unsigned char slot_tabbed[FISSION_NK_PANEL_SLOT_COUNT];
+    size_t slot_active_tab[FISSION_NK_PANEL_SLOT_COUNT];
+    fission_nk_panel_mask_word_t visible[FISSION_NK_PANEL_MASK_WORDS(FISSION_NK_MAX_PANELS)];
+    fission_nk_panel_mask_word_t detached[FISSION_NK_PANEL_MASK_WORDS(FISSION_NK_MAX_PANELS)];
+    unsigned char slot[FISSION_NK_MAX_PANELS];
+    unsigned short generation[FISSION_NK_MAX_PANELS];
+    fission_nk_panel_bounds_t detached_bounds[FISSION_NK_MAX_PANELS];
+} fission_nk_panel_tab_layout_t;
+
+/*
+ * Tabs share the active workspace's entries and only keep per-tab layouts, so panels
+ * registered or unregistered on the workspace are seen by every tab.
+ */
 struct fission_nk_panel_workspace_tabs {
-    fission_nk_panel_workspace_t tabs[FISSION_NK_MAX_WORKSPACE_TABS];
+    fission_nk_panel_tab_layout_t layouts[FISSION_NK_MAX_WORKSPACE_TABS];
     char tab_names[FISSION_NK_MAX_WORKSPACE_TABS][FISSION_NK_WORKSPACE_TAB_NAME_MAX];
     size_t tab_count;
     size_t active_tab_index;
@@ -129,10 +499,101 @@ struct fission_nk_panel_workspace_tabs {
 
 void fission_nk_panel_workspace_init(fission_nk_panel_workspace_t *workspace);
 
+/*
+ * Workspace whose entries live in allocator-backed storage instead of the inline
+ * FISSION_NK_MAX_PANELS array, growing up to FISSION_NK_PANEL_DYNAMIC_MAX_PANELS.
+ * The allocator must outlive the workspace; shutdown releases the storage. Dynamic
+ * workspaces cannot be used with fission_nk_panel_workspace_tabs_t.
+ */
+fission_nk_panel_status_t fission_nk_panel_workspace_init_dynamic(
+    fission_nk_panel_workspace_t *workspace,
+    const struct nk_allocator *allocator,
+    size_t initial_capacity
+);
+size_t fission_nk_panel_workspace_max_panels(const fission_nk_panel_workspace_t *workspace);
+
+/*
+ * Opt-in deferred init for panels registered afterwards. A failing deferred init leaves
+ * the panel registered in FISSION_NK_PANEL_INIT_FAILED instead of failing register.
+ * schedule may be NULL to run init inline on first draw. The workspace must not move
+ * while jobs are in flight; shutdown waits for them. A job the scheduler has not started
+ * by the time the workspace must wait for it is run inline instead, so schedule may also
+ * queue jobs for later on the calling thread, as long as the queue is drained or dropped
+ * before the workspace is shut down. With enabled == 0 the scheduler is still kept, and
+ * register_many runs its inits on it. Builds without atomics (not GCC, Clang or Win32, and
+ * no lock-free C11 <stdatomic.h>) ignore schedule and run every init inline.
+ */
+void fission_nk_panel_workspace_set_lazy_init(
+    fission_nk_panel_workspace_t *workspace,
+    int enabled,
+    fission_nk_panel_schedule_fn schedule,
+    void *schedule_user_data
+);
+fission_nk_panel_init_state_t fission_nk_panel_workspace_panel_init_state_at(
+    const fission_nk_panel_workspace_t *workspace,
+    size_t index
+);
+
 fission_nk_panel_status_t fission_nk_panel_workspace_register(
     fission_nk_panel_workspace_t *workspace,
     const fission_nk_panel_desc_t *panel
 );
+fission_nk_panel_status_t fission_nk_panel_workspace_register_handle(
+    fission_nk_panel_workspace_t *workspace,
+    const fission_nk_panel_desc_t *panel,
+    fission_nk_panel_handle_t *out_handle
+);
+/*
+ * Registers count panels in one pass: each desc is validated and checked for a duplicate
+ * id with one hashed lookup, the registry grows at most once, and each dock slot is
+ * touched once. Panels fill unregistered entries first, most recently freed first, and
+ * only the rest are appended. Inits run after all panels are placed, on the set_lazy_init
+ * scheduler when there is one (or stay deferred with lazy init on). On any failure the
+ * whole batch is unregistered again, with shutdown only for panels whose init succeeded,
+ * entries it appended are dropped from the end again, and the first error in desc order
+ * is returned.
+ */
+fission_nk_panel_status_t fission_nk_panel_workspace_register_many(
+    fission_nk_panel_workspace_t *workspace,
+    const fission_nk_panel_desc_t *panels,
+    size_t count
+);
+
+/*
+ * Registers every row of a FISSION_NK_PANEL_TABLE into a workspace with no live panels.
+ * Entries point at the table rows instead of copying them, and rows are not validated or
+ * checked for duplicate ids: the table must outlive the workspace, and every row needs a
+ * unique id, a title and a draw callback. Row i lands at entry index i. If an init fails,
+ * the adopted panels are unregistered again, the workspace is left empty for a retry, and
+ * the init's status is returned.
+ */
+fission_nk_panel_status_t fission_nk_panel_workspace_adopt_table(
+    fission_nk_panel_workspace_t *workspace,
+    const fission_nk_panel_table_t *table
+);
+
+/*
+ * Removes one panel: its shutdown runs (if its init completed), its handle goes stale and
+ * its entry index is reused by the next register. Waits for the panel's init job if one is
+ * running. Safe to call from draw callbacks; a panel removing itself must do so after its
+ * end_window.
+ */
+fission_nk_panel_status_t fission_nk_panel_workspace_unregister(
+    fission_nk_panel_workspace_t *workspace,
+    const char *panel_id
+);
+fission_nk_panel_status_t fission_nk_panel_workspace_unregister_handle(
+    fission_nk_panel_workspace_t *workspace,
+    fission_nk_panel_handle_t handle
+);
+fission_nk_panel_handle_t fission_nk_panel_workspace_find_handle(
+    const fission_nk_panel_workspace_t *workspace,
+    const char *panel_id
+);
+fission_nk_panel_handle_t fission_nk_panel_workspace_handle_at(
+    const fission_nk_panel_workspace_t *workspace,
+    size_t index
+);
 
 void fission_nk_panel_workspace_draw_all(
     fission_nk_panel_workspace_t *workspace,
@@ -155,9 +616,55 @@ void fission_nk_panel_workspace_end_window(
     const char *panel_id
 );
 
+/* Handle-based twins of the id API; they skip the id lookup entirely. */
+int fission_nk_panel_workspace_begin_window_handle(
+    struct nk_context *ctx,
+    fission_nk_panel_workspace_t *workspace,
+    fission_nk_panel_handle_t handle,
+    const char *title,
+    unsigned int extra_flags,
+    fission_nk_panel_bounds_t *out_bounds
+);
+void fission_nk_panel_workspace_end_window_handle(
+    struct nk_context *ctx,
+    fission_nk_panel_workspace_t *workspace,
+    fission_nk_panel_handle_t handle
+);
+fission_nk_panel_status_t fission_nk_panel_workspace_get_panel_bounds_handle(
+    const fission_nk_panel_workspace_t *workspace,
+    fission_nk_panel_handle_t handle,
+    fission_nk_panel_bounds_t *out_bounds
+);
+int fission_nk_panel_workspace_panel_is_visible_handle(
+    const fission_nk_panel_workspace_t *workspace,
+    fission_nk_panel_handle_t handle
+);
+int fission_nk_panel_workspace_panel_is_detached_handle(
+    const fission_nk_panel_workspace_t *workspace,
+    fission_nk_panel_handle_t handle
+);
+fission_nk_panel_status_t fission_nk_panel_workspace_set_panel_visible_handle(
+    fission_nk_panel_workspace_t *workspace,
+    fission_nk_panel_handle_t handle,
+    int visible
+);
+fission_nk_panel_status_t fission_nk_panel_workspace_set_panel_detached_handle(
+    fission_nk_panel_workspace_t *workspace,
+    fission_nk_panel_handle_t handle,
+    int detached
+);
+fission_nk_panel_status_t fission_nk_panel_workspace_set_panel_detached_bounds_handle(
+    fission_nk_panel_workspace_t *workspace,
+    fission_nk_panel_handle_t handle,
+    const fission_nk_panel_bounds_t *bounds
+);
+
 void fission_nk_panel_workspace_shutdown(fission_nk_panel_workspace_t *workspace);
 
+/* Index bound for the *_at accessors, which treat unregistered entries as absent. */
 size_t fission_nk_panel_workspace_count(const fission_nk_panel_workspace_t *workspace);
+size_t fission_nk_panel_workspace_live_count(const fission_nk_panel_workspace_t *workspace);
+size_t fission_nk_panel_workspace_visible_count(const fission_nk_panel_workspace_t *workspace);
 const char *fission_nk_panel_workspace_panel_id_at(
     const fission_nk_panel_workspace_t *workspace,
     size_t index
@@ -204,6 +711,95 @@ fission_nk_panel_status_t fission_nk_panel_workspace_get_panel_bounds(
     const char *panel_id,
     fission_nk_panel_bounds_t *out_bounds
 );
+
+/*
+ * A tabbed slot stacks its docked panels on the whole slot under a tab strip and only draws
+ * the selected panel. Unselected tabs skip their draw callback, but their windows are begun
+ * with NK_WINDOW_HIDDEN so scroll and edit state survive a tab switch. Docking or showing a
+ * panel in a tabbed slot selects it; when the selected panel leaves, the first remaining one
+ * in registration order takes over. Only visible, docked panels can be selected.
+ * slot_active_tab returns the workspace count when the slot is not tabbed or has no docked
+ * panel.
+ */
+fission_nk_panel_status_t fission_nk_panel_workspace_set_slot_tabbed(
+    fission_nk_panel_workspace_t *workspace,
+    fission_nk_panel_slot_t slot,
+    int tabbed
+);
+int fission_nk_panel_workspace_slot_is_tabbed(
+    const fission_nk_panel_workspace_t *workspace,
+    fission_nk_panel_slot_t slot
+);
+fission_nk_panel_status_t fission_nk_panel_workspace_select_tab_at(
+    fission_nk_panel_workspace_t *workspace,
+    size_t index
+);
+size_t fission_nk_panel_workspace_slot_active_tab(
+    const fission_nk_panel_workspace_t *workspace,
+    fission_nk_panel_slot_t slot
+);
+
+/*
+ * draw_all only re-resolves the layout when one of its inputs changed: the window size,
+ * the column and row ratios, panel registration, visibility, detachment, detached bounds,
+ * slot assignments, the slot touch order (which slot was docked into last decides corner
+ * ownership), tabbed slots or the selected tab. layout_dirty reports pending input changes;
+ * layout_generation advances whenever resolved panel bounds may have moved, so callers
+ * can cache anything derived from them against it. invalidate_layout forces the next
+ * draw_all to re-resolve.
+ */
+unsigned int fission_nk_panel_workspace_layout_generation(const fission_nk_panel_workspace_t *workspace);
+int fission_nk_panel_workspace_layout_dirty(const fission_nk_panel_workspace_t *workspace);
+void fission_nk_panel_workspace_invalidate_layout(fission_nk_panel_workspace_t *workspace);
+
+/*
+ * Re-resolves first look up an LRU of FISSION_NK_PANEL_LAYOUT_CACHE_SIZE recent layouts, so
+ * resize drags and show/hide toggles that revisit a configuration skip the solver. On by
+ * default; disabling it also drops the cached layouts. The counters are cumulative.
+ */
+void fission_nk_panel_workspace_enable_layout_cache(fission_nk_panel_workspace_t *workspace, int enabled);
+void fission_nk_panel_workspace_get_layout_cache_stats(
+    const fission_nk_panel_workspace_t *workspace,
+    unsigned long long *out_hits,
+    unsigned long long *out_misses
+);
+
+/*
+ * The docked slot solver the workspace runs, as a pure function: it reads only its arguments
+ * and touches no Nuklear or workspace state, so it may run on any thread and concurrently.
+ * When out_panel_bounds is non-NULL it receives one rect per docked panel, slot by slot in
+ * slot order, and must hold the sum of input->slot_counts entries.
+ */
+fission_nk_panel_status_t fission_nk_panel_layout_solve(
+    const fission_nk_panel_layout_input_t *input,
+    fission_nk_panel_layout_result_t *out_result,
+    fission_nk_panel_bounds_t *out_panel_bounds
+);
+
+/*
+ * Opt-in dock tree layout: with a tree set, draw_all docks slots into its leaves instead of
+ * the nine-slot grid. A leaf whose tag is a fission_nk_panel_slot_t holds that slot's docked
+ * panels (one leaf per slot, e.g. from fission_nk_dock_tree_slot_preset) and is marked
+ * occupied while the slot has one; leaves with other tags keep the occupancy the host gave
+ * them. The tree's splitters replace the column and row splitters, whose ratios no longer
+ * apply, and dragging one edits the tree. The tree must stay valid while set; call
+ * invalidate_layout after editing it directly. Layouts in this mode skip the layout cache
+ * (each resolve counts as a miss), and fission_nk_panel_layout_solve does not model them.
+ * NULL returns to the grid.
+ */
+void fission_nk_panel_workspace_set_dock_tree(
+    fission_nk_panel_workspace_t *workspace,
+    struct fission_nk_dock_tree *tree
+);
+struct fission_nk_dock_tree *fission_nk_panel_workspace_dock_tree(const fission_nk_panel_workspace_t *workspace);
+
+/* Snapshots a workspace's current solver input for the given window size. */
+fission_nk_panel_status_t fission_nk_panel_workspace_get_layout_input(
+    const fission_nk_panel_workspace_t *workspace,
+    int window_width,
+    int window_height,
+    fission_nk_panel_layout_input_t *out_input
+);
 int fission_nk_panel_workspace_panel_is_detached(
     const fission_nk_panel_workspace_t *workspace,
     const char *panel_id
@@ -227,6 +823,44 @@ void fission_nk_panel_workspace_set_panel_detached_bounds(
     const fission_nk_panel_bounds_t *bounds
 );
 
+void fission_nk_panel_workspace_enable_panel_stats(
+    fission_nk_panel_workspace_t *workspace,
+    int enabled,
+    const fission_nk_convert_buffers_t *convert
+);
+void fission_nk_panel_workspace_reset_panel_stats(fission_nk_panel_workspace_t *workspace);
+int fission_nk_panel_workspace_panel_stats_enabled(const fission_nk_panel_workspace_t *workspace);
+unsigned long long fission_nk_panel_workspace_last_draw_all_ns(
+    const fission_nk_panel_workspace_t *workspace
+);
+
+/* Frame phases are only recorded when the library is built with FISSION_ENABLE_TRACE. */
+void fission_nk_panel_workspace_set_trace(
+    fission_nk_panel_workspace_t *workspace,
+    struct fission_nk_trace *trace
+);
+
+/* Nonzero when the library was built with FISSION_ENABLE_COUNTERS. */
+int fission_nk_panel_counters_instrumentation_enabled(void);
+void fission_nk_panel_counters_reset(fission_nk_panel_counters_t *counters);
+const char *fission_nk_panel_counter_name(fission_nk_panel_counter_t counter);
+
+/* Counters are only incremented when the library is built with FISSION_ENABLE_COUNTERS. */
+void fission_nk_panel_workspace_set_counters(
+    fission_nk_panel_workspace_t *workspace,
+    fission_nk_panel_counters_t *counters
+);
+fission_nk_panel_status_t fission_nk_panel_workspace_get_panel_stats(
+    const fission_nk_panel_workspace_t *workspace,
+    const char *panel_id,
+    fission_nk_panel_stats_t *out_stats
+);
+fission_nk_panel_status_t fission_nk_panel_workspace_get_panel_stats_at(
+    const fission_nk_panel_workspace_t *workspace,
+    size_t index,
+    fission_nk_panel_stats_t *out_stats
+);
+
 void fission_nk_panel_workspace_get_column_ratios(
     const fission_nk_panel_workspace_t *workspace,
     float *out_left_ratio,
@@ -311,6 +945,20 @@ fission_nk_panel_status_t fission_nk_panel_workspace_tabs_register_panel(
     fission_nk_panel_workspace_t *active_workspace,
     const fission_nk_panel_desc_t *panel
 );
+/* The handle is valid in every tab: all tabs share the same entry layout. */
+fission_nk_panel_status_t fission_nk_panel_workspace_tabs_register_panel_handle(
+    fission_nk_panel_workspace_tabs_t *tabs,
+    fission_nk_panel_workspace_t *active_workspace,
+    const fission_nk_panel_desc_t *panel,
+    fission_nk_panel_handle_t *out_handle
+);
+/* register_many, then copies the new panels' layout into each tab. */
+fission_nk_panel_status_t fission_nk_panel_workspace_tabs_register_many(
+    fission_nk_panel_workspace_tabs_t *tabs,
+    fission_nk_panel_workspace_t *active_workspace,
+    const fission_nk_panel_desc_t *panels,
+    size_t count
+);
 void fission_nk_panel_workspace_tabs_draw_all(
     fission_nk_panel_workspace_tabs_t *tabs,
     fission_nk_panel_workspace_t *active_workspace,
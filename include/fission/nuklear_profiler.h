@@ -0,0 +1,55 @@
+#ifndef FISSION_NUKLEAR_PROFILER_H
+#define FISSION_NUKLEAR_PROFILER_H
+
+#include <stddef.h>
+
+#include "fission/nuklear_panels.h"
+
+struct nk_context;
+
+#define FISSION_NK_PROFILER_HISTORY 240
+#define FISSION_NK_PROFILER_PLOT_POINTS 60
+#define FISSION_NK_PROFILER_HISTOGRAM_BINS 16
+#define FISSION_NK_PROFILER_TOP_MAX 8
+
+/*
+ * Ready-made profiler panel: draw_all frame-time history (ring buffer, max-decimated
+ * plot), a frame-time histogram and the top-N panels by average draw time.
+ *
+ * Timing comes from the workspace panel stats, which the host must enable with
+ * fission_nk_panel_workspace_enable_panel_stats; the panel never changes that setting and
+ * only shows a hint while stats are off. Each draw samples the previous frame's draw_all
+ * duration, so the history only advances while the panel is visible. Nothing is allocated
+ * per frame.
+ */
+typedef struct fission_nk_profiler {
+    float frame_ms[FISSION_NK_PROFILER_HISTORY];
+    size_t next;
+    size_t count;
+    size_t top_count;
+    float chart_height;
+} fission_nk_profiler_t;
+
+void fission_nk_profiler_init(fission_nk_profiler_t *profiler, size_t top_count);
+void fission_nk_profiler_clear(fission_nk_profiler_t *profiler);
+void fission_nk_profiler_push_frame_ns(fission_nk_profiler_t *profiler, unsigned long long frame_ns);
+
+/* Fills a desc docked to the right slot whose user_data is the profiler. */
+void fission_nk_profiler_panel_desc(
+    fission_nk_profiler_t *profiler,
+    const char *panel_id,
+    const char *title,
+    fission_nk_panel_desc_t *out_desc
+);
+
+/* The panel draw callback; user_data must be a fission_nk_profiler_t. */
+void fission_nk_profiler_draw_panel(
+    struct nk_context *ctx,
+    fission_nk_panel_workspace_t *workspace,
+    const char *panel_id,
+    int window_width,
+    int window_height,
+    void *user_data
+);
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef FISSION_NUKLEAR_TRACE_H
+#define FISSION_NUKLEAR_TRACE_H
+
+#include <stddef.h>
+
+#define FISSION_NK_TRACE_NAME_MAX 40
+
+typedef struct fission_nk_trace_event {
+    char name[FISSION_NK_TRACE_NAME_MAX];
+    const char *category;
+    unsigned long long start_ns;
+    unsigned long long duration_ns;
+    unsigned long long frame;
+} fission_nk_trace_event_t;
+
+/*
+ * Fixed-capacity ring of complete ("X") trace events. Storage is supplied by the
+ * caller; recording never allocates and overwrites the oldest event when full.
+ */
+typedef struct fission_nk_trace {
+    fission_nk_trace_event_t *events;
+    size_t capacity;
+    size_t next;
+    size_t count;
+    unsigned long long recorded;
+    unsigned long long frame;
+    unsigned long long origin_ns;
+} fission_nk_trace_t;
+
+/* Nonzero when the library was built with FISSION_ENABLE_TRACE. */
+int fission_nk_trace_instrumentation_enabled(void);
+
+void fission_nk_trace_init(
+    fission_nk_trace_t *trace,
+    fission_nk_trace_event_t *events,
+    size_t capacity
+);
+void fission_nk_trace_clear(fission_nk_trace_t *trace);
+
+unsigned long long fission_nk_trace_now_ns(void);
+
+void fission_nk_trace_record(
+    fission_nk_trace_t *trace,
+    const char *name,
+    const char *category,
+    unsigned long long start_ns,
+    unsigned long long end_ns
+);
+void fission_nk_trace_next_frame(fission_nk_trace_t *trace);
+
+/* Writes the buffered events, oldest first, as Chrome trace-event JSON. */
+int fission_nk_trace_write_json(const fission_nk_trace_t *trace, const char *path);
+
+#endif
@@ -5,8 +5,13 @@
 
 struct nk_context;
 struct nk_rect;
+struct nk_window;
+struct nk_buffer;
+struct nk_convert_config;
 
 #define FISSION_NK_DOCK_ZONE_COUNT 9
+#define FISSION_NK_COMMAND_TYPE_COUNT 19
+#define FISSION_NK_CHROME_WINDOW_PREFIX "__fission"
 
 typedef enum fission_nk_dock_zone {
     FISSION_NK_DOCK_ZONE_NONE = -1,
@@ -36,6 +41,33 @@ void fission_nk_rect_intersection(
     const struct nk_rect *b,
     struct nk_rect *out_rect
 );
+
+/*
+ * Batched rect kernels (SSE2 / AArch64 NEON, scalar fallback). Results match the
+ * single-rect helpers exactly; empty rects never contain a point.
+ */
+const char *fission_nk_rect_batch_backend(void);
+int fission_nk_rects_find_point(
+    const struct nk_rect *rects,
+    size_t count,
+    float x,
+    float y
+);
+size_t fission_nk_rects_contain_point(
+    const struct nk_rect *rects,
+    size_t count,
+    float x,
+    float y,
+    unsigned char *out_hits
+);
+/* out_rects may alias rects; returns the number of non-empty intersections. */
+size_t fission_nk_rects_intersect(
+    const struct nk_rect *rects,
+    size_t count,
+    const struct nk_rect *clip,
+    struct nk_rect *out_rects
+);
+
 void fission_nk_focus_current_window_on_scroll(struct nk_context *ctx);
 
 void fission_nk_draw_splitter_overlay(
@@ -94,4 +126,73 @@ void fission_nk_draw_dock_zones_overlay(
     fission_nk_dock_zone_t hovered_zone
 );
 
+typedef struct fission_nk_convert_buffers {
+    const struct nk_convert_config *config;
+    struct nk_buffer *commands;
+    struct nk_buffer *vertices;
+    struct nk_buffer *elements;
+} fission_nk_convert_buffers_t;
+
+typedef struct fission_nk_window_draw_stats {
+    size_t command_count;
+    size_t command_bytes;
+    size_t vertex_count;
+    size_t element_count;
+} fission_nk_window_draw_stats_t;
+
+/*
+ * Measures the commands a window emitted this frame. When convert is non-NULL the
+ * window's commands are also run through nk_convert into the scratch buffers and the
+ * resulting vertex/element counts are reported; that needs the measurement to happen
+ * before the frame's nk_convert/nk_foreach links the windows together.
+ */
+void fission_nk_measure_window(
+    const struct nk_context *ctx,
+    const struct nk_window *window,
+    const fission_nk_convert_buffers_t *convert,
+    fission_nk_window_draw_stats_t *out_stats
+);
+
+typedef struct fission_nk_window_breakdown {
+    const struct nk_window *window;
+    const char *name;
+    int is_chrome;
+    fission_nk_window_draw_stats_t totals;
+    size_t commands_by_type[FISSION_NK_COMMAND_TYPE_COUNT];
+    size_t text_runs;
+    size_t text_bytes;
+    size_t scissor_changes;
+} fission_nk_window_breakdown_t;
+
+typedef struct fission_nk_frame_breakdown {
+    size_t chrome_window_count;
+    size_t content_window_count;
+    fission_nk_window_breakdown_t chrome;
+    fission_nk_window_breakdown_t content;
+} fission_nk_frame_breakdown_t;
+
+/* Per-type breakdown of one window; commands_by_type is indexed by nk_command_type. */
+void fission_nk_measure_window_breakdown(
+    const struct nk_context *ctx,
+    const struct nk_window *window,
+    const fission_nk_convert_buffers_t *convert,
+    fission_nk_window_breakdown_t *out_breakdown
+);
+
+/*
+ * Walks every window nk_convert would draw this frame (call after the last
+ * nk_end, before nk_clear). Windows whose name starts with
+ * FISSION_NK_CHROME_WINDOW_PREFIX (splitter/dock/drag overlays, menu bars) are
+ * summed into out_summary->chrome, everything else into ->content. Up to
+ * window_capacity per-window entries are written; the return value is the total
+ * number of windows, which may exceed the capacity.
+ */
+size_t fission_nk_measure_frame(
+    const struct nk_context *ctx,
+    const fission_nk_convert_buffers_t *convert,
+    fission_nk_window_breakdown_t *out_windows,
+    size_t window_capacity,
+    fission_nk_frame_breakdown_t *out_summary
+);
+
 #endif
@@ -8,5 +8,9 @@
 #include "fission/nuklear_ui.h"
 #include "fission/nuklear_panels.h"
 #include "fission/nuklear_render.h"
+#include "fission/nuklear_trace.h"
+#include "fission/nuklear_alloc.h"
+#include "fission/nuklear_input_record.h"
+#include "fission/nuklear_profiler.h"
 
 #endif
@@ -0,0 +1,137 @@
+#include "fission/nuklear_alloc.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "fission/nuklear.h"
+
+typedef union fission_nk_alloc_header {
+    size_t size;
+    max_align_t align;
+} fission_nk_alloc_header_t;
+
+/*
+ * Nuklear's buffer growth copies from the old block after alloc returns and
+ * frees it itself, so the old pointer must stay valid: never realloc here.
+ */
+static void *fission_nk_counting_alloc(nk_handle handle, void *old, nk_size size)
+{
+    fission_nk_counting_allocator_t *allocator;
+    fission_nk_alloc_header_t *header;
+    size_t bytes;
+
+    (void)old;
+    allocator = (fission_nk_counting_allocator_t *)handle.ptr;
+    if (allocator == NULL) {
+        return NULL;
+    }
+
+    bytes = (size_t)size;
+    if (bytes > (size_t)-1 - sizeof(*header)) {
+        allocator->stats.failed_count += 1u;
+        return NULL;
+    }
+    header = (fission_nk_alloc_header_t *)malloc(sizeof(*header) + bytes);
+    if (header == NULL) {
+        allocator->stats.failed_count += 1u;
+        return NULL;
+    }
+    header->size = bytes;
+
+    allocator->stats.live_bytes += bytes;
+    allocator->stats.live_allocations += 1u;
+    allocator->stats.allocation_count += 1u;
+    if (allocator->stats.live_bytes > allocator->stats.peak_bytes) {
+        allocator->stats.peak_bytes = allocator->stats.live_bytes;
+    }
+    allocator->pending_allocated_bytes += (unsigned long long)bytes;
+    allocator->pending_allocation_count += 1u;
+    return header + 1;
+}
+
+static void fission_nk_counting_free(nk_handle handle, void *old)
+{
+    fission_nk_counting_allocator_t *allocator;
+    fission_nk_alloc_header_t *header;
+
+    if (old == NULL) {
+        return;
+    }
+
+    header = (fission_nk_alloc_header_t *)old - 1;
+    allocator = (fission_nk_counting_allocator_t *)handle.ptr;
+    if (allocator != NULL) {
+        allocator->stats.live_bytes -= header->size;
+        allocator->stats.live_allocations -= 1u;
+        allocator->stats.free_count += 1u;
+        allocator->pending_freed_bytes += (unsigned long long)header->size;
+        allocator->pending_free_count += 1u;
+    }
+    free(header);
+}
+
+void fission_nk_counting_allocator_init(fission_nk_counting_allocator_t *allocator)
+{
+    if (allocator == NULL) {
+        return;
+    }
+
+    memset(allocator, 0, sizeof(*allocator));
+}
+
+void fission_nk_counting_allocator_bind(
+    fission_nk_counting_allocator_t *allocator,
+    struct nk_allocator *out_allocator
+)
+{
+    if (allocator == NULL || out_allocator == NULL) {
+        return;
+    }
+
+    memset(out_allocator, 0, sizeof(*out_allocator));
+    out_allocator->userdata.ptr = allocator;
+    out_allocator->alloc = fission_nk_counting_alloc;
+    out_allocator->free = fission_nk_counting_free;
+}
+
+void fission_nk_counting_allocator_end_frame(fission_nk_counting_allocator_t *allocator)
+{
+    if (allocator == NULL) {
+        return;
+    }
+
+    allocator->stats.frame_allocated_bytes = allocator->pending_allocated_bytes;
+    allocator->stats.frame_freed_bytes = allocator->pending_freed_bytes;
+    allocator->stats.frame_allocation_count = allocator->pending_allocation_count;
+    allocator->stats.frame_free_count = allocator->pending_free_count;
+    allocator->stats.frames += 1u;
+    allocator->pending_allocated_bytes = 0u;
+    allocator->pending_freed_bytes = 0u;
+    allocator->pending_allocation_count = 0u;
+    allocator->pending_free_count = 0u;
+}
+
+void fission_nk_counting_allocator_snapshot(
+    const fission_nk_counting_allocator_t *allocator,
+    fission_nk_alloc_stats_t *out_stats
+)
+{
+    if (out_stats == NULL) {
+        return;
+    }
+    if (allocator == NULL) {
+        memset(out_stats, 0, sizeof(*out_stats));
+        return;
+    }
+
+    *out_stats = allocator->stats;
+}
+
+void fission_nk_counting_allocator_reset_peak(fission_nk_counting_allocator_t *allocator)
+{
+    if (allocator == NULL) {
+        return;
+    }
+
+    allocator->stats.peak_bytes = allocator->stats.live_bytes;
+}
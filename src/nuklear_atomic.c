@@ -0,0 +1,79 @@
+#include "nuklear_atomic.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sched.h>
+#endif
+
+#if defined(FISSION_NK_ATOMIC_USE_STDATOMIC)
+/* A lock-free atomic long has the plain long's size, so the shared words are used in place. */
+typedef char fission_nk_atomic_long_size_check[(sizeof(atomic_long) == sizeof(long)) ? 1 : -1];
+#define FISSION_NK_ATOMIC_LONG(value) ((volatile atomic_long *)(value))
+#endif
+
+long fission_nk_atomic_load_acquire(const volatile long *value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#elif defined(_WIN32)
+    /* Interlocked operations are full barriers. */
+    return InterlockedCompareExchange((volatile LONG *)value, 0, 0);
+#elif defined(FISSION_NK_ATOMIC_USE_STDATOMIC)
+    return atomic_load_explicit(FISSION_NK_ATOMIC_LONG(value), memory_order_acquire);
+#else
+    return *value;
+#endif
+}
+
+void fission_nk_atomic_store_release(volatile long *value, long desired)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_store_n(value, desired, __ATOMIC_RELEASE);
+#elif defined(_WIN32)
+    (void)InterlockedExchange(value, desired);
+#elif defined(FISSION_NK_ATOMIC_USE_STDATOMIC)
+    atomic_store_explicit(FISSION_NK_ATOMIC_LONG(value), desired, memory_order_release);
+#else
+    *value = desired;
+#endif
+}
+
+int fission_nk_atomic_compare_exchange(volatile long *value, long expected, long desired)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_compare_exchange_n(
+        value,
+        &expected,
+        desired,
+        0,
+        __ATOMIC_ACQ_REL,
+        __ATOMIC_ACQUIRE
+    ) ? 1 : 0;
+#elif defined(_WIN32)
+    return InterlockedCompareExchange((volatile LONG *)value, desired, expected) == expected;
+#elif defined(FISSION_NK_ATOMIC_USE_STDATOMIC)
+    return atomic_compare_exchange_strong_explicit(
+        FISSION_NK_ATOMIC_LONG(value),
+        &expected,
+        desired,
+        memory_order_acq_rel,
+        memory_order_acquire
+    ) ? 1 : 0;
+#else
+    if (*value != expected) {
+        return 0;
+    }
+    *value = desired;
+    return 1;
+#endif
+}
+
+void fission_nk_thread_yield(void)
+{
+#if defined(_WIN32)
+    (void)SwitchToThread();
+#elif defined(__unix__) || defined(__APPLE__)
+    (void)sched_yield();
+#endif
+}
@@ -0,0 +1,30 @@
+#ifndef FISSION_NUKLEAR_ATOMIC_H
+#define FISSION_NUKLEAR_ATOMIC_H
+
+/*
+ * FISSION_NK_HAVE_ATOMICS is 1 when the helpers below are real atomics: compiler builtins,
+ * Interlocked calls, or lock-free C11 <stdatomic.h>. Otherwise they are plain accesses that
+ * are only safe on a single thread, and the workspace refuses worker schedulers.
+ */
+#if defined(__GNUC__) || defined(__clang__) || defined(_WIN32)
+#define FISSION_NK_HAVE_ATOMICS 1
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#if ATOMIC_LONG_LOCK_FREE == 2
+#define FISSION_NK_HAVE_ATOMICS 1
+#define FISSION_NK_ATOMIC_USE_STDATOMIC 1
+#endif
+#endif
+#if !defined(FISSION_NK_HAVE_ATOMICS)
+#define FISSION_NK_HAVE_ATOMICS 0
+#endif
+
+/* Acquire load / release store on a word shared with another thread. */
+long fission_nk_atomic_load_acquire(const volatile long *value);
+void fission_nk_atomic_store_release(volatile long *value, long desired);
+/* Stores desired when *value equals expected; returns non-zero when it did. */
+int fission_nk_atomic_compare_exchange(volatile long *value, long expected, long desired);
+/* Gives up the rest of the time slice while spinning on another thread. */
+void fission_nk_thread_yield(void);
+
+#endif
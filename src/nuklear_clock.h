@@ -0,0 +1,6 @@
+#ifndef FISSION_NUKLEAR_CLOCK_H
+#define FISSION_NUKLEAR_CLOCK_H
+
+unsigned long long fission_nk_clock_now_ns(void);
+
+#endif
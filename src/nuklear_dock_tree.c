@@ -0,0 +1,520 @@
+#include "fission/nuklear_dock_tree.h"
+
+#include <string.h>
+
+static float fission_nk_dock_tree_clamp_ratio(const fission_nk_dock_tree_t *tree, float ratio)
+{
+    if (ratio < tree->min_ratio) {
+        return tree->min_ratio;
+    }
+    if (ratio > 1.0f - tree->min_ratio) {
+        return 1.0f - tree->min_ratio;
+    }
+    return ratio;
+}
+
+static int fission_nk_dock_tree_is_kind(
+    const fission_nk_dock_tree_t *tree,
+    size_t index,
+    fission_nk_dock_node_kind_t kind
+)
+{
+    return (
+        tree != NULL &&
+        index < tree->node_count &&
+        tree->nodes[index].kind == (unsigned char)kind
+    );
+}
+
+static size_t fission_nk_dock_tree_alloc(fission_nk_dock_tree_t *tree)
+{
+    fission_nk_dock_node_t *node;
+    size_t index;
+
+    if (tree->free_head != FISSION_NK_DOCK_NODE_NONE) {
+        index = tree->free_head;
+        tree->free_head = tree->nodes[index].first;
+    } else if (tree->node_count < (size_t)FISSION_NK_DOCK_TREE_MAX_NODES) {
+        index = tree->node_count;
+        tree->node_count += 1u;
+    } else {
+        return FISSION_NK_DOCK_NODE_NONE;
+    }
+
+    node = &tree->nodes[index];
+    memset(node, 0, sizeof(*node));
+    node->parent = FISSION_NK_DOCK_NODE_NONE;
+    node->first = FISSION_NK_DOCK_NODE_NONE;
+    node->second = FISSION_NK_DOCK_NODE_NONE;
+    node->ratio = 0.5f;
+    return index;
+}
+
+static void fission_nk_dock_tree_release(fission_nk_dock_tree_t *tree, size_t index)
+{
+    memset(&tree->nodes[index], 0, sizeof(tree->nodes[index]));
+    tree->nodes[index].first = tree->free_head;
+    tree->free_head = (unsigned short)index;
+}
+
+/* Points whatever referenced old_child (its parent or the root) at new_child instead. */
+static void fission_nk_dock_tree_replace_child(
+    fission_nk_dock_tree_t *tree,
+    size_t parent,
+    size_t old_child,
+    size_t new_child
+)
+{
+    tree->nodes[new_child].parent = (unsigned short)parent;
+    if (parent == FISSION_NK_DOCK_NODE_NONE) {
+        tree->root = (unsigned short)new_child;
+    } else if (tree->nodes[parent].first == old_child) {
+        tree->nodes[parent].first = (unsigned short)new_child;
+    } else {
+        tree->nodes[parent].second = (unsigned short)new_child;
+    }
+}
+
+static void fission_nk_dock_tree_adjust_occupied(fission_nk_dock_tree_t *tree, size_t index, int delta)
+{
+    while (index != FISSION_NK_DOCK_NODE_NONE) {
+        tree->nodes[index].occupied = (unsigned short)((int)tree->nodes[index].occupied + delta);
+        index = tree->nodes[index].parent;
+    }
+}
+
+void fission_nk_dock_tree_init(fission_nk_dock_tree_t *tree, int root_tag)
+{
+    size_t root;
+
+    if (tree == NULL) {
+        return;
+    }
+
+    memset(tree, 0, sizeof(*tree));
+    tree->free_head = FISSION_NK_DOCK_NODE_NONE;
+    tree->gap = FISSION_NK_DOCK_TREE_GAP;
+    tree->min_ratio = 0.05f;
+
+    root = fission_nk_dock_tree_alloc(tree);
+    tree->nodes[root].kind = (unsigned char)FISSION_NK_DOCK_NODE_LEAF;
+    tree->nodes[root].tag = root_tag;
+    tree->nodes[root].occupied = 1u;
+    tree->root = (unsigned short)root;
+}
+
+size_t fission_nk_dock_tree_split(
+    fission_nk_dock_tree_t *tree,
+    size_t leaf,
+    fission_nk_dock_axis_t axis,
+    float ratio,
+    int tag,
+    int new_first
+)
+{
+    fission_nk_dock_node_t *split_node;
+    size_t split;
+    size_t added;
+
+    if (fission_nk_dock_tree_is_kind(tree, leaf, FISSION_NK_DOCK_NODE_LEAF) == 0) {
+        return FISSION_NK_DOCK_NODE_NONE;
+    }
+    if (axis != FISSION_NK_DOCK_AXIS_ROW && axis != FISSION_NK_DOCK_AXIS_COLUMN) {
+        return FISSION_NK_DOCK_NODE_NONE;
+    }
+
+    split = fission_nk_dock_tree_alloc(tree);
+    if (split == FISSION_NK_DOCK_NODE_NONE) {
+        return FISSION_NK_DOCK_NODE_NONE;
+    }
+    added = fission_nk_dock_tree_alloc(tree);
+    if (added == FISSION_NK_DOCK_NODE_NONE) {
+        fission_nk_dock_tree_release(tree, split);
+        return FISSION_NK_DOCK_NODE_NONE;
+    }
+
+    split_node = &tree->nodes[split];
+    split_node->kind = (unsigned char)FISSION_NK_DOCK_NODE_SPLIT;
+    split_node->axis = (unsigned char)axis;
+    split_node->ratio = fission_nk_dock_tree_clamp_ratio(tree, ratio);
+    split_node->occupied = tree->nodes[leaf].occupied;
+    fission_nk_dock_tree_replace_child(tree, tree->nodes[leaf].parent, leaf, split);
+    if (new_first != 0) {
+        split_node->first = (unsigned short)added;
+        split_node->second = (unsigned short)leaf;
+    } else {
+        split_node->first = (unsigned short)leaf;
+        split_node->second = (unsigned short)added;
+    }
+    tree->nodes[leaf].parent = (unsigned short)split;
+
+    tree->nodes[added].kind = (unsigned char)FISSION_NK_DOCK_NODE_LEAF;
+    tree->nodes[added].tag = tag;
+    tree->nodes[added].parent = (unsigned short)split;
+    fission_nk_dock_tree_adjust_occupied(tree, added, 1);
+    return added;
+}
+
+fission_nk_panel_status_t fission_nk_dock_tree_remove(fission_nk_dock_tree_t *tree, size_t leaf)
+{
+    size_t parent;
+    size_t sibling;
+
+    if (fission_nk_dock_tree_is_kind(tree, leaf, FISSION_NK_DOCK_NODE_LEAF) == 0) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+    parent = tree->nodes[leaf].parent;
+    if (parent == FISSION_NK_DOCK_NODE_NONE) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    fission_nk_dock_tree_adjust_occupied(tree, leaf, -(int)tree->nodes[leaf].occupied);
+    sibling = (tree->nodes[parent].first == leaf) ? tree->nodes[parent].second : tree->nodes[parent].first;
+    fission_nk_dock_tree_replace_child(tree, tree->nodes[parent].parent, parent, sibling);
+    fission_nk_dock_tree_release(tree, leaf);
+    fission_nk_dock_tree_release(tree, parent);
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+fission_nk_panel_status_t fission_nk_dock_tree_set_occupied(
+    fission_nk_dock_tree_t *tree,
+    size_t leaf,
+    int occupied
+)
+{
+    unsigned short value;
+
+    if (fission_nk_dock_tree_is_kind(tree, leaf, FISSION_NK_DOCK_NODE_LEAF) == 0) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    value = (occupied != 0) ? 1u : 0u;
+    if (tree->nodes[leaf].occupied != value) {
+        fission_nk_dock_tree_adjust_occupied(tree, leaf, (value != 0u) ? 1 : -1);
+    }
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+fission_nk_panel_status_t fission_nk_dock_tree_set_ratio(
+    fission_nk_dock_tree_t *tree,
+    size_t split,
+    float ratio
+)
+{
+    if (fission_nk_dock_tree_is_kind(tree, split, FISSION_NK_DOCK_NODE_SPLIT) == 0) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    tree->nodes[split].ratio = fission_nk_dock_tree_clamp_ratio(tree, ratio);
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+void fission_nk_dock_tree_resolve(
+    fission_nk_dock_tree_t *tree,
+    const fission_nk_panel_bounds_t *bounds
+)
+{
+    unsigned short stack[FISSION_NK_DOCK_TREE_MAX_NODES];
+    size_t depth;
+
+    if (tree == NULL || bounds == NULL || tree->node_count == 0u) {
+        return;
+    }
+
+    memset(&tree->nodes[tree->root].bounds, 0, sizeof(tree->nodes[tree->root].bounds));
+    if (tree->nodes[tree->root].occupied != 0u) {
+        tree->nodes[tree->root].bounds = *bounds;
+    }
+    stack[0] = tree->root;
+    depth = 1u;
+    while (depth > 0u) {
+        fission_nk_dock_node_t *node;
+        fission_nk_dock_node_t *first;
+        fission_nk_dock_node_t *second;
+        float extent;
+        float first_extent;
+
+        depth -= 1u;
+        node = &tree->nodes[stack[depth]];
+        memset(&node->splitter, 0, sizeof(node->splitter));
+        if (node->kind != (unsigned char)FISSION_NK_DOCK_NODE_SPLIT) {
+            continue;
+        }
+
+        first = &tree->nodes[node->first];
+        second = &tree->nodes[node->second];
+        memset(&first->bounds, 0, sizeof(first->bounds));
+        memset(&second->bounds, 0, sizeof(second->bounds));
+        if (first->occupied == 0u || second->occupied == 0u) {
+            if (first->occupied != 0u) {
+                first->bounds = node->bounds;
+            } else if (second->occupied != 0u) {
+                second->bounds = node->bounds;
+            }
+        } else {
+            first->bounds = node->bounds;
+            second->bounds = node->bounds;
+            node->splitter = node->bounds;
+            if (node->axis == (unsigned char)FISSION_NK_DOCK_AXIS_ROW) {
+                extent = node->bounds.w - tree->gap;
+                if (extent < 0.0f) {
+                    extent = 0.0f;
+                }
+                first_extent = extent * node->ratio;
+                first->bounds.w = first_extent;
+                node->splitter.x = node->bounds.x + first_extent;
+                node->splitter.w = tree->gap;
+                second->bounds.x = node->splitter.x + tree->gap;
+                second->bounds.w = extent - first_extent;
+            } else {
+                extent = node->bounds.h - tree->gap;
+                if (extent < 0.0f) {
+                    extent = 0.0f;
+                }
+                first_extent = extent * node->ratio;
+                first->bounds.h = first_extent;
+                node->splitter.y = node->bounds.y + first_extent;
+                node->splitter.h = tree->gap;
+                second->bounds.y = node->splitter.y + tree->gap;
+                second->bounds.h = extent - first_extent;
+            }
+        }
+
+        stack[depth] = node->second;
+        stack[depth + 1u] = node->first;
+        depth += 2u;
+    }
+}
+
+size_t fission_nk_dock_tree_hit_splitter(const fission_nk_dock_tree_t *tree, float x, float y)
+{
+    size_t i;
+
+    if (tree == NULL) {
+        return FISSION_NK_DOCK_NODE_NONE;
+    }
+
+    for (i = 0u; i < tree->node_count; ++i) {
+        const fission_nk_panel_bounds_t *splitter;
+
+        if (tree->nodes[i].kind != (unsigned char)FISSION_NK_DOCK_NODE_SPLIT) {
+            continue;
+        }
+        splitter = &tree->nodes[i].splitter;
+        if (
+            splitter->w > 0.0f &&
+            splitter->h > 0.0f &&
+            x >= splitter->x &&
+            y >= splitter->y &&
+            x <= splitter->x + splitter->w &&
+            y <= splitter->y + splitter->h
+        ) {
+            return i;
+        }
+    }
+    return FISSION_NK_DOCK_NODE_NONE;
+}
+
+int fission_nk_dock_tree_drag_splitter(fission_nk_dock_tree_t *tree, size_t split, float delta)
+{
+    fission_nk_dock_node_t *node;
+    float extent;
+    float ratio;
+
+    if (fission_nk_dock_tree_is_kind(tree, split, FISSION_NK_DOCK_NODE_SPLIT) == 0) {
+        return 0;
+    }
+
+    node = &tree->nodes[split];
+    if (node->splitter.w <= 0.0f || node->splitter.h <= 0.0f) {
+        return 0;
+    }
+    if (node->axis == (unsigned char)FISSION_NK_DOCK_AXIS_ROW) {
+        extent = node->bounds.w - tree->gap;
+    } else {
+        extent = node->bounds.h - tree->gap;
+    }
+    if (extent <= 0.0f) {
+        return 0;
+    }
+
+    ratio = fission_nk_dock_tree_clamp_ratio(tree, node->ratio + delta / extent);
+    if (ratio == node->ratio) {
+        return 0;
+    }
+    node->ratio = ratio;
+    return 1;
+}
+
+/*
+ * Band splits give the first child (top band, left column) its ratio; the inner splits get
+ * the middle's share of what is left, so with every cell occupied the three spans follow
+ * the ratios.
+ */
+static void fission_nk_dock_tree_apply_band_ratios(
+    fission_nk_dock_tree_t *tree,
+    const size_t leaves[FISSION_NK_PANEL_SLOT_COUNT],
+    float left_column_ratio,
+    float right_column_ratio,
+    float top_row_ratio,
+    float bottom_row_ratio
+)
+{
+    static const fission_nk_panel_slot_t band_centers[3] = {
+        FISSION_NK_PANEL_SLOT_TOP,
+        FISSION_NK_PANEL_SLOT_CENTER,
+        FISSION_NK_PANEL_SLOT_BOTTOM
+    };
+    size_t band;
+    size_t top_band_split;
+    size_t mid_band_split;
+
+    for (band = 0u; band < 3u; ++band) {
+        size_t inner;
+
+        inner = tree->nodes[leaves[(size_t)band_centers[band]]].parent;
+        (void)fission_nk_dock_tree_set_ratio(
+            tree,
+            inner,
+            (1.0f - left_column_ratio - right_column_ratio) / (1.0f - left_column_ratio)
+        );
+        (void)fission_nk_dock_tree_set_ratio(tree, tree->nodes[inner].parent, left_column_ratio);
+    }
+
+    top_band_split = tree->nodes[tree->nodes[leaves[(size_t)FISSION_NK_PANEL_SLOT_TOP]].parent].parent;
+    mid_band_split = tree->nodes[tree->nodes[leaves[(size_t)FISSION_NK_PANEL_SLOT_CENTER]].parent].parent;
+    (void)fission_nk_dock_tree_set_ratio(tree, tree->nodes[top_band_split].parent, top_row_ratio);
+    (void)fission_nk_dock_tree_set_ratio(
+        tree,
+        tree->nodes[mid_band_split].parent,
+        (1.0f - top_row_ratio - bottom_row_ratio) / (1.0f - top_row_ratio)
+    );
+}
+
+void fission_nk_dock_tree_slot_preset(
+    fission_nk_dock_tree_t *tree,
+    float left_column_ratio,
+    float right_column_ratio,
+    float top_row_ratio,
+    float bottom_row_ratio,
+    size_t out_leaves[FISSION_NK_PANEL_SLOT_COUNT]
+)
+{
+    if (tree == NULL || out_leaves == NULL) {
+        return;
+    }
+
+    fission_nk_dock_tree_init(tree, (int)FISSION_NK_PANEL_SLOT_CENTER);
+    out_leaves[FISSION_NK_PANEL_SLOT_CENTER] = tree->root;
+    out_leaves[FISSION_NK_PANEL_SLOT_TOP] = fission_nk_dock_tree_split(
+        tree,
+        out_leaves[FISSION_NK_PANEL_SLOT_CENTER],
+        FISSION_NK_DOCK_AXIS_COLUMN,
+        0.5f,
+        (int)FISSION_NK_PANEL_SLOT_TOP,
+        1
+    );
+    out_leaves[FISSION_NK_PANEL_SLOT_BOTTOM] = fission_nk_dock_tree_split(
+        tree,
+        out_leaves[FISSION_NK_PANEL_SLOT_CENTER],
+        FISSION_NK_DOCK_AXIS_COLUMN,
+        0.5f,
+        (int)FISSION_NK_PANEL_SLOT_BOTTOM,
+        0
+    );
+
+    out_leaves[FISSION_NK_PANEL_SLOT_TOP_LEFT] = fission_nk_dock_tree_split(
+        tree,
+        out_leaves[FISSION_NK_PANEL_SLOT_TOP],
+        FISSION_NK_DOCK_AXIS_ROW,
+        0.5f,
+        (int)FISSION_NK_PANEL_SLOT_TOP_LEFT,
+        1
+    );
+    out_leaves[FISSION_NK_PANEL_SLOT_TOP_RIGHT] = fission_nk_dock_tree_split(
+        tree,
+        out_leaves[FISSION_NK_PANEL_SLOT_TOP],
+        FISSION_NK_DOCK_AXIS_ROW,
+        0.5f,
+        (int)FISSION_NK_PANEL_SLOT_TOP_RIGHT,
+        0
+    );
+    out_leaves[FISSION_NK_PANEL_SLOT_LEFT] = fission_nk_dock_tree_split(
+        tree,
+        out_leaves[FISSION_NK_PANEL_SLOT_CENTER],
+        FISSION_NK_DOCK_AXIS_ROW,
+        0.5f,
+        (int)FISSION_NK_PANEL_SLOT_LEFT,
+        1
+    );
+    out_leaves[FISSION_NK_PANEL_SLOT_RIGHT] = fission_nk_dock_tree_split(
+        tree,
+        out_leaves[FISSION_NK_PANEL_SLOT_CENTER],
+        FISSION_NK_DOCK_AXIS_ROW,
+        0.5f,
+        (int)FISSION_NK_PANEL_SLOT_RIGHT,
+        0
+    );
+    out_leaves[FISSION_NK_PANEL_SLOT_BOTTOM_LEFT] = fission_nk_dock_tree_split(
+        tree,
+        out_leaves[FISSION_NK_PANEL_SLOT_BOTTOM],
+        FISSION_NK_DOCK_AXIS_ROW,
+        0.5f,
+        (int)FISSION_NK_PANEL_SLOT_BOTTOM_LEFT,
+        1
+    );
+    out_leaves[FISSION_NK_PANEL_SLOT_BOTTOM_RIGHT] = fission_nk_dock_tree_split(
+        tree,
+        out_leaves[FISSION_NK_PANEL_SLOT_BOTTOM],
+        FISSION_NK_DOCK_AXIS_ROW,
+        0.5f,
+        (int)FISSION_NK_PANEL_SLOT_BOTTOM_RIGHT,
+        0
+    );
+
+    fission_nk_dock_tree_apply_band_ratios(
+        tree,
+        out_leaves,
+        left_column_ratio,
+        right_column_ratio,
+        top_row_ratio,
+        bottom_row_ratio
+    );
+}
+
+void fission_nk_dock_tree_sync_slot_preset(
+    fission_nk_dock_tree_t *tree,
+    const size_t leaves[FISSION_NK_PANEL_SLOT_COUNT],
+    const fission_nk_panel_workspace_t *workspace
+)
+{
+    int occupied[FISSION_NK_PANEL_SLOT_COUNT];
+    float left_ratio;
+    float right_ratio;
+    float top_ratio;
+    float bottom_ratio;
+    size_t count;
+    size_t i;
+
+    if (tree == NULL || leaves == NULL || workspace == NULL) {
+        return;
+    }
+
+    fission_nk_panel_workspace_get_column_ratios(workspace, &left_ratio, &right_ratio);
+    fission_nk_panel_workspace_get_row_ratios(workspace, &top_ratio, &bottom_ratio);
+    fission_nk_dock_tree_apply_band_ratios(tree, leaves, left_ratio, right_ratio, top_ratio, bottom_ratio);
+
+    memset(occupied, 0, sizeof(occupied));
+    count = fission_nk_panel_workspace_count(workspace);
+    for (i = 0u; i < count; ++i) {
+        if (
+            fission_nk_panel_workspace_panel_is_visible_at(workspace, i) != 0 &&
+            fission_nk_panel_workspace_panel_is_detached_at(workspace, i) == 0
+        ) {
+            occupied[fission_nk_panel_workspace_panel_slot_at(workspace, i)] = 1;
+        }
+    }
+    for (i = 0u; i < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++i) {
+        (void)fission_nk_dock_tree_set_occupied(tree, leaves[i], occupied[i]);
+    }
+}
@@ -0,0 +1,559 @@
+#include "fission/nuklear_input_record.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "fission/nuklear.h"
+
+enum {
+    FISSION_NK_INPUT_FRAME_SIZE = 1 << 0,
+    FISSION_NK_INPUT_FRAME_MOTION = 1 << 1,
+    FISSION_NK_INPUT_FRAME_BUTTONS = 1 << 2,
+    FISSION_NK_INPUT_FRAME_SCROLL = 1 << 3,
+    FISSION_NK_INPUT_FRAME_KEYS = 1 << 4,
+    FISSION_NK_INPUT_FRAME_TEXT = 1 << 5,
+    FISSION_NK_INPUT_FRAME_ALL = (1 << 6) - 1
+};
+
+#define FISSION_NK_INPUT_RECORD_MAGIC "FNKI"
+#define FISSION_NK_INPUT_RECORD_MAX_BUTTONS 8
+
+static int fission_nk_input_button_limit(void)
+{
+    return (NK_BUTTON_MAX < FISSION_NK_INPUT_RECORD_MAX_BUTTONS) ?
+        (int)NK_BUTTON_MAX :
+        FISSION_NK_INPUT_RECORD_MAX_BUTTONS;
+}
+
+static int fission_nk_input_clamp_i16(float value)
+{
+    if (value < -32768.0f) {
+        return -32768;
+    }
+    if (value > 32767.0f) {
+        return 32767;
+    }
+    return (value < 0.0f) ? (int)(value - 0.5f) : (int)(value + 0.5f);
+}
+
+static unsigned int fission_nk_input_clamp_u8(unsigned int value)
+{
+    return (value > 255u) ? 255u : value;
+}
+
+static unsigned int fission_nk_input_clamp_u16(int value)
+{
+    if (value < 0) {
+        return 0u;
+    }
+    return (value > 65535) ? 65535u : (unsigned int)value;
+}
+
+static void fission_nk_input_write_u8(FILE *file, unsigned int value)
+{
+    fputc((int)(value & 0xffu), file);
+}
+
+static void fission_nk_input_write_u16(FILE *file, unsigned int value)
+{
+    fission_nk_input_write_u8(file, value);
+    fission_nk_input_write_u8(file, value >> 8);
+}
+
+static void fission_nk_input_write_i16(FILE *file, int value)
+{
+    fission_nk_input_write_u16(file, (unsigned int)value & 0xffffu);
+}
+
+static void fission_nk_input_write_f32(FILE *file, float value)
+{
+    unsigned long bits;
+    nk_uint raw;
+
+    memcpy(&raw, &value, sizeof(raw));
+    bits = (unsigned long)raw;
+    fission_nk_input_write_u16(file, (unsigned int)(bits & 0xffffu));
+    fission_nk_input_write_u16(file, (unsigned int)((bits >> 16) & 0xffffu));
+}
+
+static int fission_nk_input_read_u8(FILE *file, unsigned int *out_value)
+{
+    int c;
+
+    c = fgetc(file);
+    if (c == EOF) {
+        return 0;
+    }
+    *out_value = (unsigned int)c;
+    return 1;
+}
+
+static int fission_nk_input_read_u16(FILE *file, unsigned int *out_value)
+{
+    unsigned int lo;
+    unsigned int hi;
+
+    if (
+        fission_nk_input_read_u8(file, &lo) == 0 ||
+        fission_nk_input_read_u8(file, &hi) == 0
+    ) {
+        return 0;
+    }
+    *out_value = lo | (hi << 8);
+    return 1;
+}
+
+static int fission_nk_input_read_i16(FILE *file, int *out_value)
+{
+    unsigned int raw;
+
+    if (fission_nk_input_read_u16(file, &raw) == 0) {
+        return 0;
+    }
+    *out_value = (raw >= 0x8000u) ? (int)raw - 0x10000 : (int)raw;
+    return 1;
+}
+
+static int fission_nk_input_read_f32(FILE *file, float *out_value)
+{
+    unsigned int lo;
+    unsigned int hi;
+    nk_uint raw;
+
+    if (
+        fission_nk_input_read_u16(file, &lo) == 0 ||
+        fission_nk_input_read_u16(file, &hi) == 0
+    ) {
+        return 0;
+    }
+    raw = (nk_uint)((unsigned long)lo | ((unsigned long)hi << 16));
+    memcpy(out_value, &raw, sizeof(*out_value));
+    return 1;
+}
+
+int fission_nk_input_recorder_open(
+    fission_nk_input_recorder_t *recorder,
+    const char *path,
+    int width,
+    int height
+)
+{
+    FILE *file;
+
+    if (recorder == NULL || path == NULL) {
+        return 0;
+    }
+
+    memset(recorder, 0, sizeof(*recorder));
+    file = fopen(path, "wb");
+    if (file == NULL) {
+        return 0;
+    }
+
+    fputs(FISSION_NK_INPUT_RECORD_MAGIC, file);
+    fission_nk_input_write_u16(file, FISSION_NK_INPUT_RECORD_VERSION);
+    fission_nk_input_write_u16(file, 0u);
+    fission_nk_input_write_u16(file, fission_nk_input_clamp_u16(width));
+    fission_nk_input_write_u16(file, fission_nk_input_clamp_u16(height));
+
+    recorder->file = file;
+    recorder->width = width;
+    recorder->height = height;
+    recorder->failed = (ferror(file) != 0);
+    return recorder->failed == 0;
+}
+
+int fission_nk_input_recorder_capture(
+    fission_nk_input_recorder_t *recorder,
+    const struct nk_context *ctx,
+    int width,
+    int height
+)
+{
+    const struct nk_input *in;
+    FILE *file;
+    unsigned int flags;
+    unsigned int button_mask;
+    unsigned int key_count;
+    int button_limit;
+    int mouse_x;
+    int mouse_y;
+    int i;
+
+    if (recorder == NULL || recorder->file == NULL || ctx == NULL) {
+        return 0;
+    }
+
+    file = (FILE *)recorder->file;
+    in = &ctx->input;
+    button_limit = fission_nk_input_button_limit();
+    mouse_x = fission_nk_input_clamp_i16(in->mouse.pos.x);
+    mouse_y = fission_nk_input_clamp_i16(in->mouse.pos.y);
+
+    button_mask = 0u;
+    for (i = 0; i < button_limit; ++i) {
+        if (in->mouse.buttons[i].clicked != 0u) {
+            button_mask |= 1u << i;
+        }
+    }
+    key_count = 0u;
+    for (i = 0; i < NK_KEY_MAX; ++i) {
+        if (in->keyboard.keys[i].clicked != 0u) {
+            key_count += 1u;
+        }
+    }
+
+    flags = 0u;
+    if (recorder->frames == 0u || width != recorder->width || height != recorder->height) {
+        flags |= FISSION_NK_INPUT_FRAME_SIZE;
+    }
+    if (recorder->frames == 0u || mouse_x != recorder->mouse_x || mouse_y != recorder->mouse_y) {
+        flags |= FISSION_NK_INPUT_FRAME_MOTION;
+    }
+    if (button_mask != 0u) {
+        flags |= FISSION_NK_INPUT_FRAME_BUTTONS;
+    }
+    if (in->mouse.scroll_delta.x != 0.0f || in->mouse.scroll_delta.y != 0.0f) {
+        flags |= FISSION_NK_INPUT_FRAME_SCROLL;
+    }
+    if (key_count != 0u) {
+        flags |= FISSION_NK_INPUT_FRAME_KEYS;
+    }
+    if (in->keyboard.text_len > 0) {
+        flags |= FISSION_NK_INPUT_FRAME_TEXT;
+    }
+
+    fission_nk_input_write_u8(file, flags);
+    if ((flags & FISSION_NK_INPUT_FRAME_SIZE) != 0u) {
+        fission_nk_input_write_u16(file, fission_nk_input_clamp_u16(width));
+        fission_nk_input_write_u16(file, fission_nk_input_clamp_u16(height));
+    }
+    if ((flags & FISSION_NK_INPUT_FRAME_MOTION) != 0u) {
+        fission_nk_input_write_i16(file, mouse_x);
+        fission_nk_input_write_i16(file, mouse_y);
+    }
+    if ((flags & FISSION_NK_INPUT_FRAME_BUTTONS) != 0u) {
+        fission_nk_input_write_u8(file, button_mask);
+        for (i = 0; i < button_limit; ++i) {
+            const struct nk_mouse_button *button;
+
+            if ((button_mask & (1u << i)) == 0u) {
+                continue;
+            }
+            button = &in->mouse.buttons[i];
+            fission_nk_input_write_u8(file, fission_nk_input_clamp_u8(button->clicked));
+            fission_nk_input_write_u8(file, (button->down != 0) ? 1u : 0u);
+            fission_nk_input_write_i16(file, fission_nk_input_clamp_i16(button->clicked_pos.x));
+            fission_nk_input_write_i16(file, fission_nk_input_clamp_i16(button->clicked_pos.y));
+        }
+    }
+    if ((flags & FISSION_NK_INPUT_FRAME_SCROLL) != 0u) {
+        fission_nk_input_write_f32(file, in->mouse.scroll_delta.x);
+        fission_nk_input_write_f32(file, in->mouse.scroll_delta.y);
+    }
+    if ((flags & FISSION_NK_INPUT_FRAME_KEYS) != 0u) {
+        fission_nk_input_write_u8(file, key_count);
+        for (i = 0; i < NK_KEY_MAX; ++i) {
+            const struct nk_key *key;
+
+            key = &in->keyboard.keys[i];
+            if (key->clicked == 0u) {
+                continue;
+            }
+            fission_nk_input_write_u8(file, (unsigned int)i);
+            fission_nk_input_write_u8(file, fission_nk_input_clamp_u8(key->clicked));
+            fission_nk_input_write_u8(file, (key->down != 0) ? 1u : 0u);
+        }
+    }
+    if ((flags & FISSION_NK_INPUT_FRAME_TEXT) != 0u) {
+        unsigned int text_len;
+
+        text_len = (unsigned int)in->keyboard.text_len;
+        if (text_len > (unsigned int)NK_INPUT_MAX) {
+            text_len = (unsigned int)NK_INPUT_MAX;
+        }
+        fission_nk_input_write_u8(file, text_len);
+        (void)fwrite(in->keyboard.text, 1u, text_len, file);
+    }
+
+    recorder->width = width;
+    recorder->height = height;
+    recorder->mouse_x = mouse_x;
+    recorder->mouse_y = mouse_y;
+    recorder->frames += 1u;
+    if (ferror(file) != 0) {
+        recorder->failed = 1;
+    }
+    return recorder->failed == 0;
+}
+
+int fission_nk_input_recorder_close(fission_nk_input_recorder_t *recorder)
+{
+    int ok;
+
+    if (recorder == NULL || recorder->file == NULL) {
+        return 0;
+    }
+
+    ok = (recorder->failed == 0 && ferror((FILE *)recorder->file) == 0);
+    if (fclose((FILE *)recorder->file) != 0) {
+        ok = 0;
+    }
+    recorder->file = NULL;
+    return ok;
+}
+
+int fission_nk_input_player_open(fission_nk_input_player_t *player, const char *path)
+{
+    FILE *file;
+    char magic[4];
+    unsigned int version;
+    unsigned int reserved;
+    unsigned int width;
+    unsigned int height;
+
+    if (player == NULL || path == NULL) {
+        return 0;
+    }
+
+    memset(player, 0, sizeof(*player));
+    file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+
+    if (
+        fread(magic, 1u, sizeof(magic), file) != sizeof(magic) ||
+        memcmp(magic, FISSION_NK_INPUT_RECORD_MAGIC, sizeof(magic)) != 0 ||
+        fission_nk_input_read_u16(file, &version) == 0 ||
+        version != FISSION_NK_INPUT_RECORD_VERSION ||
+        fission_nk_input_read_u16(file, &reserved) == 0 ||
+        fission_nk_input_read_u16(file, &width) == 0 ||
+        fission_nk_input_read_u16(file, &height) == 0
+    ) {
+        (void)fclose(file);
+        return 0;
+    }
+
+    player->file = file;
+    player->first_frame_offset = ftell(file);
+    player->initial_width = (int)width;
+    player->initial_height = (int)height;
+    player->width = (int)width;
+    player->height = (int)height;
+    return player->first_frame_offset >= 0;
+}
+
+static void fission_nk_input_replay_transitions(
+    struct nk_context *ctx,
+    int is_key,
+    int id,
+    unsigned int transitions,
+    unsigned int down,
+    int x,
+    int y
+)
+{
+    unsigned int t;
+
+    /* Alternate states so the last transition lands on the recorded state. */
+    for (t = 0u; t < transitions; ++t) {
+        nk_bool state;
+
+        state = (((transitions - 1u - t) & 1u) == 0u) ? (down != 0u) : (down == 0u);
+        if (is_key != 0) {
+            nk_input_key(ctx, (enum nk_keys)id, state);
+        } else {
+            nk_input_button(ctx, (enum nk_buttons)id, x, y, state);
+        }
+    }
+}
+
+static int fission_nk_input_player_read_frame(
+    fission_nk_input_player_t *player,
+    FILE *file,
+    unsigned int flags,
+    struct nk_context *ctx
+)
+{
+    unsigned int count;
+    unsigned int i;
+
+    if ((flags & ~(unsigned int)FISSION_NK_INPUT_FRAME_ALL) != 0u) {
+        return 0;
+    }
+
+    if ((flags & FISSION_NK_INPUT_FRAME_SIZE) != 0u) {
+        unsigned int width;
+        unsigned int height;
+
+        if (
+            fission_nk_input_read_u16(file, &width) == 0 ||
+            fission_nk_input_read_u16(file, &height) == 0
+        ) {
+            return 0;
+        }
+        player->width = (int)width;
+        player->height = (int)height;
+    }
+    if ((flags & FISSION_NK_INPUT_FRAME_MOTION) != 0u) {
+        int x;
+        int y;
+
+        if (
+            fission_nk_input_read_i16(file, &x) == 0 ||
+            fission_nk_input_read_i16(file, &y) == 0
+        ) {
+            return 0;
+        }
+        nk_input_motion(ctx, x, y);
+    }
+    if ((flags & FISSION_NK_INPUT_FRAME_BUTTONS) != 0u) {
+        unsigned int mask;
+        int button_limit;
+        int b;
+
+        if (fission_nk_input_read_u8(file, &mask) == 0) {
+            return 0;
+        }
+        button_limit = fission_nk_input_button_limit();
+        for (b = 0; b < FISSION_NK_INPUT_RECORD_MAX_BUTTONS; ++b) {
+            unsigned int transitions;
+            unsigned int down;
+            int x;
+            int y;
+
+            if ((mask & (1u << b)) == 0u) {
+                continue;
+            }
+            if (
+                fission_nk_input_read_u8(file, &transitions) == 0 ||
+                fission_nk_input_read_u8(file, &down) == 0 ||
+                fission_nk_input_read_i16(file, &x) == 0 ||
+                fission_nk_input_read_i16(file, &y) == 0
+            ) {
+                return 0;
+            }
+            if (b < button_limit) {
+                fission_nk_input_replay_transitions(ctx, 0, b, transitions, down, x, y);
+            }
+        }
+    }
+    if ((flags & FISSION_NK_INPUT_FRAME_SCROLL) != 0u) {
+        float x;
+        float y;
+
+        if (
+            fission_nk_input_read_f32(file, &x) == 0 ||
+            fission_nk_input_read_f32(file, &y) == 0
+        ) {
+            return 0;
+        }
+        nk_input_scroll(ctx, nk_vec2(x, y));
+    }
+    if ((flags & FISSION_NK_INPUT_FRAME_KEYS) != 0u) {
+        if (fission_nk_input_read_u8(file, &count) == 0) {
+            return 0;
+        }
+        for (i = 0u; i < count; ++i) {
+            unsigned int key;
+            unsigned int transitions;
+            unsigned int down;
+
+            if (
+                fission_nk_input_read_u8(file, &key) == 0 ||
+                fission_nk_input_read_u8(file, &transitions) == 0 ||
+                fission_nk_input_read_u8(file, &down) == 0
+            ) {
+                return 0;
+            }
+            if (key < (unsigned int)NK_KEY_MAX) {
+                fission_nk_input_replay_transitions(ctx, 1, (int)key, transitions, down, 0, 0);
+            }
+        }
+    }
+    if ((flags & FISSION_NK_INPUT_FRAME_TEXT) != 0u) {
+        char text[256];
+        unsigned int keep;
+
+        if (
+            fission_nk_input_read_u8(file, &count) == 0 ||
+            fread(text, 1u, count, file) != count
+        ) {
+            return 0;
+        }
+        keep = (count > (unsigned int)NK_INPUT_MAX) ? (unsigned int)NK_INPUT_MAX : count;
+        memcpy(ctx->input.keyboard.text, text, keep);
+        ctx->input.keyboard.text_len = (int)keep;
+    }
+    return 1;
+}
+
+int fission_nk_input_player_next(
+    fission_nk_input_player_t *player,
+    struct nk_context *ctx,
+    int *out_width,
+    int *out_height
+)
+{
+    FILE *file;
+    unsigned int flags;
+    int ok;
+
+    if (player == NULL || player->file == NULL || player->failed != 0 || ctx == NULL) {
+        return 0;
+    }
+
+    file = (FILE *)player->file;
+    if (fission_nk_input_read_u8(file, &flags) == 0) {
+        if (ferror(file) != 0) {
+            player->failed = 1;
+        }
+        return 0;
+    }
+
+    nk_input_begin(ctx);
+    ok = fission_nk_input_player_read_frame(player, file, flags, ctx);
+    nk_input_end(ctx);
+    if (ok == 0) {
+        player->failed = 1;
+        return 0;
+    }
+
+    player->frames += 1u;
+    if (out_width != NULL) {
+        *out_width = player->width;
+    }
+    if (out_height != NULL) {
+        *out_height = player->height;
+    }
+    return 1;
+}
+
+int fission_nk_input_player_rewind(fission_nk_input_player_t *player)
+{
+    if (player == NULL || player->file == NULL) {
+        return 0;
+    }
+
+    if (fseek((FILE *)player->file, player->first_frame_offset, SEEK_SET) != 0) {
+        player->failed = 1;
+        return 0;
+    }
+    clearerr((FILE *)player->file);
+    player->width = player->initial_width;
+    player->height = player->initial_height;
+    player->frames = 0u;
+    player->failed = 0;
+    return 1;
+}
+
+void fission_nk_input_player_close(fission_nk_input_player_t *player)
+{
+    if (player == NULL || player->file == NULL) {
+        return;
+    }
+
+    (void)fclose((FILE *)player->file);
+    player->file = NULL;
+}
@@ -4,7 +4,11 @@
 #include <string.h>
 
 #include "fission/nuklear.h"
+#include "fission/nuklear_dock_tree.h"
+#include "fission/nuklear_trace.h"
 #include "fission/nuklear_ui.h"
+#include "nuklear_atomic.h"
+#include "nuklear_clock.h"
 
 #define FISSION_NK_PANEL_MARGIN 12.0f
 #define FISSION_NK_PANEL_TOP_RESERVED 34.0f
@@ -20,12 +24,66 @@
 #define FISSION_NK_PANEL_HEADER_BUTTON_GAP 4.0f
 #define FISSION_NK_PANEL_HEADER_ICON_PADDING 4.0f
 
+#if defined(FISSION_NK_ENABLE_TRACE)
+#define FISSION_NK_PANEL_TRACE_MARK(host) fission_nk_panel_host_trace_mark(host)
+#define FISSION_NK_PANEL_TRACE_PHASE(host, name, start_ns) \
+    fission_nk_panel_host_trace_phase((host), (name), "workspace", (start_ns))
+#define FISSION_NK_PANEL_TRACE_PANEL(host, name, start_ns) \
+    fission_nk_panel_host_trace_phase((host), (name), "panel", (start_ns))
+#define FISSION_NK_PANEL_TRACE_END_FRAME(host) \
+    fission_nk_trace_next_frame((host)->diagnostics.trace)
+#else
+#define FISSION_NK_PANEL_TRACE_MARK(host) 0ull
+#define FISSION_NK_PANEL_TRACE_PHASE(host, name, start_ns) ((void)(start_ns))
+#define FISSION_NK_PANEL_TRACE_PANEL(host, name, start_ns) ((void)(start_ns))
+#define FISSION_NK_PANEL_TRACE_END_FRAME(host) ((void)0)
+#endif
+
+#if defined(FISSION_NK_ENABLE_COUNTERS)
+#define FISSION_NK_PANEL_COUNT(host, counter, amount) \
+    fission_nk_panel_host_count((host), (counter), (amount))
+#define FISSION_NK_PANEL_COUNTERS_END_FRAME(host) \
+    fission_nk_panel_host_counters_end_frame(host)
+#else
+#define FISSION_NK_PANEL_COUNT(host, counter, amount) ((void)(host))
+#define FISSION_NK_PANEL_COUNTERS_END_FRAME(host) ((void)(host))
+#endif
+
+/* Entry array of a workspace: allocator-backed storage when present, else inline. */
+#define FISSION_NK_PANEL_ENTRIES(host) \
+    ((host)->storage.entries != NULL ? (host)->storage.entries : (host)->entries)
+/* Hot state arrays, selected the same way. */
+#define FISSION_NK_PANEL_HOT(host, field) \
+    ((host)->storage.entries != NULL ? (host)->storage.field : (host)->hot.field)
+#define FISSION_NK_PANEL_VISIBLE(host) FISSION_NK_PANEL_HOT(host, visible)
+#define FISSION_NK_PANEL_DETACHED(host) FISSION_NK_PANEL_HOT(host, detached)
+#define FISSION_NK_PANEL_LIVE(host) FISSION_NK_PANEL_HOT(host, live)
+#define FISSION_NK_PANEL_SLOT(host) FISSION_NK_PANEL_HOT(host, slot)
+#define FISSION_NK_PANEL_SLOT_MEMBERS(host, slot) \
+    ((host)->storage.entries != NULL ? \
+        (host)->storage.slot_members + (size_t)(slot) * (host)->storage.mask_words : \
+        (host)->hot.slot_members[(slot)])
+#define FISSION_NK_PANEL_INLINE_MASK_WORDS FISSION_NK_PANEL_MASK_WORDS((size_t)FISSION_NK_MAX_PANELS)
+#define FISSION_NK_PANEL_RESOLVED_BOUNDS(host) FISSION_NK_PANEL_HOT(host, resolved_bounds)
+#define FISSION_NK_PANEL_INDEX_NONE ((size_t)-1)
+#define FISSION_NK_PANEL_LAYOUT_CACHE_BOUNDS(host, entry) \
+    (((host)->storage.entries != NULL) ? \
+        (host)->storage.layout_cache_bounds + (entry) * (host)->storage.capacity : \
+        (host)->layout_cache.bounds[entry])
+#define FISSION_NK_PANEL_LAYOUT_CACHE_DOCKED(host, entry, slot) \
+    (((host)->storage.entries != NULL) ? \
+        (host)->storage.layout_cache_docked + \
+            ((entry) * (size_t)FISSION_NK_PANEL_SLOT_COUNT + (slot)) * (host)->storage.mask_words : \
+        (host)->layout_cache.docked[entry][slot])
+
 enum {
     FISSION_NK_PANEL_SPLITTER_NONE = 0,
     FISSION_NK_PANEL_SPLITTER_LEFT = 1,
     FISSION_NK_PANEL_SPLITTER_RIGHT = 2,
     FISSION_NK_PANEL_SPLITTER_TOP = 3,
-    FISSION_NK_PANEL_SPLITTER_BOTTOM = 4
+    FISSION_NK_PANEL_SPLITTER_BOTTOM = 4,
+    /* Dock tree splitters use this plus the split's node index. */
+    FISSION_NK_PANEL_SPLITTER_TREE = 16
 };
 
 enum {
@@ -36,6 +94,79 @@ enum {
     FISSION_NK_CORNER_OWNER_BOTTOM = 4
 };
 
+enum {
+    FISSION_NK_PANEL_STAT_CPU_NS = 0,
+    FISSION_NK_PANEL_STAT_COMMANDS = 1,
+    FISSION_NK_PANEL_STAT_VERTICES = 2,
+    FISSION_NK_PANEL_STAT_ELEMENTS = 3
+};
+
+#if defined(FISSION_NK_ENABLE_TRACE)
+static unsigned long long fission_nk_panel_host_trace_mark(
+    const fission_nk_panel_workspace_t *host
+)
+{
+    if (host->diagnostics.trace == NULL) {
+        return 0u;
+    }
+    return fission_nk_clock_now_ns();
+}
+
+static void fission_nk_panel_host_trace_phase(
+    const fission_nk_panel_workspace_t *host,
+    const char *name,
+    const char *category,
+    unsigned long long start_ns
+)
+{
+    if (host->diagnostics.trace == NULL) {
+        return;
+    }
+    fission_nk_trace_record(
+        host->diagnostics.trace,
+        name,
+        category,
+        start_ns,
+        fission_nk_clock_now_ns()
+    );
+}
+#endif
+
+typedef char fission_nk_panel_counter_count_check[
+    (FISSION_NK_PANEL_COUNTER_ID_FORMATS + 1 == FISSION_NK_PANEL_COUNTER_COUNT) ? 1 : -1
+];
+
+#if defined(FISSION_NK_ENABLE_COUNTERS)
+static void fission_nk_panel_host_count(
+    const fission_nk_panel_workspace_t *host,
+    fission_nk_panel_counter_t counter,
+    unsigned long long amount
+)
+{
+    if (host == NULL || host->diagnostics.counters == NULL) {
+        return;
+    }
+    host->diagnostics.counters->current[counter] += amount;
+}
+
+static void fission_nk_panel_host_counters_end_frame(const fission_nk_panel_workspace_t *host)
+{
+    fission_nk_panel_counters_t *counters;
+    size_t i;
+
+    counters = host->diagnostics.counters;
+    if (counters == NULL) {
+        return;
+    }
+    for (i = 0u; i < (size_t)FISSION_NK_PANEL_COUNTER_COUNT; ++i) {
+        counters->last_frame[i] = counters->current[i];
+        counters->total[i] += counters->current[i];
+        counters->current[i] = 0u;
+    }
+    counters->frames += 1u;
+}
+#endif
+
 static void fission_nk_panel_overlay_id(
     char *buffer,
     size_t buffer_size,
@@ -52,6 +183,7 @@ static void fission_nk_panel_overlay_id(
         return;
     }
 
+    FISSION_NK_PANEL_COUNT(workspace, FISSION_NK_PANEL_COUNTER_ID_FORMATS, 1u);
     (void)snprintf(
         buffer,
         buffer_size,
@@ -192,6 +324,12 @@ static int fission_nk_panel_slot_is_valid(fission_nk_panel_slot_t slot)
     );
 }
 
+/* Any change to ratios, visibility, detachment or slot membership must come through here. */
+static void fission_nk_panel_host_invalidate_layout(fission_nk_panel_workspace_t *host)
+{
+    host->layout_dirty = 1;
+}
+
 static void fission_nk_panel_touch_slot(
     fission_nk_panel_workspace_t *host,
     fission_nk_panel_slot_t slot
@@ -203,6 +341,7 @@ static void fission_nk_panel_touch_slot(
 
     host->slot_touch_serial[(size_t)slot] = host->next_slot_touch_serial;
     host->next_slot_touch_serial += 1u;
+    fission_nk_panel_host_invalidate_layout(host);
 }
 
 static int fission_nk_panel_choose_corner_owner(
@@ -253,6 +392,14 @@ static void fission_nk_panel_bounds_zero(fission_nk_panel_bounds_t *bounds)
     bounds->h = 0.0f;
 }
 
+static void fission_nk_panel_bounds_set(fission_nk_panel_bounds_t *bounds, float x, float y, float w, float h)
+{
+    bounds->x = x;
+    bounds->y = y;
+    bounds->w = w;
+    bounds->h = h;
+}
+
 static struct nk_rect fission_nk_panel_bounds_to_nk_rect(const fission_nk_panel_bounds_t *bounds)
 {
     if (bounds == NULL) {
@@ -574,24 +721,524 @@ static void fission_nk_panel_draw_header_buttons(
     }
 }
 
+typedef char fission_nk_panel_id_table_size_check[
+    (
+        FISSION_NK_PANEL_ID_TABLE_SIZE >= 2 * FISSION_NK_MAX_PANELS &&
+        (FISSION_NK_PANEL_ID_TABLE_SIZE & (FISSION_NK_PANEL_ID_TABLE_SIZE - 1)) == 0 &&
+        FISSION_NK_MAX_PANELS < 65535
+    ) ? 1 : -1
+];
+
+static const fission_nk_panel_desc_t *fission_nk_panel_entry_desc(const fission_nk_panel_entry_t *entry)
+{
+    return (entry->static_desc != NULL) ? entry->static_desc : &entry->desc;
+}
+
+static unsigned int fission_nk_panel_id_hash(const char *panel_id)
+{
+    unsigned int hash;
+
+    hash = 2166136261u;
+    while (*panel_id != '\0') {
+        hash ^= (unsigned int)(unsigned char)*panel_id;
+        hash *= 16777619u;
+        ++panel_id;
+    }
+    return hash;
+}
+
+static size_t fission_nk_panel_find_index_hashed(
+    const fission_nk_panel_workspace_t *host,
+    const char *panel_id,
+    unsigned int hash
+)
+{
+    const unsigned int *hashes;
+    const unsigned short *slots;
+    size_t mask;
+    size_t probe;
+    size_t i;
+
+    if (host->storage.entries != NULL) {
+        hashes = host->storage.id_hashes;
+        slots = host->storage.id_slots;
+        mask = host->storage.id_table_size - 1u;
+    } else {
+        hashes = host->id_table.hashes;
+        slots = host->id_table.slots;
+        mask = (size_t)FISSION_NK_PANEL_ID_TABLE_SIZE - 1u;
+    }
+
+    FISSION_NK_PANEL_COUNT(host, FISSION_NK_PANEL_COUNTER_PANEL_LOOKUPS, 1u);
+    probe = (size_t)hash & mask;
+    for (i = 0u; i <= mask; ++i) {
+        size_t index;
+
+        if (slots[probe] == 0u) {
+            break;
+        }
+        index = (size_t)slots[probe] - 1u;
+        if (hashes[probe] == hash && index < host->count) {
+            FISSION_NK_PANEL_COUNT(host, FISSION_NK_PANEL_COUNTER_PANEL_ID_COMPARES, 1u);
+            if (strcmp(fission_nk_panel_entry_desc(&FISSION_NK_PANEL_ENTRIES(host)[index])->id, panel_id) == 0) {
+                return index;
+            }
+        }
+        probe = (probe + 1u) & mask;
+    }
+
+    return FISSION_NK_PANEL_INDEX_NONE;
+}
+
 static size_t fission_nk_panel_find_index(
     const fission_nk_panel_workspace_t *host,
     const char *panel_id
 )
 {
+    if (host == NULL || panel_id == NULL) {
+        return FISSION_NK_PANEL_INDEX_NONE;
+    }
+    return fission_nk_panel_find_index_hashed(host, panel_id, fission_nk_panel_id_hash(panel_id));
+}
+
+static void fission_nk_panel_id_table_insert_hashed(
+    fission_nk_panel_workspace_t *host,
+    size_t index,
+    unsigned int hash
+)
+{
+    unsigned int *hashes;
+    unsigned short *slots;
+    size_t mask;
+    size_t probe;
+
+    if (host->storage.entries != NULL) {
+        hashes = host->storage.id_hashes;
+        slots = host->storage.id_slots;
+        mask = host->storage.id_table_size - 1u;
+    } else {
+        hashes = host->id_table.hashes;
+        slots = host->id_table.slots;
+        mask = (size_t)FISSION_NK_PANEL_ID_TABLE_SIZE - 1u;
+    }
+
+    probe = (size_t)hash & mask;
+    while (slots[probe] != 0u) {
+        probe = (probe + 1u) & mask;
+    }
+    hashes[probe] = hash;
+    slots[probe] = (unsigned short)(index + 1u);
+}
+
+static void fission_nk_panel_id_table_insert(
+    fission_nk_panel_workspace_t *host,
+    size_t index
+)
+{
+    fission_nk_panel_id_table_insert_hashed(
+        host,
+        index,
+        fission_nk_panel_id_hash(fission_nk_panel_entry_desc(&FISSION_NK_PANEL_ENTRIES(host)[index])->id)
+    );
+}
+
+/* Backward-shift deletion, so probe chains stay unbroken without tombstones. */
+static void fission_nk_panel_id_table_remove(
+    fission_nk_panel_workspace_t *host,
+    size_t index
+)
+{
+    unsigned int *hashes;
+    unsigned short *slots;
+    size_t mask;
+    size_t probe;
+    size_t next;
     size_t i;
 
-    if (host == NULL || panel_id == NULL) {
-        return (size_t)FISSION_NK_MAX_PANELS;
+    if (host->storage.entries != NULL) {
+        hashes = host->storage.id_hashes;
+        slots = host->storage.id_slots;
+        mask = host->storage.id_table_size - 1u;
+    } else {
+        hashes = host->id_table.hashes;
+        slots = host->id_table.slots;
+        mask = (size_t)FISSION_NK_PANEL_ID_TABLE_SIZE - 1u;
+    }
+
+    probe = (size_t)fission_nk_panel_id_hash(fission_nk_panel_entry_desc(&FISSION_NK_PANEL_ENTRIES(host)[index])->id) & mask;
+    for (i = 0u; i <= mask; ++i) {
+        if (slots[probe] == 0u) {
+            return;
+        }
+        if ((size_t)slots[probe] == index + 1u) {
+            break;
+        }
+        probe = (probe + 1u) & mask;
+    }
+    if (i > mask) {
+        return;
+    }
+
+    next = (probe + 1u) & mask;
+    while (slots[next] != 0u) {
+        size_t home;
+
+        /* The entry at next may fill the hole unless its home lies in (probe, next]. */
+        home = (size_t)hashes[next] & mask;
+        if (((next - home) & mask) >= ((next - probe) & mask)) {
+            hashes[probe] = hashes[next];
+            slots[probe] = slots[next];
+            probe = next;
+        }
+        next = (next + 1u) & mask;
+    }
+    slots[probe] = 0u;
+    hashes[probe] = 0u;
+}
+
+static int fission_nk_panel_mask_test(const fission_nk_panel_mask_word_t *mask, size_t index)
+{
+    return (
+        (mask[index / FISSION_NK_PANEL_MASK_WORD_BITS] >> (index % FISSION_NK_PANEL_MASK_WORD_BITS)) & 1u
+    ) != 0u;
+}
+
+static void fission_nk_panel_mask_assign(fission_nk_panel_mask_word_t *mask, size_t index, int value)
+{
+    fission_nk_panel_mask_word_t bit;
+
+    bit = (fission_nk_panel_mask_word_t)1u << (index % FISSION_NK_PANEL_MASK_WORD_BITS);
+    if (value != 0) {
+        mask[index / FISSION_NK_PANEL_MASK_WORD_BITS] |= bit;
+    } else {
+        mask[index / FISSION_NK_PANEL_MASK_WORD_BITS] &= ~bit;
+    }
+}
+
+static size_t fission_nk_panel_mask_popcount(fission_nk_panel_mask_word_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_popcountll(word);
+#else
+    size_t count;
+
+    count = 0u;
+    while (word != 0u) {
+        word &= word - 1u;
+        count += 1u;
+    }
+    return count;
+#endif
+}
+
+/* Index of the lowest set bit; word must be non-zero. */
+static size_t fission_nk_panel_mask_lowest(fission_nk_panel_mask_word_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(word);
+#else
+    size_t bit;
+
+    bit = 0u;
+    while ((word & 1u) == 0u) {
+        word >>= 1u;
+        bit += 1u;
+    }
+    return bit;
+#endif
+}
+
+static size_t fission_nk_panel_host_mask_words(const fission_nk_panel_workspace_t *host)
+{
+    if (host->storage.entries != NULL) {
+        return host->storage.mask_words;
+    }
+    return FISSION_NK_PANEL_INLINE_MASK_WORDS;
+}
+
+/* Entries freed by unregister stay below count until a register reuses them. */
+static int fission_nk_panel_host_is_live(const fission_nk_panel_workspace_t *host, size_t index)
+{
+    if (host == NULL || index >= host->count) {
+        return 0;
+    }
+    return fission_nk_panel_mask_test(FISSION_NK_PANEL_LIVE(host), index);
+}
+
+/* Sets bits [0, count) of a mask and clears the rest of its words. */
+static void fission_nk_panel_mask_fill(fission_nk_panel_mask_word_t *mask, size_t words, size_t count)
+{
+    size_t w;
+
+    for (w = 0u; w < words; ++w) {
+        if (count >= FISSION_NK_PANEL_MASK_WORD_BITS * (w + 1u)) {
+            mask[w] = ~(fission_nk_panel_mask_word_t)0u;
+        } else if (count > FISSION_NK_PANEL_MASK_WORD_BITS * w) {
+            mask[w] = ((fission_nk_panel_mask_word_t)1u << (count % FISSION_NK_PANEL_MASK_WORD_BITS)) - 1u;
+        } else {
+            mask[w] = 0u;
+        }
+    }
+}
+
+/*
+ * Visible, docked panels of one slot, ascending by registration order. A tabbed slot
+ * reports only its selected panel, which is settled here.
+ */
+static size_t fission_nk_panel_host_collect_slot(
+    fission_nk_panel_workspace_t *host,
+    fission_nk_panel_slot_t slot,
+    size_t *out_indices
+)
+{
+    const fission_nk_panel_mask_word_t *visible;
+    const fission_nk_panel_mask_word_t *detached;
+    const fission_nk_panel_mask_word_t *members;
+    size_t words;
+    size_t count;
+    size_t w;
+
+    visible = FISSION_NK_PANEL_VISIBLE(host);
+    detached = FISSION_NK_PANEL_DETACHED(host);
+    members = FISSION_NK_PANEL_SLOT_MEMBERS(host, slot);
+    words = fission_nk_panel_host_mask_words(host);
+    count = 0u;
+    for (w = 0u; w < words; ++w) {
+        fission_nk_panel_mask_word_t bits;
+
+        bits = visible[w] & ~detached[w] & members[w];
+        while (bits != 0u) {
+            out_indices[count] = w * FISSION_NK_PANEL_MASK_WORD_BITS + fission_nk_panel_mask_lowest(bits);
+            count += 1u;
+            bits &= bits - 1u;
+        }
+    }
+
+    if (host->slot_tabbed[(size_t)slot] != 0 && count > 0u) {
+        size_t active;
+        size_t i;
+
+        active = out_indices[0];
+        for (i = 0u; i < count; ++i) {
+            if (out_indices[i] == host->slot_active_tab[(size_t)slot]) {
+                active = out_indices[i];
+                break;
+            }
+        }
+        host->slot_active_tab[(size_t)slot] = active;
+        out_indices[0] = active;
+        count = 1u;
+    }
+    return count;
+}
+
+/* Docked panel in a tabbed slot that is not the slot's selected tab. */
+static int fission_nk_panel_host_tab_hidden(const fission_nk_panel_workspace_t *host, size_t index)
+{
+    size_t slot;
+
+    slot = (size_t)FISSION_NK_PANEL_SLOT(host)[index];
+    return (
+        host->slot_tabbed[slot] != 0 &&
+        host->slot_active_tab[slot] != index &&
+        fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), index) == 0
+    );
+}
+
+static void fission_nk_panel_storage_free_block(
+    const fission_nk_panel_storage_t *storage,
+    void *block
+)
+{
+    if (block != NULL) {
+        storage->allocator->free(storage->allocator->userdata, block);
+    }
+}
+
+/*
+ * Grows allocator-backed storage to hold at least capacity entries. Layout of one block:
+ * entries, resolved bounds, layout cache bounds, mask words (visible, detached, live, slot
+ * members, draw snapshot, layout cache docked masks),
+ * layout scratch (size_t), id hashes (uint), id slots (ushort), slot bytes; each section
+ * size keeps the next one aligned.
+ */
+static int fission_nk_panel_storage_reserve(
+    fission_nk_panel_workspace_t *host,
+    size_t capacity
+)
+{
+    fission_nk_panel_storage_t *storage;
+    fission_nk_panel_entry_t *old_entries;
+    fission_nk_panel_bounds_t *old_bounds;
+    fission_nk_panel_mask_word_t *old_visible;
+    fission_nk_panel_mask_word_t *old_detached;
+    fission_nk_panel_mask_word_t *old_live;
+    fission_nk_panel_mask_word_t *old_members;
+    unsigned char *old_slot;
+    size_t old_words;
+    void *old_block;
+    unsigned char *block;
+    size_t new_capacity;
+    size_t mask_words;
+    size_t table_size;
+    size_t block_size;
+    size_t i;
+
+    storage = &host->storage;
+    if (capacity <= storage->capacity) {
+        return 1;
+    }
+    if (capacity > (size_t)FISSION_NK_PANEL_DYNAMIC_MAX_PANELS) {
+        return 0;
+    }
+
+    new_capacity = (storage->capacity > 0u) ? storage->capacity : 16u;
+    while (new_capacity < capacity) {
+        new_capacity *= 2u;
+    }
+    if (new_capacity > (size_t)FISSION_NK_PANEL_DYNAMIC_MAX_PANELS) {
+        new_capacity = (size_t)FISSION_NK_PANEL_DYNAMIC_MAX_PANELS;
+    }
+    table_size = 1u;
+    while (table_size < new_capacity * 2u) {
+        table_size <<= 1u;
+    }
+
+    mask_words = FISSION_NK_PANEL_MASK_WORDS(new_capacity);
+
+    block_size =
+        new_capacity * sizeof(fission_nk_panel_entry_t) +
+        new_capacity * (1u + (size_t)FISSION_NK_PANEL_LAYOUT_CACHE_SIZE) * sizeof(fission_nk_panel_bounds_t) +
+        mask_words * (5u + (size_t)FISSION_NK_PANEL_SLOT_COUNT * (1u + (size_t)FISSION_NK_PANEL_LAYOUT_CACHE_SIZE)) *
+            sizeof(fission_nk_panel_mask_word_t) +
+        new_capacity * (size_t)FISSION_NK_PANEL_SLOT_COUNT * sizeof(size_t) +
+        table_size * sizeof(unsigned int) +
+        table_size * sizeof(unsigned short) +
+        new_capacity;
+    block = (unsigned char *)storage->allocator->alloc(storage->allocator->userdata, NULL, block_size);
+    if (block == NULL) {
+        return 0;
+    }
+    memset(block, 0, block_size);
+
+    old_entries = FISSION_NK_PANEL_ENTRIES(host);
+    old_bounds = FISSION_NK_PANEL_RESOLVED_BOUNDS(host);
+    old_visible = FISSION_NK_PANEL_VISIBLE(host);
+    old_detached = FISSION_NK_PANEL_DETACHED(host);
+    old_live = FISSION_NK_PANEL_LIVE(host);
+    old_slot = FISSION_NK_PANEL_SLOT(host);
+    old_words = fission_nk_panel_host_mask_words(host);
+    old_members = (storage->entries != NULL) ? storage->slot_members : &host->hot.slot_members[0][0];
+
+    old_block = storage->block;
+    storage->block = block;
+    storage->capacity = new_capacity;
+    storage->id_table_size = table_size;
+    storage->entries = (fission_nk_panel_entry_t *)(void *)block;
+    block += new_capacity * sizeof(fission_nk_panel_entry_t);
+    storage->resolved_bounds = (fission_nk_panel_bounds_t *)(void *)block;
+    block += new_capacity * sizeof(fission_nk_panel_bounds_t);
+    storage->layout_cache_bounds = (fission_nk_panel_bounds_t *)(void *)block;
+    block += new_capacity * (size_t)FISSION_NK_PANEL_LAYOUT_CACHE_SIZE * sizeof(fission_nk_panel_bounds_t);
+    storage->visible = (fission_nk_panel_mask_word_t *)(void *)block;
+    storage->detached = storage->visible + mask_words;
+    storage->live = storage->detached + mask_words;
+    storage->slot_members = storage->live + mask_words;
+    storage->draw_scratch = storage->slot_members + mask_words * (size_t)FISSION_NK_PANEL_SLOT_COUNT;
+    storage->layout_cache_docked = storage->draw_scratch + mask_words * 2u;
+    block += mask_words * (5u + (size_t)FISSION_NK_PANEL_SLOT_COUNT * (1u + (size_t)FISSION_NK_PANEL_LAYOUT_CACHE_SIZE)) *
+        sizeof(fission_nk_panel_mask_word_t);
+    storage->layout_scratch = (size_t *)(void *)block;
+    block += new_capacity * (size_t)FISSION_NK_PANEL_SLOT_COUNT * sizeof(size_t);
+    storage->id_hashes = (unsigned int *)(void *)block;
+    block += table_size * sizeof(unsigned int);
+    storage->id_slots = (unsigned short *)(void *)block;
+    block += table_size * sizeof(unsigned short);
+    storage->slot = block;
+
+    if (host->count > 0u) {
+        memcpy(storage->entries, old_entries, host->count * sizeof(fission_nk_panel_entry_t));
+        memcpy(storage->resolved_bounds, old_bounds, host->count * sizeof(fission_nk_panel_bounds_t));
+        memcpy(storage->slot, old_slot, host->count);
+    }
+    memcpy(storage->visible, old_visible, old_words * sizeof(fission_nk_panel_mask_word_t));
+    memcpy(storage->detached, old_detached, old_words * sizeof(fission_nk_panel_mask_word_t));
+    memcpy(storage->live, old_live, old_words * sizeof(fission_nk_panel_mask_word_t));
+    for (i = 0u; i < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++i) {
+        memcpy(
+            storage->slot_members + i * mask_words,
+            old_members + i * old_words,
+            old_words * sizeof(fission_nk_panel_mask_word_t)
+        );
+    }
+    storage->mask_words = mask_words;
+    /* Cached bounds were not carried over. */
+    for (i = 0u; i < (size_t)FISSION_NK_PANEL_LAYOUT_CACHE_SIZE; ++i) {
+        host->layout_cache.entries[i].valid = 0;
+    }
+
+    /* draw_all keeps using the frame's first block as scratch until the frame ends. */
+    if (storage->in_frame != 0 && storage->retired_block == NULL) {
+        storage->retired_block = old_block;
+    } else {
+        fission_nk_panel_storage_free_block(storage, old_block);
     }
 
     for (i = 0u; i < host->count; ++i) {
-        if (strcmp(host->entries[i].desc.id, panel_id) == 0) {
-            return i;
+        if (fission_nk_panel_mask_test(storage->live, i) != 0) {
+            fission_nk_panel_id_table_insert(host, i);
         }
     }
+    return 1;
+}
 
-    return (size_t)FISSION_NK_MAX_PANELS;
+static int fission_nk_panel_host_reserve(
+    fission_nk_panel_workspace_t *host,
+    size_t capacity
+)
+{
+    if (host->storage.allocator != NULL) {
+        return fission_nk_panel_storage_reserve(host, capacity);
+    }
+    return (capacity <= (size_t)FISSION_NK_MAX_PANELS) ? 1 : 0;
+}
+
+static void fission_nk_panel_storage_end_frame(fission_nk_panel_workspace_t *host)
+{
+    host->storage.in_frame = 0;
+    if (host->storage.retired_block != NULL) {
+        fission_nk_panel_storage_free_block(&host->storage, host->storage.retired_block);
+        host->storage.retired_block = NULL;
+    }
+}
+
+static fission_nk_panel_handle_t fission_nk_panel_make_handle(
+    size_t index,
+    unsigned short generation
+)
+{
+    return ((fission_nk_panel_handle_t)generation << 16) | (fission_nk_panel_handle_t)(index + 1u);
+}
+
+static size_t fission_nk_panel_handle_index(
+    const fission_nk_panel_workspace_t *host,
+    fission_nk_panel_handle_t handle
+)
+{
+    size_t index;
+
+    if (host == NULL || (handle & 0xffffu) == 0u) {
+        return FISSION_NK_PANEL_INDEX_NONE;
+    }
+
+    index = (size_t)(handle & 0xffffu) - 1u;
+    if (
+        fission_nk_panel_host_is_live(host, index) == 0 ||
+        FISSION_NK_PANEL_ENTRIES(host)[index].generation != (unsigned short)(handle >> 16)
+    ) {
+        return FISSION_NK_PANEL_INDEX_NONE;
+    }
+    return index;
 }
 
 static fission_nk_panel_bounds_t fission_nk_panel_default_detached_bounds(
@@ -729,8 +1376,9 @@ static float fission_nk_panel_take_extent(float *value, float min_value, float n
     return needed - taken;
 }
 
+/* Writes out_bounds[indices[i]], or out_bounds[i] when indices is NULL. */
 static void fission_nk_panel_layout_stack_vertical(
-    fission_nk_panel_workspace_t *host,
+    fission_nk_panel_bounds_t *out_bounds,
     const size_t *indices,
     size_t count,
     float x,
@@ -745,8 +1393,7 @@ static void fission_nk_panel_layout_stack_vertical(
     size_t i;
 
     if (
-        host == NULL ||
-        indices == NULL ||
+        out_bounds == NULL ||
         count == 0u ||
         w <= 0.0f ||
         h <= 0.0f
@@ -766,20 +1413,20 @@ static void fission_nk_panel_layout_stack_vertical(
 
     cursor_y = y;
     for (i = 0u; i < count; ++i) {
-        fission_nk_panel_state_t *state;
+        fission_nk_panel_bounds_t *bounds;
 
-        state = &host->entries[indices[i]].state;
-        state->resolved_bounds.x = x;
-        state->resolved_bounds.y = cursor_y;
-        state->resolved_bounds.w = w;
-        state->resolved_bounds.h = panel_height;
+        bounds = &out_bounds[(indices != NULL) ? indices[i] : i];
+        bounds->x = x;
+        bounds->y = cursor_y;
+        bounds->w = w;
+        bounds->h = panel_height;
 
         cursor_y += panel_height + FISSION_NK_PANEL_GAP;
     }
 }
 
 static void fission_nk_panel_layout_stack_horizontal(
-    fission_nk_panel_workspace_t *host,
+    fission_nk_panel_bounds_t *out_bounds,
     const size_t *indices,
     size_t count,
     float x,
@@ -794,8 +1441,7 @@ static void fission_nk_panel_layout_stack_horizontal(
     size_t i;
 
     if (
-        host == NULL ||
-        indices == NULL ||
+        out_bounds == NULL ||
         count == 0u ||
         w <= 0.0f ||
         h <= 0.0f
@@ -815,13 +1461,13 @@ static void fission_nk_panel_layout_stack_horizontal(
 
     cursor_x = x;
     for (i = 0u; i < count; ++i) {
-        fission_nk_panel_state_t *state;
+        fission_nk_panel_bounds_t *bounds;
 
-        state = &host->entries[indices[i]].state;
-        state->resolved_bounds.x = cursor_x;
-        state->resolved_bounds.y = y;
-        state->resolved_bounds.w = panel_width;
-        state->resolved_bounds.h = h;
+        bounds = &out_bounds[(indices != NULL) ? indices[i] : i];
+        bounds->x = cursor_x;
+        bounds->y = y;
+        bounds->w = panel_width;
+        bounds->h = h;
         cursor_x += panel_width + FISSION_NK_PANEL_GAP;
     }
 }
@@ -888,31 +1534,40 @@ static fission_nk_dock_zone_t fission_nk_panel_dock_zone_from_slot(
     return FISSION_NK_DOCK_ZONE_CENTER;
 }
 
-static int fission_nk_panel_host_resolve_layout(
-    fission_nk_panel_workspace_t *host,
-    int window_width,
-    int window_height
+/* Floating panels take their (window-clamped) detached bounds. */
+static void fission_nk_panel_host_resolve_detached(fission_nk_panel_workspace_t *host)
+{
+    const fission_nk_panel_mask_word_t *visible;
+    const fission_nk_panel_mask_word_t *detached;
+    size_t mask_words;
+    size_t w;
+
+    visible = FISSION_NK_PANEL_VISIBLE(host);
+    detached = FISSION_NK_PANEL_DETACHED(host);
+    mask_words = fission_nk_panel_host_mask_words(host);
+    for (w = 0u; w < mask_words; ++w) {
+        fission_nk_panel_mask_word_t bits;
+
+        bits = visible[w] & detached[w];
+        while (bits != 0u) {
+            fission_nk_panel_entry_t *entry;
+            size_t i;
+
+            i = w * FISSION_NK_PANEL_MASK_WORD_BITS + fission_nk_panel_mask_lowest(bits);
+            bits &= bits - 1u;
+            entry = &FISSION_NK_PANEL_ENTRIES(host)[i];
+            fission_nk_panel_sanitize_detached_bounds(host, &entry->state.detached_bounds);
+            FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[i] = entry->state.detached_bounds;
+        }
+    }
+}
+
+/* Band heights, column widths and corner ownership; panel stacking within a slot is separate. */
+static void fission_nk_panel_layout_solve_slots(
+    const fission_nk_panel_layout_input_t *input,
+    fission_nk_panel_layout_result_t *out_result
 )
 {
-    size_t top_left_indices[FISSION_NK_MAX_PANELS];
-    size_t top_indices[FISSION_NK_MAX_PANELS];
-    size_t top_right_indices[FISSION_NK_MAX_PANELS];
-    size_t left_indices[FISSION_NK_MAX_PANELS];
-    size_t center_indices[FISSION_NK_MAX_PANELS];
-    size_t right_indices[FISSION_NK_MAX_PANELS];
-    size_t bottom_left_indices[FISSION_NK_MAX_PANELS];
-    size_t bottom_indices[FISSION_NK_MAX_PANELS];
-    size_t bottom_right_indices[FISSION_NK_MAX_PANELS];
-    size_t top_left_count;
-    size_t top_count;
-    size_t top_right_count;
-    size_t left_count;
-    size_t center_count;
-    size_t right_count;
-    size_t bottom_left_count;
-    size_t bottom_count;
-    size_t bottom_right_count;
-    size_t i;
     int has_top_left;
     int has_top;
     int has_top_right;
@@ -994,95 +1649,32 @@ static int fission_nk_panel_host_resolve_layout(
     int expand_bottom_left_into_center;
     int expand_bottom_right_into_center;
 
-    if (host == NULL) {
-        return 0;
-    }
-
-    host->last_window_width = window_width;
-    host->last_window_height = window_height;
-    fission_nk_panel_bounds_zero(&host->splitter_left_bounds);
-    fission_nk_panel_bounds_zero(&host->splitter_right_bounds);
-    fission_nk_panel_bounds_zero(&host->splitter_top_bounds);
-    fission_nk_panel_bounds_zero(&host->splitter_bottom_bounds);
+    memset(out_result, 0, sizeof(*out_result));
 
     content_x = FISSION_NK_PANEL_MARGIN;
     content_y = FISSION_NK_PANEL_MARGIN + FISSION_NK_PANEL_TOP_RESERVED;
-    content_w = (float)window_width - FISSION_NK_PANEL_MARGIN * 2.0f;
-    content_h = (float)window_height - FISSION_NK_PANEL_MARGIN - content_y;
+    content_w = (float)input->window_width - FISSION_NK_PANEL_MARGIN * 2.0f;
+    content_h = (float)input->window_height - FISSION_NK_PANEL_MARGIN - content_y;
     if (content_w < 1.0f) {
         content_w = 1.0f;
     }
     if (content_h < 1.0f) {
         content_h = 1.0f;
     }
-    host->dock_workspace_bounds.x = content_x;
-    host->dock_workspace_bounds.y = content_y;
-    host->dock_workspace_bounds.w = content_w;
-    host->dock_workspace_bounds.h = content_h;
-
-    top_left_count = 0u;
-    top_count = 0u;
-    top_right_count = 0u;
-    left_count = 0u;
-    center_count = 0u;
-    right_count = 0u;
-    bottom_left_count = 0u;
-    bottom_count = 0u;
-    bottom_right_count = 0u;
-
-    for (i = 0u; i < host->count; ++i) {
-        fission_nk_panel_entry_t *entry;
-
-        entry = &host->entries[i];
-        if (entry->state.visible == 0) {
-            continue;
-        }
-
-        if (entry->state.detached != 0) {
-            fission_nk_panel_sanitize_detached_bounds(host, &entry->state.detached_bounds);
-            entry->state.resolved_bounds = entry->state.detached_bounds;
-            continue;
-        }
-
-        if (entry->state.slot == FISSION_NK_PANEL_SLOT_TOP_LEFT) {
-            top_left_indices[top_left_count] = i;
-            top_left_count += 1u;
-        } else if (entry->state.slot == FISSION_NK_PANEL_SLOT_TOP) {
-            top_indices[top_count] = i;
-            top_count += 1u;
-        } else if (entry->state.slot == FISSION_NK_PANEL_SLOT_TOP_RIGHT) {
-            top_right_indices[top_right_count] = i;
-            top_right_count += 1u;
-        } else if (entry->state.slot == FISSION_NK_PANEL_SLOT_LEFT) {
-            left_indices[left_count] = i;
-            left_count += 1u;
-        } else if (entry->state.slot == FISSION_NK_PANEL_SLOT_RIGHT) {
-            right_indices[right_count] = i;
-            right_count += 1u;
-        } else if (entry->state.slot == FISSION_NK_PANEL_SLOT_BOTTOM_LEFT) {
-            bottom_left_indices[bottom_left_count] = i;
-            bottom_left_count += 1u;
-        } else if (entry->state.slot == FISSION_NK_PANEL_SLOT_BOTTOM) {
-            bottom_indices[bottom_count] = i;
-            bottom_count += 1u;
-        } else if (entry->state.slot == FISSION_NK_PANEL_SLOT_BOTTOM_RIGHT) {
-            bottom_right_indices[bottom_right_count] = i;
-            bottom_right_count += 1u;
-        } else {
-            center_indices[center_count] = i;
-            center_count += 1u;
-        }
-    }
-
-    has_top_left = (top_left_count > 0u);
-    has_top = (top_count > 0u);
-    has_top_right = (top_right_count > 0u);
-    has_left = (left_count > 0u);
-    has_center = (center_count > 0u);
-    has_right = (right_count > 0u);
-    has_bottom_left = (bottom_left_count > 0u);
-    has_bottom = (bottom_count > 0u);
-    has_bottom_right = (bottom_right_count > 0u);
+    out_result->dock_workspace_bounds.x = content_x;
+    out_result->dock_workspace_bounds.y = content_y;
+    out_result->dock_workspace_bounds.w = content_w;
+    out_result->dock_workspace_bounds.h = content_h;
+
+    has_top_left = (input->slot_counts[(size_t)FISSION_NK_PANEL_SLOT_TOP_LEFT] > 0u);
+    has_top = (input->slot_counts[(size_t)FISSION_NK_PANEL_SLOT_TOP] > 0u);
+    has_top_right = (input->slot_counts[(size_t)FISSION_NK_PANEL_SLOT_TOP_RIGHT] > 0u);
+    has_left = (input->slot_counts[(size_t)FISSION_NK_PANEL_SLOT_LEFT] > 0u);
+    has_center = (input->slot_counts[(size_t)FISSION_NK_PANEL_SLOT_CENTER] > 0u);
+    has_right = (input->slot_counts[(size_t)FISSION_NK_PANEL_SLOT_RIGHT] > 0u);
+    has_bottom_left = (input->slot_counts[(size_t)FISSION_NK_PANEL_SLOT_BOTTOM_LEFT] > 0u);
+    has_bottom = (input->slot_counts[(size_t)FISSION_NK_PANEL_SLOT_BOTTOM] > 0u);
+    has_bottom_right = (input->slot_counts[(size_t)FISSION_NK_PANEL_SLOT_BOTTOM_RIGHT] > 0u);
     has_top_band = (has_top_left != 0 || has_top != 0 || has_top_right != 0);
     has_bottom_band = (has_bottom_left != 0 || has_bottom != 0 || has_bottom_right != 0);
     has_mid = (has_left != 0 || has_center != 0 || has_right != 0);
@@ -1108,23 +1700,23 @@ static int fission_nk_panel_host_resolve_layout(
     bottom_h = 0.0f;
 
     if (has_top_band != 0 && has_mid != 0 && has_bottom_band != 0) {
-        top_h = shared_h * host->top_row_ratio;
-        bottom_h = shared_h * host->bottom_row_ratio;
+        top_h = shared_h * input->top_row_ratio;
+        bottom_h = shared_h * input->bottom_row_ratio;
         mid_h = shared_h - top_h - bottom_h;
     } else if (has_top_band != 0 && has_mid != 0) {
-        top_h = shared_h * host->top_row_ratio;
+        top_h = shared_h * input->top_row_ratio;
         mid_h = shared_h - top_h;
     } else if (has_mid != 0 && has_bottom_band != 0) {
-        bottom_h = shared_h * host->bottom_row_ratio;
+        bottom_h = shared_h * input->bottom_row_ratio;
         mid_h = shared_h - bottom_h;
     } else if (has_top_band != 0 && has_bottom_band != 0) {
         float ratio_sum;
 
-        ratio_sum = host->top_row_ratio + host->bottom_row_ratio;
+        ratio_sum = input->top_row_ratio + input->bottom_row_ratio;
         if (ratio_sum <= 0.001f) {
             ratio_sum = 1.0f;
         }
-        top_h = shared_h * (host->top_row_ratio / ratio_sum);
+        top_h = shared_h * (input->top_row_ratio / ratio_sum);
         bottom_h = shared_h - top_h;
     } else if (has_top_band != 0) {
         top_h = shared_h;
@@ -1176,10 +1768,10 @@ static int fission_nk_panel_host_resolve_layout(
         top_y = cursor_y;
         cursor_y += top_h;
         if (has_mid != 0 || has_bottom_band != 0) {
-            host->splitter_top_bounds.x = content_x;
-            host->splitter_top_bounds.y = cursor_y;
-            host->splitter_top_bounds.w = content_w;
-            host->splitter_top_bounds.h = FISSION_NK_PANEL_GAP;
+            out_result->splitter_top_bounds.x = content_x;
+            out_result->splitter_top_bounds.y = cursor_y;
+            out_result->splitter_top_bounds.w = content_w;
+            out_result->splitter_top_bounds.h = FISSION_NK_PANEL_GAP;
             cursor_y += FISSION_NK_PANEL_GAP;
         }
     }
@@ -1187,10 +1779,10 @@ static int fission_nk_panel_host_resolve_layout(
         mid_y = cursor_y;
         cursor_y += mid_h;
         if (has_bottom_band != 0) {
-            host->splitter_bottom_bounds.x = content_x;
-            host->splitter_bottom_bounds.y = cursor_y;
-            host->splitter_bottom_bounds.w = content_w;
-            host->splitter_bottom_bounds.h = FISSION_NK_PANEL_GAP;
+            out_result->splitter_bottom_bounds.x = content_x;
+            out_result->splitter_bottom_bounds.y = cursor_y;
+            out_result->splitter_bottom_bounds.w = content_w;
+            out_result->splitter_bottom_bounds.h = FISSION_NK_PANEL_GAP;
             cursor_y += FISSION_NK_PANEL_GAP;
         }
     }
@@ -1216,23 +1808,23 @@ static int fission_nk_panel_host_resolve_layout(
     right_w = 0.0f;
 
     if (has_left_side != 0 && has_center_side != 0 && has_right_side != 0) {
-        left_w = shared_w * host->left_column_ratio;
-        right_w = shared_w * host->right_column_ratio;
+        left_w = shared_w * input->left_column_ratio;
+        right_w = shared_w * input->right_column_ratio;
         center_w = shared_w - left_w - right_w;
     } else if (has_left_side != 0 && has_center_side != 0) {
-        left_w = shared_w * host->left_column_ratio;
+        left_w = shared_w * input->left_column_ratio;
         center_w = shared_w - left_w;
     } else if (has_center_side != 0 && has_right_side != 0) {
-        right_w = shared_w * host->right_column_ratio;
+        right_w = shared_w * input->right_column_ratio;
         center_w = shared_w - right_w;
     } else if (has_left_side != 0 && has_right_side != 0) {
         float ratio_sum;
 
-        ratio_sum = host->left_column_ratio + host->right_column_ratio;
+        ratio_sum = input->left_column_ratio + input->right_column_ratio;
         if (ratio_sum <= 0.001f) {
             ratio_sum = 1.0f;
         }
-        left_w = shared_w * (host->left_column_ratio / ratio_sum);
+        left_w = shared_w * (input->left_column_ratio / ratio_sum);
         right_w = shared_w - left_w;
     } else if (has_left_side != 0) {
         left_w = shared_w;
@@ -1303,16 +1895,16 @@ static int fission_nk_panel_host_resolve_layout(
     }
 
     if (has_mid != 0 && has_left_side != 0 && (has_center_side != 0 || has_right_side != 0)) {
-        host->splitter_left_bounds.x = left_splitter_x;
-        host->splitter_left_bounds.y = mid_y;
-        host->splitter_left_bounds.w = FISSION_NK_PANEL_GAP;
-        host->splitter_left_bounds.h = mid_h;
+        out_result->splitter_left_bounds.x = left_splitter_x;
+        out_result->splitter_left_bounds.y = mid_y;
+        out_result->splitter_left_bounds.w = FISSION_NK_PANEL_GAP;
+        out_result->splitter_left_bounds.h = mid_h;
     }
     if (has_mid != 0 && has_center_side != 0 && has_right_side != 0) {
-        host->splitter_right_bounds.x = right_splitter_x;
-        host->splitter_right_bounds.y = mid_y;
-        host->splitter_right_bounds.w = FISSION_NK_PANEL_GAP;
-        host->splitter_right_bounds.h = mid_h;
+        out_result->splitter_right_bounds.x = right_splitter_x;
+        out_result->splitter_right_bounds.y = mid_y;
+        out_result->splitter_right_bounds.w = FISSION_NK_PANEL_GAP;
+        out_result->splitter_right_bounds.h = mid_h;
     }
 
     top_band_start_y = top_y;
@@ -1358,8 +1950,8 @@ static int fission_nk_panel_host_resolve_layout(
         has_top_left,
         has_left,
         has_top,
-        host->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_LEFT],
-        host->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_TOP],
+        input->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_LEFT],
+        input->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_TOP],
         FISSION_NK_CORNER_OWNER_LEFT,
         FISSION_NK_CORNER_OWNER_TOP
     );
@@ -1367,8 +1959,8 @@ static int fission_nk_panel_host_resolve_layout(
         has_top_right,
         has_right,
         has_top,
-        host->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_RIGHT],
-        host->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_TOP],
+        input->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_RIGHT],
+        input->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_TOP],
         FISSION_NK_CORNER_OWNER_RIGHT,
         FISSION_NK_CORNER_OWNER_TOP
     );
@@ -1376,8 +1968,8 @@ static int fission_nk_panel_host_resolve_layout(
         has_bottom_left,
         has_left,
         has_bottom,
-        host->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_LEFT],
-        host->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_BOTTOM],
+        input->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_LEFT],
+        input->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_BOTTOM],
         FISSION_NK_CORNER_OWNER_LEFT,
         FISSION_NK_CORNER_OWNER_BOTTOM
     );
@@ -1385,8 +1977,8 @@ static int fission_nk_panel_host_resolve_layout(
         has_bottom_right,
         has_right,
         has_bottom,
-        host->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_RIGHT],
-        host->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_BOTTOM],
+        input->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_RIGHT],
+        input->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_BOTTOM],
         FISSION_NK_CORNER_OWNER_RIGHT,
         FISSION_NK_CORNER_OWNER_BOTTOM
     );
@@ -1397,8 +1989,8 @@ static int fission_nk_panel_host_resolve_layout(
     if (has_top_band != 0 && has_top == 0 && has_center == 0) {
         if (has_top_left != 0 && has_top_right != 0) {
             if (
-                host->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_TOP_LEFT] >=
-                host->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_TOP_RIGHT]
+                input->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_TOP_LEFT] >=
+                input->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_TOP_RIGHT]
             ) {
                 expand_top_left_into_center = 1;
             } else {
@@ -1413,8 +2005,8 @@ static int fission_nk_panel_host_resolve_layout(
     if (has_bottom_band != 0 && has_bottom == 0 && has_center == 0) {
         if (has_bottom_left != 0 && has_bottom_right != 0) {
             if (
-                host->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_BOTTOM_LEFT] >=
-                host->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_BOTTOM_RIGHT]
+                input->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_BOTTOM_LEFT] >=
+                input->slot_touch_serial[(size_t)FISSION_NK_PANEL_SLOT_BOTTOM_RIGHT]
             ) {
                 expand_bottom_left_into_center = 1;
             } else {
@@ -1437,10 +2029,8 @@ static int fission_nk_panel_host_resolve_layout(
             if ((top_left_panel_x1 - top_left_panel_x0) < 1.0f) {
                 top_left_panel_x1 = top_left_panel_x0 + 1.0f;
             }
-            fission_nk_panel_layout_stack_vertical(
-                host,
-                top_left_indices,
-                top_left_count,
+            fission_nk_panel_bounds_set(
+                &out_result->slot_bounds[(size_t)FISSION_NK_PANEL_SLOT_TOP_LEFT],
                 top_left_panel_x0,
                 top_y,
                 top_left_panel_x1 - top_left_panel_x0,
@@ -1456,10 +2046,8 @@ static int fission_nk_panel_host_resolve_layout(
             if ((top_right_panel_x1 - top_right_panel_x0) < 1.0f) {
                 top_right_panel_x1 = top_right_panel_x0 + 1.0f;
             }
-            fission_nk_panel_layout_stack_vertical(
-                host,
-                top_right_indices,
-                top_right_count,
+            fission_nk_panel_bounds_set(
+                &out_result->slot_bounds[(size_t)FISSION_NK_PANEL_SLOT_TOP_RIGHT],
                 top_right_panel_x0,
                 top_y,
                 top_right_panel_x1 - top_right_panel_x0,
@@ -1478,10 +2066,8 @@ static int fission_nk_panel_host_resolve_layout(
             if ((top_panel_x1 - top_panel_x0) < 1.0f) {
                 top_panel_x1 = top_panel_x0 + 1.0f;
             }
-            fission_nk_panel_layout_stack_horizontal(
-                host,
-                top_indices,
-                top_count,
+            fission_nk_panel_bounds_set(
+                &out_result->slot_bounds[(size_t)FISSION_NK_PANEL_SLOT_TOP],
                 top_panel_x0,
                 top_y,
                 top_panel_x1 - top_panel_x0,
@@ -1499,10 +2085,8 @@ static int fission_nk_panel_host_resolve_layout(
             if ((bottom_left_panel_x1 - bottom_left_panel_x0) < 1.0f) {
                 bottom_left_panel_x1 = bottom_left_panel_x0 + 1.0f;
             }
-            fission_nk_panel_layout_stack_vertical(
-                host,
-                bottom_left_indices,
-                bottom_left_count,
+            fission_nk_panel_bounds_set(
+                &out_result->slot_bounds[(size_t)FISSION_NK_PANEL_SLOT_BOTTOM_LEFT],
                 bottom_left_panel_x0,
                 bottom_y,
                 bottom_left_panel_x1 - bottom_left_panel_x0,
@@ -1518,10 +2102,8 @@ static int fission_nk_panel_host_resolve_layout(
             if ((bottom_right_panel_x1 - bottom_right_panel_x0) < 1.0f) {
                 bottom_right_panel_x1 = bottom_right_panel_x0 + 1.0f;
             }
-            fission_nk_panel_layout_stack_vertical(
-                host,
-                bottom_right_indices,
-                bottom_right_count,
+            fission_nk_panel_bounds_set(
+                &out_result->slot_bounds[(size_t)FISSION_NK_PANEL_SLOT_BOTTOM_RIGHT],
                 bottom_right_panel_x0,
                 bottom_y,
                 bottom_right_panel_x1 - bottom_right_panel_x0,
@@ -1540,10 +2122,8 @@ static int fission_nk_panel_host_resolve_layout(
             if ((bottom_panel_x1 - bottom_panel_x0) < 1.0f) {
                 bottom_panel_x1 = bottom_panel_x0 + 1.0f;
             }
-            fission_nk_panel_layout_stack_horizontal(
-                host,
-                bottom_indices,
-                bottom_count,
+            fission_nk_panel_bounds_set(
+                &out_result->slot_bounds[(size_t)FISSION_NK_PANEL_SLOT_BOTTOM],
                 bottom_panel_x0,
                 bottom_y,
                 bottom_panel_x1 - bottom_panel_x0,
@@ -1553,7 +2133,7 @@ static int fission_nk_panel_host_resolve_layout(
     }
 
     if (has_mid == 0) {
-        return 1;
+        return;
     }
 
     if (has_left != 0) {
@@ -1568,10 +2148,8 @@ static int fission_nk_panel_host_resolve_layout(
         if ((left_panel_y1 - left_panel_y0) < 1.0f) {
             left_panel_y1 = left_panel_y0 + 1.0f;
         }
-        fission_nk_panel_layout_stack_vertical(
-            host,
-            left_indices,
-            left_count,
+        fission_nk_panel_bounds_set(
+            &out_result->slot_bounds[(size_t)FISSION_NK_PANEL_SLOT_LEFT],
             left_x,
             left_panel_y0,
             left_w,
@@ -1590,10 +2168,8 @@ static int fission_nk_panel_host_resolve_layout(
         if ((center_panel_y1 - center_panel_y0) < 1.0f) {
             center_panel_y1 = center_panel_y0 + 1.0f;
         }
-        fission_nk_panel_layout_stack_vertical(
-            host,
-            center_indices,
-            center_count,
+        fission_nk_panel_bounds_set(
+            &out_result->slot_bounds[(size_t)FISSION_NK_PANEL_SLOT_CENTER],
             center_x,
             center_panel_y0,
             center_w,
@@ -1612,20 +2188,594 @@ static int fission_nk_panel_host_resolve_layout(
         if ((right_panel_y1 - right_panel_y0) < 1.0f) {
             right_panel_y1 = right_panel_y0 + 1.0f;
         }
-        fission_nk_panel_layout_stack_vertical(
-            host,
-            right_indices,
-            right_count,
+        fission_nk_panel_bounds_set(
+            &out_result->slot_bounds[(size_t)FISSION_NK_PANEL_SLOT_RIGHT],
             right_x,
             right_panel_y0,
             right_w,
             right_panel_y1 - right_panel_y0
         );
     }
+}
+
+static void fission_nk_panel_layout_stack_slot(
+    fission_nk_panel_slot_t slot,
+    const fission_nk_panel_bounds_t *slot_bounds,
+    const size_t *indices,
+    size_t count,
+    fission_nk_panel_bounds_t *out_bounds
+)
+{
+    if (slot == FISSION_NK_PANEL_SLOT_TOP || slot == FISSION_NK_PANEL_SLOT_BOTTOM) {
+        fission_nk_panel_layout_stack_horizontal(
+            out_bounds,
+            indices,
+            count,
+            slot_bounds->x,
+            slot_bounds->y,
+            slot_bounds->w,
+            slot_bounds->h
+        );
+        return;
+    }
+    fission_nk_panel_layout_stack_vertical(
+        out_bounds,
+        indices,
+        count,
+        slot_bounds->x,
+        slot_bounds->y,
+        slot_bounds->w,
+        slot_bounds->h
+    );
+}
+
+fission_nk_panel_status_t fission_nk_panel_layout_solve(
+    const fission_nk_panel_layout_input_t *input,
+    fission_nk_panel_layout_result_t *out_result,
+    fission_nk_panel_bounds_t *out_panel_bounds
+)
+{
+    size_t offset;
+    size_t slot;
+
+    if (input == NULL || out_result == NULL) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    fission_nk_panel_layout_solve_slots(input, out_result);
+    if (out_panel_bounds == NULL) {
+        return FISSION_NK_PANEL_STATUS_OK;
+    }
+
+    offset = 0u;
+    for (slot = 0u; slot < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++slot) {
+        fission_nk_panel_layout_stack_slot(
+            (fission_nk_panel_slot_t)slot,
+            &out_result->slot_bounds[slot],
+            NULL,
+            input->slot_counts[slot],
+            out_panel_bounds + offset
+        );
+        offset += input->slot_counts[slot];
+    }
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+static void fission_nk_panel_host_layout_input(
+    const fission_nk_panel_workspace_t *host,
+    int window_width,
+    int window_height,
+    fission_nk_panel_layout_input_t *out_input
+)
+{
+    memset(out_input, 0, sizeof(*out_input));
+    out_input->window_width = window_width;
+    out_input->window_height = window_height;
+    out_input->left_column_ratio = host->left_column_ratio;
+    out_input->right_column_ratio = host->right_column_ratio;
+    out_input->top_row_ratio = host->top_row_ratio;
+    out_input->bottom_row_ratio = host->bottom_row_ratio;
+    memcpy(out_input->slot_touch_serial, host->slot_touch_serial, sizeof(out_input->slot_touch_serial));
+}
+
+/*
+ * Dock tree mode: slot leaves follow whether their slot has docked panels, the tree is laid
+ * out over the dock area, and each slot takes its leaf's bounds. The grid's splitters give
+ * way to the tree's.
+ */
+static void fission_nk_panel_host_resolve_dock_tree(
+    fission_nk_panel_workspace_t *host,
+    const size_t slot_counts[FISSION_NK_PANEL_SLOT_COUNT],
+    fission_nk_panel_layout_result_t *result
+)
+{
+    fission_nk_dock_tree_t *tree;
+    size_t i;
+
+    tree = host->dock_tree;
+    for (i = 0u; i < tree->node_count; ++i) {
+        if (
+            tree->nodes[i].kind == (unsigned char)FISSION_NK_DOCK_NODE_LEAF &&
+            fission_nk_panel_slot_is_valid((fission_nk_panel_slot_t)tree->nodes[i].tag) != 0
+        ) {
+            (void)fission_nk_dock_tree_set_occupied(tree, i, slot_counts[tree->nodes[i].tag] > 0u);
+        }
+    }
+    fission_nk_dock_tree_resolve(tree, &result->dock_workspace_bounds);
+
+    memset(result->slot_bounds, 0, sizeof(result->slot_bounds));
+    fission_nk_panel_bounds_zero(&result->splitter_left_bounds);
+    fission_nk_panel_bounds_zero(&result->splitter_right_bounds);
+    fission_nk_panel_bounds_zero(&result->splitter_top_bounds);
+    fission_nk_panel_bounds_zero(&result->splitter_bottom_bounds);
+    for (i = 0u; i < tree->node_count; ++i) {
+        if (
+            tree->nodes[i].kind == (unsigned char)FISSION_NK_DOCK_NODE_LEAF &&
+            tree->nodes[i].occupied != 0u &&
+            fission_nk_panel_slot_is_valid((fission_nk_panel_slot_t)tree->nodes[i].tag) != 0
+        ) {
+            result->slot_bounds[tree->nodes[i].tag] = tree->nodes[i].bounds;
+        }
+    }
+}
+
+static int fission_nk_panel_host_resolve_layout(
+    fission_nk_panel_workspace_t *host,
+    int window_width,
+    int window_height
+)
+{
+    size_t inline_indices[FISSION_NK_PANEL_SLOT_COUNT * FISSION_NK_MAX_PANELS];
+    fission_nk_panel_layout_input_t input;
+    fission_nk_panel_layout_result_t result;
+    size_t *slot_indices;
+    size_t slot_stride;
+    size_t slot;
+
+    if (host == NULL) {
+        return 0;
+    }
+
+    if (host->storage.entries != NULL) {
+        slot_indices = host->storage.layout_scratch;
+        slot_stride = host->storage.capacity;
+    } else {
+        slot_indices = inline_indices;
+        slot_stride = (size_t)FISSION_NK_MAX_PANELS;
+    }
+
+    fission_nk_panel_host_layout_input(host, window_width, window_height, &input);
+    for (slot = 0u; slot < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++slot) {
+        input.slot_counts[slot] = fission_nk_panel_host_collect_slot(
+            host,
+            (fission_nk_panel_slot_t)slot,
+            slot_indices + slot * slot_stride
+        );
+    }
+    (void)fission_nk_panel_layout_solve(&input, &result, NULL);
+    if (host->dock_tree != NULL) {
+        fission_nk_panel_host_resolve_dock_tree(host, input.slot_counts, &result);
+    }
+
+    host->last_window_width = window_width;
+    host->last_window_height = window_height;
+    host->dock_workspace_bounds = result.dock_workspace_bounds;
+    host->splitter_left_bounds = result.splitter_left_bounds;
+    host->splitter_right_bounds = result.splitter_right_bounds;
+    host->splitter_top_bounds = result.splitter_top_bounds;
+    host->splitter_bottom_bounds = result.splitter_bottom_bounds;
+
+    fission_nk_panel_host_resolve_detached(host);
+    for (slot = 0u; slot < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++slot) {
+        fission_nk_panel_layout_stack_slot(
+            (fission_nk_panel_slot_t)slot,
+            &result.slot_bounds[slot],
+            slot_indices + slot * slot_stride,
+            input.slot_counts[slot],
+            FISSION_NK_PANEL_RESOLVED_BOUNDS(host)
+        );
+    }
+    return 1;
+}
+
+/*
+ * The resolver sized each tabbed slot for its selected panel alone; carve the tab strip off
+ * the top and give every panel in the stack the rest.
+ */
+static void fission_nk_panel_host_layout_tab_stacks(fission_nk_panel_workspace_t *host)
+{
+    const fission_nk_panel_mask_word_t *visible;
+    const fission_nk_panel_mask_word_t *detached;
+    size_t mask_words;
+    size_t slot;
+
+    visible = FISSION_NK_PANEL_VISIBLE(host);
+    detached = FISSION_NK_PANEL_DETACHED(host);
+    mask_words = fission_nk_panel_host_mask_words(host);
+    for (slot = 0u; slot < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++slot) {
+        const fission_nk_panel_mask_word_t *members;
+        fission_nk_panel_bounds_t *strip;
+        fission_nk_panel_bounds_t bounds;
+        size_t active;
+        size_t w;
+
+        strip = &host->slot_tab_strip_bounds[slot];
+        fission_nk_panel_bounds_zero(strip);
+        active = host->slot_active_tab[slot];
+        if (
+            host->slot_tabbed[slot] == 0 ||
+            fission_nk_panel_host_is_live(host, active) == 0 ||
+            fission_nk_panel_mask_test(visible, active) == 0 ||
+            fission_nk_panel_mask_test(detached, active) != 0 ||
+            (size_t)FISSION_NK_PANEL_SLOT(host)[active] != slot
+        ) {
+            continue;
+        }
+
+        bounds = FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[active];
+        *strip = bounds;
+        strip->h = (bounds.h > FISSION_NK_PANEL_TAB_STRIP_HEIGHT) ? FISSION_NK_PANEL_TAB_STRIP_HEIGHT : bounds.h;
+        bounds.y += strip->h;
+        bounds.h -= strip->h;
+
+        members = FISSION_NK_PANEL_SLOT_MEMBERS(host, slot);
+        for (w = 0u; w < mask_words; ++w) {
+            fission_nk_panel_mask_word_t bits;
+
+            bits = visible[w] & ~detached[w] & members[w];
+            while (bits != 0u) {
+                FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[
+                    w * FISSION_NK_PANEL_MASK_WORD_BITS + fission_nk_panel_mask_lowest(bits)
+                ] = bounds;
+                bits &= bits - 1u;
+            }
+        }
+    }
+}
+
+static unsigned long long fission_nk_panel_layout_key_mix(unsigned long long hash, unsigned long long value)
+{
+    hash ^= value;
+    hash *= 1099511628211ull;
+    return hash ^ (hash >> 32);
+}
+
+/* Everything resolve reads except the detached bounds, which are re-applied on a hit. */
+static void fission_nk_panel_host_layout_key(
+    const fission_nk_panel_workspace_t *host,
+    int window_width,
+    int window_height,
+    fission_nk_panel_layout_cache_entry_t *out_key
+)
+{
+    const fission_nk_panel_mask_word_t *visible;
+    const fission_nk_panel_mask_word_t *detached;
+    unsigned long long hash;
+    size_t mask_words;
+    size_t slot;
+    size_t w;
+
+    memset(out_key, 0, sizeof(*out_key));
+    out_key->window_width = window_width;
+    out_key->window_height = window_height;
+    out_key->ratios[0] = host->left_column_ratio;
+    out_key->ratios[1] = host->right_column_ratio;
+    out_key->ratios[2] = host->top_row_ratio;
+    out_key->ratios[3] = host->bottom_row_ratio;
+    /* Corner ownership only compares touch serials, so their ranks are enough. */
+    for (slot = 0u; slot < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++slot) {
+        size_t other;
+
+        for (other = 0u; other < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++other) {
+            if (host->slot_touch_serial[other] < host->slot_touch_serial[slot]) {
+                out_key->slot_rank[slot] += 1u;
+            }
+        }
+    }
+
+    hash = 14695981039346656037ull;
+    visible = FISSION_NK_PANEL_VISIBLE(host);
+    detached = FISSION_NK_PANEL_DETACHED(host);
+    mask_words = fission_nk_panel_host_mask_words(host);
+    for (slot = 0u; slot < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++slot) {
+        const fission_nk_panel_mask_word_t *members;
+
+        members = FISSION_NK_PANEL_SLOT_MEMBERS(host, slot);
+        for (w = 0u; w < mask_words; ++w) {
+            hash = fission_nk_panel_layout_key_mix(hash, (unsigned long long)(visible[w] & ~detached[w] & members[w]));
+        }
+        if (host->slot_tabbed[slot] != 0) {
+            out_key->slot_tabbed[slot] = 1u;
+            out_key->tab_selection[slot] = host->slot_active_tab[slot];
+            hash = fission_nk_panel_layout_key_mix(hash, (unsigned long long)slot + 1u);
+            hash = fission_nk_panel_layout_key_mix(hash, (unsigned long long)host->slot_active_tab[slot]);
+        }
+    }
+    out_key->config_hash = hash;
+}
+
+/* Compares an entry's stored per-slot docked masks against the workspace's current ones. */
+static int fission_nk_panel_host_layout_cache_docked_matches(
+    const fission_nk_panel_workspace_t *host,
+    size_t index
+)
+{
+    const fission_nk_panel_mask_word_t *visible;
+    const fission_nk_panel_mask_word_t *detached;
+    size_t mask_words;
+    size_t slot;
+    size_t w;
+
+    visible = FISSION_NK_PANEL_VISIBLE(host);
+    detached = FISSION_NK_PANEL_DETACHED(host);
+    mask_words = fission_nk_panel_host_mask_words(host);
+    for (slot = 0u; slot < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++slot) {
+        const fission_nk_panel_mask_word_t *members;
+        const fission_nk_panel_mask_word_t *docked;
+
+        members = FISSION_NK_PANEL_SLOT_MEMBERS(host, slot);
+        docked = FISSION_NK_PANEL_LAYOUT_CACHE_DOCKED(host, index, slot);
+        for (w = 0u; w < mask_words; ++w) {
+            if (docked[w] != (visible[w] & ~detached[w] & members[w])) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static size_t fission_nk_panel_host_layout_cache_find(
+    const fission_nk_panel_workspace_t *host,
+    const fission_nk_panel_layout_cache_entry_t *key
+)
+{
+    size_t i;
+
+    for (i = 0u; i < (size_t)FISSION_NK_PANEL_LAYOUT_CACHE_SIZE; ++i) {
+        const fission_nk_panel_layout_cache_entry_t *entry;
+
+        entry = &host->layout_cache.entries[i];
+        if (
+            entry->valid != 0 &&
+            entry->config_hash == key->config_hash &&
+            entry->window_width == key->window_width &&
+            entry->window_height == key->window_height &&
+            entry->ratios[0] == key->ratios[0] &&
+            entry->ratios[1] == key->ratios[1] &&
+            entry->ratios[2] == key->ratios[2] &&
+            entry->ratios[3] == key->ratios[3] &&
+            memcmp(entry->slot_rank, key->slot_rank, sizeof(entry->slot_rank)) == 0 &&
+            memcmp(entry->slot_tabbed, key->slot_tabbed, sizeof(entry->slot_tabbed)) == 0 &&
+            memcmp(entry->tab_selection, key->tab_selection, sizeof(entry->tab_selection)) == 0 &&
+            fission_nk_panel_host_layout_cache_docked_matches(host, i) != 0
+        ) {
+            return i;
+        }
+    }
+    return FISSION_NK_PANEL_INDEX_NONE;
+}
+
+/* Copies the docked bounds of the layout just resolved into the least recently used entry. */
+static void fission_nk_panel_host_layout_cache_store(
+    fission_nk_panel_workspace_t *host,
+    const fission_nk_panel_layout_cache_entry_t *key
+)
+{
+    fission_nk_panel_layout_cache_t *cache;
+    fission_nk_panel_layout_cache_entry_t *entry;
+    fission_nk_panel_bounds_t *bounds;
+    const fission_nk_panel_mask_word_t *visible;
+    const fission_nk_panel_mask_word_t *detached;
+    size_t mask_words;
+    size_t victim;
+    size_t slot;
+    size_t i;
+    size_t w;
+
+    cache = &host->layout_cache;
+    victim = 0u;
+    for (i = 0u; i < (size_t)FISSION_NK_PANEL_LAYOUT_CACHE_SIZE; ++i) {
+        if (cache->entries[i].valid == 0) {
+            victim = i;
+            break;
+        }
+        if (cache->entries[i].last_used < cache->entries[victim].last_used) {
+            victim = i;
+        }
+    }
+
+    entry = &cache->entries[victim];
+    *entry = *key;
+    entry->valid = 1;
+    cache->clock += 1u;
+    entry->last_used = cache->clock;
+    entry->dock_workspace_bounds = host->dock_workspace_bounds;
+    entry->splitter_bounds[0] = host->splitter_left_bounds;
+    entry->splitter_bounds[1] = host->splitter_right_bounds;
+    entry->splitter_bounds[2] = host->splitter_top_bounds;
+    entry->splitter_bounds[3] = host->splitter_bottom_bounds;
+    memcpy(entry->tab_strip_bounds, host->slot_tab_strip_bounds, sizeof(entry->tab_strip_bounds));
+    memcpy(entry->active_tab, host->slot_active_tab, sizeof(entry->active_tab));
+
+    bounds = FISSION_NK_PANEL_LAYOUT_CACHE_BOUNDS(host, victim);
+    visible = FISSION_NK_PANEL_VISIBLE(host);
+    detached = FISSION_NK_PANEL_DETACHED(host);
+    mask_words = fission_nk_panel_host_mask_words(host);
+    for (slot = 0u; slot < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++slot) {
+        const fission_nk_panel_mask_word_t *members;
+        fission_nk_panel_mask_word_t *docked;
+
+        members = FISSION_NK_PANEL_SLOT_MEMBERS(host, slot);
+        docked = FISSION_NK_PANEL_LAYOUT_CACHE_DOCKED(host, victim, slot);
+        for (w = 0u; w < mask_words; ++w) {
+            docked[w] = visible[w] & ~detached[w] & members[w];
+        }
+    }
+    for (w = 0u; w < mask_words; ++w) {
+        fission_nk_panel_mask_word_t bits;
+
+        bits = visible[w] & ~detached[w];
+        while (bits != 0u) {
+            i = w * FISSION_NK_PANEL_MASK_WORD_BITS + fission_nk_panel_mask_lowest(bits);
+            bits &= bits - 1u;
+            bounds[i] = FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[i];
+        }
+    }
+}
+
+static void fission_nk_panel_host_layout_cache_restore(fission_nk_panel_workspace_t *host, size_t index)
+{
+    fission_nk_panel_layout_cache_entry_t *entry;
+    const fission_nk_panel_bounds_t *bounds;
+    const fission_nk_panel_mask_word_t *visible;
+    const fission_nk_panel_mask_word_t *detached;
+    size_t mask_words;
+    size_t w;
+
+    entry = &host->layout_cache.entries[index];
+    host->layout_cache.clock += 1u;
+    entry->last_used = host->layout_cache.clock;
+
+    host->last_window_width = entry->window_width;
+    host->last_window_height = entry->window_height;
+    host->dock_workspace_bounds = entry->dock_workspace_bounds;
+    host->splitter_left_bounds = entry->splitter_bounds[0];
+    host->splitter_right_bounds = entry->splitter_bounds[1];
+    host->splitter_top_bounds = entry->splitter_bounds[2];
+    host->splitter_bottom_bounds = entry->splitter_bounds[3];
+    memcpy(host->slot_tab_strip_bounds, entry->tab_strip_bounds, sizeof(host->slot_tab_strip_bounds));
+    memcpy(host->slot_active_tab, entry->active_tab, sizeof(host->slot_active_tab));
+
+    bounds = FISSION_NK_PANEL_LAYOUT_CACHE_BOUNDS(host, index);
+    visible = FISSION_NK_PANEL_VISIBLE(host);
+    detached = FISSION_NK_PANEL_DETACHED(host);
+    mask_words = fission_nk_panel_host_mask_words(host);
+    for (w = 0u; w < mask_words; ++w) {
+        fission_nk_panel_mask_word_t bits;
+
+        bits = visible[w] & ~detached[w];
+        while (bits != 0u) {
+            size_t i;
+
+            i = w * FISSION_NK_PANEL_MASK_WORD_BITS + fission_nk_panel_mask_lowest(bits);
+            bits &= bits - 1u;
+            FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[i] = bounds[i];
+        }
+    }
+    fission_nk_panel_host_resolve_detached(host);
+}
+
+/*
+ * Re-resolves only when the window size or a layout input changed since the last resolve,
+ * and then only when the layout cache has no entry for the new inputs.
+ */
+static int fission_nk_panel_host_ensure_layout(
+    fission_nk_panel_workspace_t *host,
+    int window_width,
+    int window_height
+)
+{
+    fission_nk_panel_layout_cache_entry_t key;
+    size_t cached;
+
+    if (
+        host->layout_dirty == 0 &&
+        host->last_window_width == window_width &&
+        host->last_window_height == window_height
+    ) {
+        return 0;
+    }
 
+    /* The cache key does not cover a dock tree, so tree layouts always resolve. */
+    cached = FISSION_NK_PANEL_INDEX_NONE;
+    if (host->layout_cache.disabled == 0 && host->dock_tree == NULL) {
+        fission_nk_panel_host_layout_key(host, window_width, window_height, &key);
+        cached = fission_nk_panel_host_layout_cache_find(host, &key);
+    }
+    if (cached != FISSION_NK_PANEL_INDEX_NONE) {
+        fission_nk_panel_host_layout_cache_restore(host, cached);
+        host->layout_cache.hits += 1u;
+    } else {
+        (void)fission_nk_panel_host_resolve_layout(host, window_width, window_height);
+        fission_nk_panel_host_layout_tab_stacks(host);
+        if (host->layout_cache.disabled == 0) {
+            if (host->dock_tree == NULL) {
+                fission_nk_panel_host_layout_cache_store(host, &key);
+            }
+            host->layout_cache.misses += 1u;
+        }
+    }
+    host->layout_dirty = 0;
+    host->layout_generation += 1u;
     return 1;
 }
 
+/* Hit-tests and drags the dock tree's splitters; returns 1 when a drag moved one. */
+static int fission_nk_panel_host_update_tree_splitters(
+    fission_nk_panel_workspace_t *host,
+    struct nk_context *ctx,
+    int *hovered_splitter_id
+)
+{
+    fission_nk_dock_tree_t *tree;
+    size_t hit;
+    float delta;
+
+    tree = host->dock_tree;
+    if (host->active_splitter >= FISSION_NK_PANEL_SPLITTER_TREE) {
+        size_t split;
+
+        split = (size_t)(host->active_splitter - FISSION_NK_PANEL_SPLITTER_TREE);
+        if (
+            tree == NULL ||
+            split >= tree->node_count ||
+            tree->nodes[split].kind != (unsigned char)FISSION_NK_DOCK_NODE_SPLIT ||
+            tree->nodes[split].splitter.w <= 0.0f
+        ) {
+            host->active_splitter = FISSION_NK_PANEL_SPLITTER_NONE;
+        }
+    }
+    if (tree == NULL) {
+        return 0;
+    }
+
+    hit = fission_nk_dock_tree_hit_splitter(tree, ctx->input.mouse.pos.x, ctx->input.mouse.pos.y);
+    if (
+        hit != FISSION_NK_DOCK_NODE_NONE &&
+        (host->active_splitter == FISSION_NK_PANEL_SPLITTER_NONE ||
+            host->active_splitter == FISSION_NK_PANEL_SPLITTER_TREE + (int)hit)
+    ) {
+        *hovered_splitter_id = FISSION_NK_PANEL_SPLITTER_TREE + (int)hit;
+    }
+
+    if (host->active_splitter >= FISSION_NK_PANEL_SPLITTER_TREE) {
+        size_t split;
+
+        if (!nk_input_is_mouse_down(&ctx->input, NK_BUTTON_LEFT)) {
+            host->active_splitter = FISSION_NK_PANEL_SPLITTER_NONE;
+            return 0;
+        }
+        split = (size_t)(host->active_splitter - FISSION_NK_PANEL_SPLITTER_TREE);
+        delta = (tree->nodes[split].axis == (unsigned char)FISSION_NK_DOCK_AXIS_ROW) ?
+            ctx->input.mouse.delta.x :
+            ctx->input.mouse.delta.y;
+        if (delta != 0.0f && fission_nk_dock_tree_drag_splitter(tree, split, delta) != 0) {
+            fission_nk_panel_host_invalidate_layout(host);
+            return 1;
+        }
+        return 0;
+    }
+
+    if (
+        hit != FISSION_NK_DOCK_NODE_NONE &&
+        host->active_splitter == FISSION_NK_PANEL_SPLITTER_NONE &&
+        nk_input_is_mouse_pressed(&ctx->input, NK_BUTTON_LEFT)
+    ) {
+        host->active_splitter = FISSION_NK_PANEL_SPLITTER_TREE + (int)hit;
+    }
+    return 0;
+}
+
 static int fission_nk_panel_host_update_splitters(
     fission_nk_panel_workspace_t *host,
     struct nk_context *ctx
@@ -1748,6 +2898,10 @@ static int fission_nk_panel_host_update_splitters(
         }
     }
 
+    if (fission_nk_panel_host_update_tree_splitters(host, ctx, &hovered_splitter_id) != 0) {
+        changed = 1;
+    }
+
     host->hovered_splitter = hovered_splitter_id;
     if (host->active_splitter != FISSION_NK_PANEL_SPLITTER_NONE) {
         host->hovered_splitter = host->active_splitter;
@@ -1819,6 +2973,37 @@ static void fission_nk_panel_host_draw_splitter_overlays(
             host->hovered_splitter == FISSION_NK_PANEL_SPLITTER_BOTTOM
         );
     }
+
+    if (host->dock_tree != NULL) {
+        const fission_nk_dock_tree_t *tree;
+        size_t i;
+
+        tree = host->dock_tree;
+        for (i = 0u; i < tree->node_count; ++i) {
+            char suffix[32];
+            int splitter_id;
+
+            if (
+                tree->nodes[i].kind != (unsigned char)FISSION_NK_DOCK_NODE_SPLIT ||
+                tree->nodes[i].splitter.w <= 0.0f ||
+                tree->nodes[i].splitter.h <= 0.0f
+            ) {
+                continue;
+            }
+            splitter_id = FISSION_NK_PANEL_SPLITTER_TREE + (int)i;
+            (void)snprintf(suffix, sizeof(suffix), "splitter_tree_%u", (unsigned int)i);
+            fission_nk_panel_overlay_id(overlay_id, sizeof(overlay_id), host, suffix);
+            splitter_rect = fission_nk_panel_bounds_to_nk_rect(&tree->nodes[i].splitter);
+            fission_nk_draw_splitter_overlay(
+                ctx,
+                overlay_id,
+                &splitter_rect,
+                tree->nodes[i].axis == (unsigned char)FISSION_NK_DOCK_AXIS_ROW,
+                host->active_splitter == splitter_id,
+                host->hovered_splitter == splitter_id
+            );
+        }
+    }
 }
 
 static int fission_nk_panel_host_mouse_over_detached_panel(
@@ -1832,6 +3017,9 @@ static void fission_nk_panel_host_begin_panel_drag(
     struct nk_context *ctx
 )
 {
+    const fission_nk_panel_mask_word_t *visible;
+    const fission_nk_panel_mask_word_t *detached;
+    const fission_nk_panel_bounds_t *resolved_bounds;
     float mouse_x;
     float mouse_y;
     size_t i;
@@ -1852,19 +3040,24 @@ static void fission_nk_panel_host_begin_panel_drag(
         return;
     }
 
+    visible = FISSION_NK_PANEL_VISIBLE(host);
+    detached = FISSION_NK_PANEL_DETACHED(host);
+    resolved_bounds = FISSION_NK_PANEL_RESOLVED_BOUNDS(host);
     for (i = host->count; i > 0u; --i) {
-        fission_nk_panel_entry_t *entry;
         fission_nk_panel_bounds_t title_bounds;
 
-        entry = &host->entries[i - 1u];
-        if (entry->state.visible == 0 || entry->state.detached != 0) {
+        if (
+            fission_nk_panel_mask_test(visible, i - 1u) == 0 ||
+            fission_nk_panel_mask_test(detached, i - 1u) != 0 ||
+            fission_nk_panel_host_tab_hidden(host, i - 1u) != 0
+        ) {
             continue;
         }
 
-        title_bounds = entry->state.resolved_bounds;
+        title_bounds = resolved_bounds[i - 1u];
         title_bounds.h = FISSION_NK_PANEL_TITLE_BAR_HEIGHT;
-        if (title_bounds.h > entry->state.resolved_bounds.h) {
-            title_bounds.h = entry->state.resolved_bounds.h;
+        if (title_bounds.h > resolved_bounds[i - 1u].h) {
+            title_bounds.h = resolved_bounds[i - 1u].h;
         }
 
         if (fission_nk_panel_point_in_bounds(&title_bounds, mouse_x, mouse_y) == 0) {
@@ -1875,9 +3068,9 @@ static void fission_nk_panel_host_begin_panel_drag(
             fission_nk_panel_bounds_t button_bounds;
             int button_count;
 
-            button_count = (entry->state.detachable != 0) ? 2 : 1;
+            button_count = (FISSION_NK_PANEL_ENTRIES(host)[i - 1u].state.detachable != 0) ? 2 : 1;
             button_bounds = fission_nk_panel_header_button_bounds(
-                &entry->state.resolved_bounds,
+                &resolved_bounds[i - 1u],
                 button_count
             );
             if (fission_nk_panel_point_in_bounds(&button_bounds, mouse_x, mouse_y) != 0) {
@@ -1887,7 +3080,7 @@ static void fission_nk_panel_host_begin_panel_drag(
 
         host->dragging_panel = 1;
         host->dragging_panel_index = i - 1u;
-        host->drag_target_slot = entry->state.slot;
+        host->drag_target_slot = (fission_nk_panel_slot_t)FISSION_NK_PANEL_SLOT(host)[i - 1u];
         host->dragging_has_moved = 0;
         host->dragging_start_x = mouse_x;
         host->dragging_start_y = mouse_y;
@@ -1901,22 +3094,28 @@ static int fission_nk_panel_host_mouse_over_detached_panel(
     float mouse_y
 )
 {
+    const fission_nk_panel_mask_word_t *visible;
+    const fission_nk_panel_mask_word_t *detached;
+    const fission_nk_panel_bounds_t *resolved_bounds;
     size_t i;
 
     if (host == NULL) {
         return 0;
     }
 
+    visible = FISSION_NK_PANEL_VISIBLE(host);
+    detached = FISSION_NK_PANEL_DETACHED(host);
+    resolved_bounds = FISSION_NK_PANEL_RESOLVED_BOUNDS(host);
     for (i = host->count; i > 0u; --i) {
-        const fission_nk_panel_entry_t *entry;
-
-        entry = &host->entries[i - 1u];
-        if (entry->state.visible == 0 || entry->state.detached == 0) {
+        if (
+            fission_nk_panel_mask_test(visible, i - 1u) == 0 ||
+            fission_nk_panel_mask_test(detached, i - 1u) == 0
+        ) {
             continue;
         }
         if (
             fission_nk_panel_point_in_bounds(
-                &entry->state.resolved_bounds,
+                &resolved_bounds[i - 1u],
                 mouse_x,
                 mouse_y
             ) == 0
@@ -2002,7 +3201,8 @@ static int fission_nk_panel_host_update_panel_drag(
             host->dragging_panel_index,
             fission_nk_panel_slot_from_dock_zone(zone)
         );
-        host->entries[host->dragging_panel_index].state.detached = 0;
+        fission_nk_panel_mask_assign(FISSION_NK_PANEL_DETACHED(host), host->dragging_panel_index, 0);
+        fission_nk_panel_host_invalidate_layout(host);
 
         host->dragging_panel = 0;
         host->dragging_has_moved = 0;
@@ -2040,12 +3240,14 @@ static void fission_nk_panel_host_draw_drag_preview(
         return;
     }
 
-    entry = &host->entries[host->dragging_panel_index];
-    if (entry->state.visible == 0) {
+    entry = &FISSION_NK_PANEL_ENTRIES(host)[host->dragging_panel_index];
+    if (fission_nk_panel_mask_test(FISSION_NK_PANEL_VISIBLE(host), host->dragging_panel_index) == 0) {
         return;
     }
 
-    preview_bounds = fission_nk_panel_bounds_to_nk_rect(&entry->state.resolved_bounds);
+    preview_bounds = fission_nk_panel_bounds_to_nk_rect(
+        &FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[host->dragging_panel_index]
+    );
     preview_bounds.x += (ctx->input.mouse.pos.x - host->dragging_start_x);
     preview_bounds.y += (ctx->input.mouse.pos.y - host->dragging_start_y);
     if (preview_bounds.w <= 0.0f || preview_bounds.h <= 0.0f) {
@@ -2100,9 +3302,9 @@ static void fission_nk_panel_host_draw_drag_preview(
             );
         }
 
-        title = entry->desc.title;
+        title = fission_nk_panel_entry_desc(entry)->title;
         if (title == NULL || title[0] == '\0') {
-            title = entry->desc.id;
+            title = fission_nk_panel_entry_desc(entry)->id;
         }
         if (title != NULL && title[0] != '\0' && ctx->style.font != NULL) {
             title_len = (int)strlen(title);
@@ -2208,25 +3410,21 @@ static size_t fission_nk_panel_host_index_from_window_name(
     const char *window_name
 )
 {
-    size_t i;
+    size_t index;
 
     if (host == NULL || window_name == NULL) {
-        return FISSION_NK_MAX_PANELS;
+        return FISSION_NK_PANEL_INDEX_NONE;
     }
 
-    for (i = 0u; i < host->count; ++i) {
-        if (host->entries[i].state.visible == 0) {
-            continue;
-        }
-        if (strcmp(window_name, host->entries[i].desc.id) == 0) {
-            return i;
-        }
+    index = fission_nk_panel_find_index(host, window_name);
+    if (index >= host->count || fission_nk_panel_mask_test(FISSION_NK_PANEL_VISIBLE(host), index) == 0) {
+        return host->count;
     }
-
-    return host->count;
+    return index;
 }
 
 static const struct nk_window *fission_nk_panel_host_find_window_by_name_const(
+    const fission_nk_panel_workspace_t *host,
     const struct nk_context *ctx,
     const char *window_name
 )
@@ -2237,8 +3435,11 @@ static const struct nk_window *fission_nk_panel_host_find_window_by_name_const(
         return NULL;
     }
 
+    FISSION_NK_PANEL_COUNT(host, FISSION_NK_PANEL_COUNTER_WINDOW_LOOKUPS, 1u);
     window = ctx->begin;
     while (window != NULL) {
+        FISSION_NK_PANEL_COUNT(host, FISSION_NK_PANEL_COUNTER_WINDOW_LIST_STEPS, 1u);
+        FISSION_NK_PANEL_COUNT(host, FISSION_NK_PANEL_COUNTER_WINDOW_NAME_COMPARES, 1u);
         if (strcmp(window->name_string, window_name) == 0) {
             return window;
         }
@@ -2249,6 +3450,7 @@ static const struct nk_window *fission_nk_panel_host_find_window_by_name_const(
 }
 
 static struct nk_window *fission_nk_panel_host_find_window_by_name(
+    const fission_nk_panel_workspace_t *host,
     struct nk_context *ctx,
     const char *window_name
 )
@@ -2259,8 +3461,11 @@ static struct nk_window *fission_nk_panel_host_find_window_by_name(
         return NULL;
     }
 
+    FISSION_NK_PANEL_COUNT(host, FISSION_NK_PANEL_COUNTER_WINDOW_LOOKUPS, 1u);
     window = ctx->begin;
     while (window != NULL) {
+        FISSION_NK_PANEL_COUNT(host, FISSION_NK_PANEL_COUNTER_WINDOW_LIST_STEPS, 1u);
+        FISSION_NK_PANEL_COUNT(host, FISSION_NK_PANEL_COUNTER_WINDOW_NAME_COMPARES, 1u);
         if (strcmp(window->name_string, window_name) == 0) {
             return window;
         }
@@ -2270,41 +3475,92 @@ static struct nk_window *fission_nk_panel_host_find_window_by_name(
     return NULL;
 }
 
-static struct nk_rect fission_nk_panel_host_hover_bounds_for_index(
-    const fission_nk_panel_workspace_t *host,
+static void fission_nk_panel_host_cache_window(
+    fission_nk_panel_entry_t *entry,
     const struct nk_context *ctx,
-    size_t index
+    struct nk_window *window
 )
 {
-    const struct nk_window *window;
-
-    if (host == NULL || ctx == NULL || index >= host->count) {
-        return nk_rect(0.0f, 0.0f, 0.0f, 0.0f);
-    }
-
-    window = fission_nk_panel_host_find_window_by_name_const(
-        ctx,
-        host->entries[index].desc.id
-    );
-    if (window != NULL) {
-        return fission_nk_panel_window_hover_bounds(ctx, window);
+    if (window == NULL) {
+        memset(&entry->window_cache, 0, sizeof(entry->window_cache));
+        return;
     }
-
-    return fission_nk_panel_bounds_to_nk_rect(&host->entries[index].state.resolved_bounds);
+    entry->window_cache.ctx = ctx;
+    entry->window_cache.window = window;
+    entry->window_cache.seq = window->seq;
+    entry->window_cache.name_hash = (unsigned int)window->name;
 }
 
-static int fission_nk_panel_host_index_hovered(
+static struct nk_window *fission_nk_panel_host_cached_window(
     const fission_nk_panel_workspace_t *host,
     const struct nk_context *ctx,
     size_t index
 )
 {
-    struct nk_rect hover_bounds;
+    const fission_nk_panel_window_cache_t *cache;
 
-    if (host == NULL || ctx == NULL || index >= host->count) {
-        return 0;
+    cache = &FISSION_NK_PANEL_ENTRIES(host)[index].window_cache;
+    if (cache->window == NULL || cache->ctx != ctx) {
+        return NULL;
+    }
+    if (cache->seq != ctx->seq && cache->seq + 1u != ctx->seq) {
+        return NULL;
+    }
+    /*
+     * nk_clear also frees closed windows; their pool slot stays mapped, so the flag and
+     * name reads are safe and reject a slot that was freed or reused by another window.
+     */
+    if (
+        (cache->window->flags & NK_WINDOW_CLOSED) != 0 ||
+        (unsigned int)cache->window->name != cache->name_hash
+    ) {
+        return NULL;
+    }
+    return cache->window;
+}
+
+static struct nk_rect fission_nk_panel_host_hover_bounds_for_index(
+    const fission_nk_panel_workspace_t *host,
+    const struct nk_context *ctx,
+    size_t index
+)
+{
+    const struct nk_window *window;
+
+    if (host == NULL || ctx == NULL || index >= host->count) {
+        return nk_rect(0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    window = fission_nk_panel_host_cached_window(host, ctx, index);
+    if (window == NULL) {
+        window = fission_nk_panel_host_find_window_by_name_const(
+            host,
+            ctx,
+            fission_nk_panel_entry_desc(&FISSION_NK_PANEL_ENTRIES(host)[index])->id
+        );
+    }
+    if (window != NULL) {
+        return fission_nk_panel_window_hover_bounds(ctx, window);
+    }
+
+    return fission_nk_panel_bounds_to_nk_rect(&FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[index]);
+}
+
+static int fission_nk_panel_host_index_hovered(
+    const fission_nk_panel_workspace_t *host,
+    const struct nk_context *ctx,
+    size_t index
+)
+{
+    struct nk_rect hover_bounds;
+
+    if (host == NULL || ctx == NULL || index >= host->count) {
+        return 0;
     }
-    if (host->entries[index].state.visible == 0) {
+    if (
+        fission_nk_panel_mask_test(FISSION_NK_PANEL_VISIBLE(host), index) == 0 ||
+        fission_nk_panel_host_tab_hidden(host, index) != 0
+    ) {
         return 0;
     }
 
@@ -2325,7 +3581,7 @@ static size_t fission_nk_panel_host_resolve_hovered_panel_index(
     size_t active_index;
 
     if (host == NULL || ctx == NULL) {
-        return FISSION_NK_MAX_PANELS;
+        return FISSION_NK_PANEL_INDEX_NONE;
     }
 
     active_index = host->count;
@@ -2338,7 +3594,7 @@ static size_t fission_nk_panel_host_resolve_hovered_panel_index(
 
     if (
         active_index < host->count &&
-        host->entries[active_index].state.detached != 0 &&
+        fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), active_index) != 0 &&
         fission_nk_panel_host_index_hovered(host, ctx, active_index) != 0
     ) {
         return active_index;
@@ -2348,7 +3604,7 @@ static size_t fission_nk_panel_host_resolve_hovered_panel_index(
         size_t index;
 
         index = i - 1u;
-        if (host->entries[index].state.detached == 0) {
+        if (fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), index) == 0) {
             continue;
         }
         if (fission_nk_panel_host_index_hovered(host, ctx, index) != 0) {
@@ -2358,14 +3614,14 @@ static size_t fission_nk_panel_host_resolve_hovered_panel_index(
 
     if (
         active_index < host->count &&
-        host->entries[active_index].state.detached == 0 &&
+        fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), active_index) == 0 &&
         fission_nk_panel_host_index_hovered(host, ctx, active_index) != 0
     ) {
         return active_index;
     }
 
     for (i = 0u; i < host->count; ++i) {
-        if (host->entries[i].state.detached != 0) {
+        if (fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), i) != 0) {
             continue;
         }
         if (fission_nk_panel_host_index_hovered(host, ctx, i) != 0) {
@@ -2381,22 +3637,14 @@ static int fission_nk_panel_host_window_name_is_panel(
     const char *window_name
 )
 {
-    size_t i;
+    size_t index;
 
     if (host == NULL || window_name == NULL) {
         return 0;
     }
 
-    for (i = 0u; i < host->count; ++i) {
-        if (host->entries[i].state.visible == 0) {
-            continue;
-        }
-        if (strcmp(window_name, host->entries[i].desc.id) == 0) {
-            return 1;
-        }
-    }
-
-    return 0;
+    index = fission_nk_panel_find_index(host, window_name);
+    return (index < host->count && fission_nk_panel_mask_test(FISSION_NK_PANEL_VISIBLE(host), index) != 0) ? 1 : 0;
 }
 
 static void fission_nk_panel_host_clear_ui_scroll_blocks(
@@ -2475,6 +3723,7 @@ static int fission_nk_panel_host_mouse_over_non_panel_ui(
     while (iter != NULL) {
         struct nk_rect iter_bounds;
 
+        FISSION_NK_PANEL_COUNT(host, FISSION_NK_PANEL_COUNTER_WINDOW_LIST_STEPS, 1u);
         if ((iter->flags & NK_WINDOW_HIDDEN) != 0 || (iter->flags & NK_WINDOW_NO_INPUT) != 0) {
             iter = iter->next;
             continue;
@@ -2528,7 +3777,7 @@ static size_t fission_nk_panel_host_activate_hovered_panel_on_scroll(
     struct nk_window *target_window;
 
     if (host == NULL || ctx == NULL) {
-        return host != NULL ? host->count : FISSION_NK_MAX_PANELS;
+        return host != NULL ? host->count : FISSION_NK_PANEL_INDEX_NONE;
     }
     if (
         ctx->input.mouse.scroll_delta.x == 0.0f &&
@@ -2545,10 +3794,14 @@ static size_t fission_nk_panel_host_activate_hovered_panel_on_scroll(
         return host->count;
     }
 
-    target_window = fission_nk_panel_host_find_window_by_name(
-        ctx,
-        host->entries[target_index].desc.id
-    );
+    target_window = fission_nk_panel_host_cached_window(host, ctx, target_index);
+    if (target_window == NULL) {
+        target_window = fission_nk_panel_host_find_window_by_name(
+            host,
+            ctx,
+            fission_nk_panel_entry_desc(&FISSION_NK_PANEL_ENTRIES(host)[target_index])->id
+        );
+    }
     if (target_window != NULL) {
         ctx->active = target_window;
         target_window->flags &= ~(nk_flags)NK_WINDOW_ROM;
@@ -2572,6 +3825,7 @@ void fission_nk_panel_workspace_init(
     host->bottom_row_ratio = 0.20f;
     host->last_window_width = 1600;
     host->last_window_height = 900;
+    host->layout_dirty = 1;
     host->active_splitter = FISSION_NK_PANEL_SPLITTER_NONE;
     host->hovered_splitter = FISSION_NK_PANEL_SPLITTER_NONE;
     host->dragging_panel = 0;
@@ -2588,53 +3842,125 @@ void fission_nk_panel_workspace_init(
     fission_nk_panel_bounds_zero(&host->splitter_bottom_bounds);
 }
 
-fission_nk_panel_status_t fission_nk_panel_workspace_register(
+fission_nk_panel_status_t fission_nk_panel_workspace_init_dynamic(
     fission_nk_panel_workspace_t *host,
-    const fission_nk_panel_desc_t *panel
+    const struct nk_allocator *allocator,
+    size_t initial_capacity
 )
 {
-    size_t i;
-    fission_nk_panel_entry_t *entry;
-
-    if (host == NULL || panel == NULL) {
+    if (host == NULL) {
         return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
     }
-    if (panel->id == NULL || panel->title == NULL || panel->draw == NULL) {
+    fission_nk_panel_workspace_init(host);
+    if (allocator == NULL || allocator->alloc == NULL || allocator->free == NULL) {
         return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
     }
-    if (host->count >= FISSION_NK_MAX_PANELS) {
+
+    host->storage.allocator = allocator;
+    if (initial_capacity == 0u) {
+        initial_capacity = (size_t)FISSION_NK_MAX_PANELS;
+    }
+    if (fission_nk_panel_storage_reserve(host, initial_capacity) == 0) {
+        host->storage.allocator = NULL;
         return FISSION_NK_PANEL_STATUS_RUNTIME_ERROR;
     }
+    return FISSION_NK_PANEL_STATUS_OK;
+}
 
-    for (i = 0u; i < host->count; ++i) {
-        if (strcmp(host->entries[i].desc.id, panel->id) == 0) {
-            return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
-        }
+void fission_nk_panel_workspace_set_lazy_init(
+    fission_nk_panel_workspace_t *host,
+    int enabled,
+    fission_nk_panel_schedule_fn schedule,
+    void *schedule_user_data
+)
+{
+    if (host == NULL) {
+        return;
     }
 
-    if (panel->init != NULL) {
-        fission_nk_panel_status_t init_status;
+    host->init_runner.lazy = (enabled != 0) ? 1 : 0;
+#if FISSION_NK_HAVE_ATOMICS
+    host->init_runner.schedule = schedule;
+    host->init_runner.schedule_user_data = schedule_user_data;
+#else
+    /* Without atomics the job handshake would race, so every init runs inline. */
+    (void)schedule;
+    (void)schedule_user_data;
+    host->init_runner.schedule = NULL;
+    host->init_runner.schedule_user_data = NULL;
+#endif
+}
 
-        init_status = panel->init(panel->user_data);
-        if (init_status != FISSION_NK_PANEL_STATUS_OK) {
-            return init_status;
-        }
+fission_nk_panel_init_state_t fission_nk_panel_workspace_panel_init_state_at(
+    const fission_nk_panel_workspace_t *host,
+    size_t index
+)
+{
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
+        return FISSION_NK_PANEL_INIT_FAILED;
+    }
+    return FISSION_NK_PANEL_ENTRIES(host)[index].init_state;
+}
+
+size_t fission_nk_panel_workspace_max_panels(const fission_nk_panel_workspace_t *host)
+{
+    if (host == NULL) {
+        return 0u;
+    }
+    if (host->storage.allocator != NULL) {
+        return (size_t)FISSION_NK_PANEL_DYNAMIC_MAX_PANELS;
     }
+    return (size_t)FISSION_NK_MAX_PANELS;
+}
+
+/*
+ * Fills entry `index` from a desc, copied or (by_reference) pointed at, and sets its
+ * default placement; the caller adds the id to the id table and touches the slot.
+ * Returns the new generation.
+ */
+static unsigned short fission_nk_panel_host_setup_entry(
+    fission_nk_panel_workspace_t *host,
+    size_t index,
+    const fission_nk_panel_desc_t *panel,
+    int by_reference
+)
+{
+    fission_nk_panel_entry_t *entry;
+    fission_nk_panel_slot_t slot;
+    unsigned short generation;
 
-    entry = &host->entries[host->count];
+    entry = &FISSION_NK_PANEL_ENTRIES(host)[index];
+    generation = (unsigned short)(entry->generation + 1u);
+    if (generation == 0u) {
+        generation = 1u;
+    }
     memset(entry, 0, sizeof(*entry));
-    entry->desc = *panel;
+    if (by_reference != 0) {
+        entry->static_desc = panel;
+    } else {
+        entry->desc = *panel;
+    }
+    entry->generation = generation;
+    if (panel->init != NULL && host->init_runner.lazy != 0) {
+        entry->init_state = FISSION_NK_PANEL_INIT_PENDING;
+    }
 
-    entry->state.visible = (panel->default_visible >= 0) ? 1 : 0;
+    fission_nk_panel_mask_assign(FISSION_NK_PANEL_LIVE(host), index, 1);
+    fission_nk_panel_mask_assign(
+        FISSION_NK_PANEL_VISIBLE(host),
+        index,
+        panel->default_visible >= 0
+    );
     entry->state.detachable = (panel->default_detachable >= 0) ? 1 : 0;
-    entry->state.detached = 0;
+    fission_nk_panel_mask_assign(FISSION_NK_PANEL_DETACHED(host), index, 0);
 
     if (fission_nk_panel_slot_is_valid(panel->default_slot) != 0) {
-        entry->state.slot = panel->default_slot;
+        slot = panel->default_slot;
     } else {
-        entry->state.slot = FISSION_NK_PANEL_SLOT_CENTER;
+        slot = FISSION_NK_PANEL_SLOT_CENTER;
     }
-    fission_nk_panel_touch_slot(host, entry->state.slot);
+    FISSION_NK_PANEL_SLOT(host)[index] = (unsigned char)slot;
+    fission_nk_panel_mask_assign(FISSION_NK_PANEL_SLOT_MEMBERS(host, slot), index, 1);
 
     if (
         panel->default_detached_bounds.w > 0.0f &&
@@ -2642,13 +3968,110 @@ fission_nk_panel_status_t fission_nk_panel_workspace_register(
     ) {
         entry->state.detached_bounds = panel->default_detached_bounds;
     } else {
-        entry->state.detached_bounds = fission_nk_panel_default_detached_bounds(entry->state.slot);
+        entry->state.detached_bounds = fission_nk_panel_default_detached_bounds(slot);
     }
 
     fission_nk_panel_sanitize_detached_bounds(host, &entry->state.detached_bounds);
-    entry->state.resolved_bounds = entry->state.detached_bounds;
+    FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[index] = entry->state.detached_bounds;
+    fission_nk_panel_host_invalidate_layout(host);
+    return generation;
+}
+
+/* Touches each slot used by entries [first, first + count) once, in order of last use. */
+static void fission_nk_panel_host_touch_slots(
+    fission_nk_panel_workspace_t *host,
+    size_t first,
+    size_t count
+)
+{
+    fission_nk_panel_slot_t order[FISSION_NK_PANEL_SLOT_COUNT];
+    unsigned int seen;
+    size_t used;
+    size_t i;
+
+    seen = 0u;
+    used = 0u;
+    for (i = count; i > 0u && used < (size_t)FISSION_NK_PANEL_SLOT_COUNT; --i) {
+        fission_nk_panel_slot_t slot;
+
+        slot = (fission_nk_panel_slot_t)FISSION_NK_PANEL_SLOT(host)[first + i - 1u];
+        if ((seen & (1u << (unsigned int)slot)) != 0u) {
+            continue;
+        }
+        seen |= 1u << (unsigned int)slot;
+        order[used] = slot;
+        used += 1u;
+    }
+    while (used > 0u) {
+        used -= 1u;
+        fission_nk_panel_touch_slot(host, order[used]);
+    }
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_register(
+    fission_nk_panel_workspace_t *host,
+    const fission_nk_panel_desc_t *panel
+)
+{
+    return fission_nk_panel_workspace_register_handle(host, panel, NULL);
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_register_handle(
+    fission_nk_panel_workspace_t *host,
+    const fission_nk_panel_desc_t *panel,
+    fission_nk_panel_handle_t *out_handle
+)
+{
+    unsigned short generation;
+    size_t index;
+
+    if (out_handle != NULL) {
+        *out_handle = FISSION_NK_PANEL_HANDLE_NONE;
+    }
+    if (host == NULL || panel == NULL) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+    if (panel->id == NULL || panel->title == NULL || panel->draw == NULL) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+    if (host->free_head == 0u && fission_nk_panel_host_reserve(host, host->count + 1u) == 0) {
+        return FISSION_NK_PANEL_STATUS_RUNTIME_ERROR;
+    }
+
+    if (fission_nk_panel_find_index(host, panel->id) < host->count) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    if (panel->init != NULL && host->init_runner.lazy == 0) {
+        fission_nk_panel_status_t init_status;
+
+        init_status = panel->init(panel->user_data);
+        if (init_status != FISSION_NK_PANEL_STATUS_OK) {
+            return init_status;
+        }
+        /* init may have registered or unregistered other panels. */
+        if (host->free_head == 0u && fission_nk_panel_host_reserve(host, host->count + 1u) == 0) {
+            if (panel->shutdown != NULL) {
+                panel->shutdown(panel->user_data);
+            }
+            return FISSION_NK_PANEL_STATUS_RUNTIME_ERROR;
+        }
+    }
+
+    if (host->free_head != 0u) {
+        index = host->free_head - 1u;
+        host->free_head = FISSION_NK_PANEL_ENTRIES(host)[index].next_free;
+    } else {
+        index = host->count;
+        host->count += 1u;
+    }
 
-    host->count += 1u;
+    generation = fission_nk_panel_host_setup_entry(host, index, panel, 0);
+    fission_nk_panel_touch_slot(host, (fission_nk_panel_slot_t)FISSION_NK_PANEL_SLOT(host)[index]);
+    fission_nk_panel_id_table_insert(host, index);
+    if (out_handle != NULL) {
+        *out_handle = fission_nk_panel_make_handle(index, generation);
+    }
     return FISSION_NK_PANEL_STATUS_OK;
 }
 
@@ -2660,11 +4083,11 @@ static void fission_nk_panel_workspace_toggle_detached(
 {
     fission_nk_panel_bounds_t bounds;
 
-    if (host == NULL || index >= host->count) {
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
         return;
     }
 
-    if (host->entries[index].state.detached != 0) {
+    if (fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), index) != 0) {
         (void)fission_nk_panel_workspace_set_panel_detached_at(host, index, 0);
         return;
     }
@@ -2672,52 +4095,45 @@ static void fission_nk_panel_workspace_toggle_detached(
     if (window_bounds != NULL) {
         bounds = *window_bounds;
     } else {
-        bounds = host->entries[index].state.resolved_bounds;
+        bounds = FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[index];
     }
 
-    host->entries[index].state.detached_bounds = bounds;
+    FISSION_NK_PANEL_ENTRIES(host)[index].state.detached_bounds = bounds;
     fission_nk_panel_sanitize_detached_bounds(
         host,
-        &host->entries[index].state.detached_bounds
+        &FISSION_NK_PANEL_ENTRIES(host)[index].state.detached_bounds
     );
     (void)fission_nk_panel_workspace_set_panel_detached_at(host, index, 1);
 }
 
-int fission_nk_panel_workspace_begin_window(
+static int fission_nk_panel_host_begin_window_at(
     struct nk_context *ctx,
     fission_nk_panel_workspace_t *host,
-    const char *panel_id,
+    size_t index,
     const char *title,
     unsigned int extra_flags,
     fission_nk_panel_bounds_t *out_bounds
 )
 {
-    size_t index;
     fission_nk_panel_entry_t *entry;
+    const char *panel_id;
     fission_nk_panel_bounds_t bounds;
     struct nk_rect nk_bounds;
+    struct nk_window *window;
     nk_flags flags;
     const char *window_title;
     int open;
     int focus_on_scroll;
 
-    if (ctx == NULL || host == NULL || panel_id == NULL) {
-        return 0;
-    }
-
-    index = fission_nk_panel_find_index(host, panel_id);
-    if (index >= host->count) {
-        return 0;
-    }
-
-    entry = &host->entries[index];
-    bounds = entry->state.resolved_bounds;
+    entry = &FISSION_NK_PANEL_ENTRIES(host)[index];
+    panel_id = fission_nk_panel_entry_desc(entry)->id;
+    bounds = FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[index];
 
     focus_on_scroll = ((extra_flags & FISSION_NK_PANEL_WINDOW_NO_SCROLL_FOCUS) == 0u);
     extra_flags &= ~FISSION_NK_PANEL_WINDOW_NO_SCROLL_FOCUS;
 
     flags = NK_WINDOW_BORDER | NK_WINDOW_TITLE | (nk_flags)extra_flags;
-    if (entry->state.detached != 0) {
+    if (fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), index) != 0) {
         flags |= NK_WINDOW_MOVABLE | NK_WINDOW_SCALABLE;
     } else {
         flags |= NK_WINDOW_BACKGROUND;
@@ -2725,14 +4141,21 @@ int fission_nk_panel_workspace_begin_window(
 
     window_title = title;
     if (window_title == NULL || window_title[0] == '\0') {
-        window_title = entry->desc.title;
+        window_title = fission_nk_panel_entry_desc(entry)->title;
     }
     if (window_title == NULL || window_title[0] == '\0') {
         window_title = panel_id;
     }
 
+    /* nk_begin keeps NK_WINDOW_HIDDEN, so clear it from a tab that was kept alive hidden. */
+    window = fission_nk_panel_host_cached_window(host, ctx, index);
+    if (window != NULL) {
+        window->flags &= ~(nk_flags)NK_WINDOW_HIDDEN;
+    }
+
     nk_bounds = fission_nk_panel_bounds_to_nk_rect(&bounds);
     open = nk_begin_titled(ctx, panel_id, window_title, nk_bounds, flags);
+    fission_nk_panel_host_cache_window(entry, ctx, ctx->current);
     nk_bounds = nk_window_get_bounds(ctx);
 
     if (open != 0 && focus_on_scroll != 0) {
@@ -2750,34 +4173,65 @@ int fission_nk_panel_workspace_begin_window(
     return open;
 }
 
-void fission_nk_panel_workspace_end_window(
+int fission_nk_panel_workspace_begin_window(
     struct nk_context *ctx,
     fission_nk_panel_workspace_t *host,
-    const char *panel_id
+    const char *panel_id,
+    const char *title,
+    unsigned int extra_flags,
+    fission_nk_panel_bounds_t *out_bounds
 )
 {
     size_t index;
-    fission_nk_panel_entry_t *entry;
-    struct nk_rect nk_bounds;
-    fission_nk_panel_bounds_t bounds;
-    int toggle_requested;
-    int close_requested;
 
-    if (ctx == NULL) {
-        return;
-    }
-    if (host == NULL || panel_id == NULL) {
-        nk_end(ctx);
-        return;
+    if (ctx == NULL || host == NULL || panel_id == NULL) {
+        return 0;
     }
 
     index = fission_nk_panel_find_index(host, panel_id);
     if (index >= host->count) {
-        nk_end(ctx);
-        return;
+        return 0;
+    }
+
+    return fission_nk_panel_host_begin_window_at(ctx, host, index, title, extra_flags, out_bounds);
+}
+
+int fission_nk_panel_workspace_begin_window_handle(
+    struct nk_context *ctx,
+    fission_nk_panel_workspace_t *host,
+    fission_nk_panel_handle_t handle,
+    const char *title,
+    unsigned int extra_flags,
+    fission_nk_panel_bounds_t *out_bounds
+)
+{
+    size_t index;
+
+    if (ctx == NULL || host == NULL) {
+        return 0;
+    }
+
+    index = fission_nk_panel_handle_index(host, handle);
+    if (index >= host->count) {
+        return 0;
     }
 
-    entry = &host->entries[index];
+    return fission_nk_panel_host_begin_window_at(ctx, host, index, title, extra_flags, out_bounds);
+}
+
+static void fission_nk_panel_host_end_window_at(
+    struct nk_context *ctx,
+    fission_nk_panel_workspace_t *host,
+    size_t index
+)
+{
+    fission_nk_panel_entry_t *entry;
+    struct nk_rect nk_bounds;
+    fission_nk_panel_bounds_t bounds;
+    int toggle_requested;
+    int close_requested;
+
+    entry = &FISSION_NK_PANEL_ENTRIES(host)[index];
     nk_bounds = nk_window_get_bounds(ctx);
     bounds.x = nk_bounds.x;
     bounds.y = nk_bounds.y;
@@ -2790,17 +4244,25 @@ void fission_nk_panel_workspace_end_window(
         ctx,
         &bounds,
         entry->state.detachable,
-        entry->state.detached,
+        fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), index),
         &toggle_requested,
         &close_requested
     );
 
-    if (entry->state.detached != 0) {
-        host->entries[index].state.detached_bounds = bounds;
+    if (fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), index) != 0) {
+        FISSION_NK_PANEL_ENTRIES(host)[index].state.detached_bounds = bounds;
         fission_nk_panel_sanitize_detached_bounds(
             host,
-            &host->entries[index].state.detached_bounds
+            &FISSION_NK_PANEL_ENTRIES(host)[index].state.detached_bounds
         );
+        /* Floating panels never affect the docked layout, so no re-resolve is needed. */
+        bounds = FISSION_NK_PANEL_ENTRIES(host)[index].state.detached_bounds;
+        if (
+            memcmp(&FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[index], &bounds, sizeof(bounds)) != 0
+        ) {
+            FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[index] = bounds;
+            host->layout_generation += 1u;
+        }
     }
 
     if (close_requested != 0) {
@@ -2812,43 +4274,573 @@ void fission_nk_panel_workspace_end_window(
     nk_end(ctx);
 }
 
-void fission_nk_panel_workspace_draw_all(
-    fission_nk_panel_workspace_t *host,
+void fission_nk_panel_workspace_end_window(
     struct nk_context *ctx,
-    int window_width,
-    int window_height
+    fission_nk_panel_workspace_t *host,
+    const char *panel_id
 )
 {
-    size_t i;
-    int layout_changed;
-    int visible_snapshot[FISSION_NK_MAX_PANELS];
-    int detached_snapshot[FISSION_NK_MAX_PANELS];
-    int drawn[FISSION_NK_MAX_PANELS];
-    float original_scroll_x;
-    float original_scroll_y;
-    size_t scroll_target_index;
-    int scroll_routing_enabled;
-    int suppress_panel_scroll;
+    size_t index;
 
-    if (host == NULL || ctx == NULL || window_width <= 0 || window_height <= 0) {
+    if (ctx == NULL) {
         return;
     }
-
-    (void)fission_nk_panel_host_resolve_layout(host, window_width, window_height);
-
+    if (host == NULL || panel_id == NULL) {
+        nk_end(ctx);
+        return;
+    }
+
+    index = fission_nk_panel_find_index(host, panel_id);
+    if (index >= host->count) {
+        nk_end(ctx);
+        return;
+    }
+
+    fission_nk_panel_host_end_window_at(ctx, host, index);
+}
+
+void fission_nk_panel_workspace_end_window_handle(
+    struct nk_context *ctx,
+    fission_nk_panel_workspace_t *host,
+    fission_nk_panel_handle_t handle
+)
+{
+    size_t index;
+
+    if (ctx == NULL) {
+        return;
+    }
+
+    index = fission_nk_panel_handle_index(host, handle);
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
+        nk_end(ctx);
+        return;
+    }
+
+    fission_nk_panel_host_end_window_at(ctx, host, index);
+}
+
+static fission_nk_panel_stat_range_t *fission_nk_panel_stats_range(
+    fission_nk_panel_stats_t *stats,
+    int metric
+)
+{
+    switch (metric) {
+    case FISSION_NK_PANEL_STAT_CPU_NS:
+        return &stats->cpu_ns;
+    case FISSION_NK_PANEL_STAT_COMMANDS:
+        return &stats->command_count;
+    case FISSION_NK_PANEL_STAT_VERTICES:
+        return &stats->vertex_count;
+    default:
+        return &stats->element_count;
+    }
+}
+
+static void fission_nk_panel_stats_sample(
+    fission_nk_panel_stats_state_t *state,
+    const double *values
+)
+{
+    int metric;
+    int publish;
+
+    if (state->window_samples == 0u) {
+        for (metric = 0; metric < FISSION_NK_PANEL_STAT_METRIC_COUNT; ++metric) {
+            state->window_sum[metric] = 0.0;
+            state->window_min[metric] = values[metric];
+            state->window_max[metric] = values[metric];
+        }
+    }
+    state->window_samples += 1u;
+
+    publish = (
+        state->window_samples >= FISSION_NK_PANEL_STATS_WINDOW_FRAMES ||
+        state->published.sample_count < FISSION_NK_PANEL_STATS_WINDOW_FRAMES
+    );
+    for (metric = 0; metric < FISSION_NK_PANEL_STAT_METRIC_COUNT; ++metric) {
+        fission_nk_panel_stat_range_t *range;
+
+        state->window_sum[metric] += values[metric];
+        if (values[metric] < state->window_min[metric]) {
+            state->window_min[metric] = values[metric];
+        }
+        if (values[metric] > state->window_max[metric]) {
+            state->window_max[metric] = values[metric];
+        }
+
+        range = fission_nk_panel_stats_range(&state->published, metric);
+        range->last = values[metric];
+        if (publish != 0) {
+            range->min = state->window_min[metric];
+            range->max = state->window_max[metric];
+            range->avg = state->window_sum[metric] / (double)state->window_samples;
+        }
+    }
+
+    state->published.sample_count += 1u;
+    if (state->window_samples >= FISSION_NK_PANEL_STATS_WINDOW_FRAMES) {
+        state->window_samples = 0u;
+    }
+}
+
+static void fission_nk_panel_host_record_draw_stats(
+    fission_nk_panel_workspace_t *host,
+    const struct nk_context *ctx,
+    size_t index,
+    unsigned long long cpu_ns
+)
+{
+    const struct nk_window *window;
+    const fission_nk_convert_buffers_t *convert;
+    fission_nk_window_draw_stats_t draw_stats;
+    double values[FISSION_NK_PANEL_STAT_METRIC_COUNT];
+
+    window = fission_nk_panel_host_cached_window(host, ctx, index);
+    if (window == NULL) {
+        window = fission_nk_panel_host_find_window_by_name_const(
+            host,
+            ctx,
+            fission_nk_panel_entry_desc(&FISSION_NK_PANEL_ENTRIES(host)[index])->id
+        );
+    }
+    if (window != NULL && window->seq != ctx->seq) {
+        window = NULL;
+    }
+
+    convert = NULL;
+    if (host->diagnostics.panel_stats_convert.config != NULL) {
+        convert = &host->diagnostics.panel_stats_convert;
+    }
+    fission_nk_measure_window(ctx, window, convert, &draw_stats);
+
+    values[FISSION_NK_PANEL_STAT_CPU_NS] = (double)cpu_ns;
+    values[FISSION_NK_PANEL_STAT_COMMANDS] = (double)draw_stats.command_count;
+    values[FISSION_NK_PANEL_STAT_VERTICES] = (double)draw_stats.vertex_count;
+    values[FISSION_NK_PANEL_STAT_ELEMENTS] = (double)draw_stats.element_count;
+    fission_nk_panel_stats_sample(&FISSION_NK_PANEL_ENTRIES(host)[index].stats, values);
+}
+
+static void fission_nk_panel_run_init_job(void *job)
+{
+    fission_nk_panel_init_job_t *init_job;
+
+    init_job = (fission_nk_panel_init_job_t *)job;
+    if (fission_nk_atomic_compare_exchange(&init_job->claimed, 0, 1) == 0) {
+        /* The workspace stopped waiting for the scheduler and ran it inline. */
+        return;
+    }
+    init_job->status = init_job->init(init_job->user_data);
+    fission_nk_atomic_store_release(&init_job->done, 1);
+}
+
+/*
+ * Runs a job the scheduler has not started yet on this thread, so a scheduler that defers
+ * jobs to the caller's own queue cannot deadlock the wait; otherwise yields until the
+ * worker running it finishes.
+ */
+static void fission_nk_panel_wait_init_job(fission_nk_panel_init_job_t *job)
+{
+    if (fission_nk_atomic_compare_exchange(&job->claimed, 0, 1) != 0) {
+        job->status = job->init(job->user_data);
+        fission_nk_atomic_store_release(&job->done, 1);
+        return;
+    }
+    while (fission_nk_atomic_load_acquire(&job->done) == 0) {
+        fission_nk_thread_yield();
+    }
+}
+
+static void fission_nk_panel_host_finish_init(
+    fission_nk_panel_workspace_t *host,
+    size_t index,
+    fission_nk_panel_status_t status
+)
+{
+    fission_nk_panel_entry_t *entry;
+
+    entry = &FISSION_NK_PANEL_ENTRIES(host)[index];
+    entry->init_status = status;
+    entry->init_state = (status == FISSION_NK_PANEL_STATUS_OK) ?
+        FISSION_NK_PANEL_INIT_READY :
+        FISSION_NK_PANEL_INIT_FAILED;
+}
+
+/* Collects finished worker inits; with wait set, blocks until every job is done. */
+static void fission_nk_panel_host_poll_init_jobs(fission_nk_panel_workspace_t *host, int wait)
+{
+    size_t i;
+
+    for (i = 0u; i < (size_t)FISSION_NK_PANEL_INIT_JOB_MAX; ++i) {
+        fission_nk_panel_init_job_t *job;
+
+        job = &host->init_runner.jobs[i];
+        if (job->in_use == 0) {
+            continue;
+        }
+        if (wait != 0) {
+            fission_nk_panel_wait_init_job(job);
+        }
+        if (fission_nk_atomic_load_acquire(&job->done) == 0) {
+            continue;
+        }
+        job->in_use = 0;
+        fission_nk_panel_host_finish_init(host, job->index, job->status);
+    }
+}
+
+static void fission_nk_panel_host_start_init(fission_nk_panel_workspace_t *host, size_t index)
+{
+    fission_nk_panel_init_fn init;
+    void *user_data;
+    size_t i;
+
+    init = fission_nk_panel_entry_desc(&FISSION_NK_PANEL_ENTRIES(host)[index])->init;
+    user_data = fission_nk_panel_entry_desc(&FISSION_NK_PANEL_ENTRIES(host)[index])->user_data;
+    if (host->init_runner.schedule != NULL) {
+        fission_nk_panel_init_job_t *job;
+
+        job = NULL;
+        for (i = 0u; i < (size_t)FISSION_NK_PANEL_INIT_JOB_MAX; ++i) {
+            if (host->init_runner.jobs[i].in_use == 0) {
+                job = &host->init_runner.jobs[i];
+                break;
+            }
+        }
+        if (job == NULL) {
+            /* Every job slot is busy; try again next frame. */
+            return;
+        }
+
+        job->init = init;
+        job->user_data = user_data;
+        job->index = index;
+        job->status = FISSION_NK_PANEL_STATUS_OK;
+        job->in_use = 1;
+        fission_nk_atomic_store_release(&job->claimed, 0);
+        fission_nk_atomic_store_release(&job->done, 0);
+        FISSION_NK_PANEL_ENTRIES(host)[index].init_state = FISSION_NK_PANEL_INIT_RUNNING;
+        if (
+            host->init_runner.schedule(
+                fission_nk_panel_run_init_job,
+                job,
+                host->init_runner.schedule_user_data
+            ) != 0
+        ) {
+            return;
+        }
+        job->in_use = 0;
+    }
+
+    /* init may register panels, so the entry is looked up again afterwards. */
+    fission_nk_panel_host_finish_init(host, index, init(user_data));
+}
+
+static void fission_nk_panel_host_draw_init_placeholder(
+    fission_nk_panel_workspace_t *host,
+    struct nk_context *ctx,
+    size_t index
+)
+{
+    const fission_nk_panel_entry_t *entry;
+
+    if (fission_nk_panel_host_begin_window_at(ctx, host, index, NULL, 0u, NULL) != 0) {
+        entry = &FISSION_NK_PANEL_ENTRIES(host)[index];
+        nk_layout_row_dynamic(ctx, 22.0f, 1);
+        if (entry->init_state == FISSION_NK_PANEL_INIT_FAILED) {
+            nk_labelf(
+                ctx,
+                NK_TEXT_LEFT,
+                "Initialization failed (status %d)",
+                (int)entry->init_status
+            );
+        } else {
+            nk_label(ctx, "Loading...", NK_TEXT_LEFT);
+        }
+    }
+    fission_nk_panel_host_end_window_at(ctx, host, index);
+}
+
+static void fission_nk_panel_host_draw_entry(
+    fission_nk_panel_workspace_t *host,
+    struct nk_context *ctx,
+    size_t index,
+    int window_width,
+    int window_height
+)
+{
+    fission_nk_panel_desc_t desc;
+    unsigned short generation;
+    unsigned long long start_ns;
+    unsigned long long trace_start;
+
+    if (FISSION_NK_PANEL_ENTRIES(host)[index].init_state != FISSION_NK_PANEL_INIT_READY) {
+        if (FISSION_NK_PANEL_ENTRIES(host)[index].init_state == FISSION_NK_PANEL_INIT_PENDING) {
+            fission_nk_panel_host_start_init(host, index);
+        }
+        if (FISSION_NK_PANEL_ENTRIES(host)[index].init_state != FISSION_NK_PANEL_INIT_READY) {
+            fission_nk_panel_host_draw_init_placeholder(host, ctx, index);
+            return;
+        }
+    }
+
+    /* A copy: the callback may register panels and move allocator-backed entries. */
+    desc = *fission_nk_panel_entry_desc(&FISSION_NK_PANEL_ENTRIES(host)[index]);
+    generation = FISSION_NK_PANEL_ENTRIES(host)[index].generation;
+    trace_start = FISSION_NK_PANEL_TRACE_MARK(host);
+    if (host->diagnostics.panel_stats_enabled == 0) {
+        desc.draw(
+            ctx,
+            host,
+            desc.id,
+            window_width,
+            window_height,
+            desc.user_data
+        );
+        FISSION_NK_PANEL_TRACE_PANEL(host, desc.id, trace_start);
+        return;
+    }
+
+    start_ns = fission_nk_clock_now_ns();
+    desc.draw(
+        ctx,
+        host,
+        desc.id,
+        window_width,
+        window_height,
+        desc.user_data
+    );
+    /* The callback may have unregistered its own panel. */
+    if (
+        fission_nk_panel_host_is_live(host, index) != 0 &&
+        FISSION_NK_PANEL_ENTRIES(host)[index].generation == generation
+    ) {
+        fission_nk_panel_host_record_draw_stats(
+            host,
+            ctx,
+            index,
+            fission_nk_clock_now_ns() - start_ns
+        );
+    }
+    FISSION_NK_PANEL_TRACE_PANEL(host, desc.id, trace_start);
+}
+
+/*
+ * Begins the windows of unselected tabs with NK_WINDOW_HIDDEN. Their draw callbacks do not
+ * run, but nk_clear keeps the windows, so scroll offsets and edit state survive a tab switch.
+ * Tabs never drawn have no window yet and are skipped.
+ */
+static void fission_nk_panel_host_keep_hidden_tabs(
+    fission_nk_panel_workspace_t *host,
+    struct nk_context *ctx
+)
+{
+    const fission_nk_panel_mask_word_t *visible;
+    const fission_nk_panel_mask_word_t *detached;
+    size_t mask_words;
+    size_t slot;
+    size_t w;
+
+    visible = FISSION_NK_PANEL_VISIBLE(host);
+    detached = FISSION_NK_PANEL_DETACHED(host);
+    mask_words = fission_nk_panel_host_mask_words(host);
+    for (slot = 0u; slot < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++slot) {
+        const fission_nk_panel_mask_word_t *members;
+
+        if (host->slot_tabbed[slot] == 0) {
+            continue;
+        }
+        members = FISSION_NK_PANEL_SLOT_MEMBERS(host, slot);
+        for (w = 0u; w < mask_words; ++w) {
+            fission_nk_panel_mask_word_t bits;
+
+            bits = visible[w] & ~detached[w] & members[w];
+            while (bits != 0u) {
+                fission_nk_panel_entry_t *entry;
+                struct nk_window *window;
+                size_t index;
+
+                index = w * FISSION_NK_PANEL_MASK_WORD_BITS + fission_nk_panel_mask_lowest(bits);
+                bits &= bits - 1u;
+                if (index == host->slot_active_tab[slot] || fission_nk_panel_host_is_live(host, index) == 0) {
+                    continue;
+                }
+                /* Skip windows already begun this frame, e.g. when a callback switched tabs. */
+                window = fission_nk_panel_host_cached_window(host, ctx, index);
+                if (window == NULL || window->seq == ctx->seq) {
+                    continue;
+                }
+
+                entry = &FISSION_NK_PANEL_ENTRIES(host)[index];
+                (void)nk_begin_titled(
+                    ctx,
+                    fission_nk_panel_entry_desc(entry)->id,
+                    fission_nk_panel_entry_desc(entry)->id,
+                    fission_nk_panel_bounds_to_nk_rect(&FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[index]),
+                    NK_WINDOW_BORDER | NK_WINDOW_TITLE | NK_WINDOW_BACKGROUND | NK_WINDOW_HIDDEN
+                );
+                fission_nk_panel_host_cache_window(entry, ctx, ctx->current);
+                nk_end(ctx);
+            }
+        }
+    }
+}
+
+static void fission_nk_panel_host_draw_tab_strips(
+    fission_nk_panel_workspace_t *host,
+    struct nk_context *ctx
+)
+{
+    const fission_nk_panel_mask_word_t *visible;
+    const fission_nk_panel_mask_word_t *detached;
+    size_t mask_words;
+    size_t slot;
+
+    visible = FISSION_NK_PANEL_VISIBLE(host);
+    detached = FISSION_NK_PANEL_DETACHED(host);
+    mask_words = fission_nk_panel_host_mask_words(host);
+    for (slot = 0u; slot < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++slot) {
+        const fission_nk_panel_mask_word_t *members;
+        fission_nk_overlay_style_guard_t guard;
+        char overlay_id[96];
+        char suffix[32];
+        size_t selected_index;
+        size_t tab_count;
+        size_t w;
+
+        if (
+            host->slot_tabbed[slot] == 0 ||
+            host->slot_tab_strip_bounds[slot].w <= 0.0f ||
+            host->slot_tab_strip_bounds[slot].h <= 0.0f
+        ) {
+            continue;
+        }
+
+        members = FISSION_NK_PANEL_SLOT_MEMBERS(host, slot);
+        tab_count = 0u;
+        for (w = 0u; w < mask_words; ++w) {
+            tab_count += fission_nk_panel_mask_popcount(visible[w] & ~detached[w] & members[w]);
+        }
+        if (tab_count == 0u) {
+            continue;
+        }
+
+        (void)snprintf(suffix, sizeof(suffix), "tab_strip_%u", (unsigned int)slot);
+        fission_nk_panel_overlay_id(overlay_id, sizeof(overlay_id), host, suffix);
+        selected_index = host->count;
+        fission_nk_panel_overlay_style_begin(ctx, &guard);
+        if (
+            nk_begin(
+                ctx,
+                overlay_id,
+                fission_nk_panel_bounds_to_nk_rect(&host->slot_tab_strip_bounds[slot]),
+                NK_WINDOW_NO_SCROLLBAR | NK_WINDOW_BACKGROUND
+            ) != 0
+        ) {
+            nk_layout_row_dynamic(ctx, host->slot_tab_strip_bounds[slot].h, (int)tab_count);
+            for (w = 0u; w < mask_words; ++w) {
+                fission_nk_panel_mask_word_t bits;
+
+                bits = visible[w] & ~detached[w] & members[w];
+                while (bits != 0u) {
+                    nk_bool selected;
+                    size_t i;
+
+                    i = w * FISSION_NK_PANEL_MASK_WORD_BITS + fission_nk_panel_mask_lowest(bits);
+                    bits &= bits - 1u;
+                    selected = (i == host->slot_active_tab[slot]) ? nk_true : nk_false;
+                    if (
+                        nk_selectable_label(
+                            ctx,
+                            fission_nk_panel_entry_desc(&FISSION_NK_PANEL_ENTRIES(host)[i])->title,
+                            NK_TEXT_CENTERED,
+                            &selected
+                        ) != 0
+                    ) {
+                        selected_index = i;
+                    }
+                }
+            }
+        }
+        nk_end(ctx);
+        fission_nk_panel_overlay_style_end(ctx, &guard);
+
+        if (selected_index < host->count) {
+            (void)fission_nk_panel_workspace_select_tab_at(host, selected_index);
+        }
+    }
+}
+
+void fission_nk_panel_workspace_draw_all(
+    fission_nk_panel_workspace_t *host,
+    struct nk_context *ctx,
+    int window_width,
+    int window_height
+)
+{
+    size_t i;
+    int layout_changed;
+    int drag_changed;
+    int time_draw_all;
+    unsigned long long draw_all_start_ns;
+    unsigned long long frame_start;
+    unsigned long long phase_start;
+    fission_nk_panel_mask_word_t inline_snapshot[2u * FISSION_NK_PANEL_INLINE_MASK_WORDS];
+    fission_nk_panel_mask_word_t *docked_snapshot;
+    fission_nk_panel_mask_word_t *floating_snapshot;
+    const fission_nk_panel_mask_word_t *visible;
+    const fission_nk_panel_mask_word_t *detached;
+    size_t mask_words;
+    size_t pass;
+    size_t slot;
+    size_t w;
+    float original_scroll_x;
+    float original_scroll_y;
+    size_t scroll_target_index;
+    int scroll_routing_enabled;
+    int suppress_panel_scroll;
+
+    if (host == NULL || ctx == NULL || window_width <= 0 || window_height <= 0) {
+        return;
+    }
+
+    /* Panels may toggle stats mid-frame, so latch the decision. */
+    time_draw_all = host->diagnostics.panel_stats_enabled;
+    draw_all_start_ns = 0u;
+    if (time_draw_all != 0) {
+        draw_all_start_ns = fission_nk_clock_now_ns();
+    }
+    frame_start = FISSION_NK_PANEL_TRACE_MARK(host);
+    phase_start = FISSION_NK_PANEL_TRACE_MARK(host);
+    (void)fission_nk_panel_host_ensure_layout(host, window_width, window_height);
+    FISSION_NK_PANEL_TRACE_PHASE(host, "resolve_layout", phase_start);
+
+    phase_start = FISSION_NK_PANEL_TRACE_MARK(host);
     layout_changed = fission_nk_panel_host_update_splitters(host, ctx);
+    FISSION_NK_PANEL_TRACE_PHASE(host, "update_splitters", phase_start);
     if (layout_changed != 0) {
-        (void)fission_nk_panel_host_resolve_layout(host, window_width, window_height);
+        phase_start = FISSION_NK_PANEL_TRACE_MARK(host);
+        (void)fission_nk_panel_host_ensure_layout(host, window_width, window_height);
+        FISSION_NK_PANEL_TRACE_PHASE(host, "resolve_layout", phase_start);
     }
 
+    phase_start = FISSION_NK_PANEL_TRACE_MARK(host);
     fission_nk_panel_host_begin_panel_drag(host, ctx);
-    if (fission_nk_panel_host_update_panel_drag(host, ctx) != 0) {
-        (void)fission_nk_panel_host_resolve_layout(host, window_width, window_height);
+    FISSION_NK_PANEL_TRACE_PHASE(host, "begin_panel_drag", phase_start);
+
+    phase_start = FISSION_NK_PANEL_TRACE_MARK(host);
+    drag_changed = fission_nk_panel_host_update_panel_drag(host, ctx);
+    FISSION_NK_PANEL_TRACE_PHASE(host, "update_panel_drag", phase_start);
+    if (drag_changed != 0) {
+        phase_start = FISSION_NK_PANEL_TRACE_MARK(host);
+        (void)fission_nk_panel_host_ensure_layout(host, window_width, window_height);
+        FISSION_NK_PANEL_TRACE_PHASE(host, "resolve_layout", phase_start);
     }
     if (host->dragging_panel == 0 || host->dragging_has_moved == 0) {
         fission_nk_panel_host_hide_drag_overlays(host, ctx);
     }
 
+    phase_start = FISSION_NK_PANEL_TRACE_MARK(host);
     original_scroll_x = ctx->input.mouse.scroll_delta.x;
     original_scroll_y = ctx->input.mouse.scroll_delta.y;
     suppress_panel_scroll = fission_nk_panel_host_mouse_over_ui_scroll_blocks(host, ctx);
@@ -2870,69 +4862,79 @@ void fission_nk_panel_workspace_draw_all(
             scroll_target_index < host->count
         );
     }
+    FISSION_NK_PANEL_TRACE_PHASE(host, "scroll_routing", phase_start);
 
-    for (i = 0u; i < host->count; ++i) {
-        visible_snapshot[i] = host->entries[i].state.visible;
-        detached_snapshot[i] = host->entries[i].state.detached;
-        drawn[i] = 0;
+    fission_nk_panel_host_poll_init_jobs(host, 0);
+
+    /*
+     * Docked panels draw before floating ones. Panels registered by draw callbacks this
+     * frame are not in the snapshot and are first drawn next frame.
+     */
+    mask_words = fission_nk_panel_host_mask_words(host);
+    if (host->storage.entries != NULL) {
+        docked_snapshot = host->storage.draw_scratch;
+        host->storage.in_frame = 1;
+    } else {
+        docked_snapshot = inline_snapshot;
     }
+    floating_snapshot = docked_snapshot + mask_words;
 
-    for (i = 0u; i < host->count; ++i) {
-        fission_nk_panel_entry_t *entry;
+    visible = FISSION_NK_PANEL_VISIBLE(host);
+    detached = FISSION_NK_PANEL_DETACHED(host);
+    for (w = 0u; w < mask_words; ++w) {
+        docked_snapshot[w] = visible[w] & ~detached[w];
+        floating_snapshot[w] = visible[w] & detached[w];
+    }
+    /* Tabbed slots only draw their selected panel. */
+    for (slot = 0u; slot < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++slot) {
+        const fission_nk_panel_mask_word_t *members;
+        size_t active;
 
-        entry = &host->entries[i];
-        if (visible_snapshot[i] == 0 || detached_snapshot[i] != 0) {
+        if (host->slot_tabbed[slot] == 0) {
             continue;
         }
-
-        if (scroll_routing_enabled != 0) {
-            if (i == scroll_target_index) {
-                ctx->input.mouse.scroll_delta.x = original_scroll_x;
-                ctx->input.mouse.scroll_delta.y = original_scroll_y;
-            } else {
-                ctx->input.mouse.scroll_delta.x = 0.0f;
-                ctx->input.mouse.scroll_delta.y = 0.0f;
+        members = FISSION_NK_PANEL_SLOT_MEMBERS(host, slot);
+        active = host->slot_active_tab[slot];
+        for (w = 0u; w < mask_words; ++w) {
+            fission_nk_panel_mask_word_t keep;
+
+            keep = 0u;
+            if (active / FISSION_NK_PANEL_MASK_WORD_BITS == w) {
+                keep = (fission_nk_panel_mask_word_t)1u << (active % FISSION_NK_PANEL_MASK_WORD_BITS);
             }
+            docked_snapshot[w] &= ~members[w] | keep;
         }
-
-        entry->desc.draw(
-            ctx,
-            host,
-            entry->desc.id,
-            window_width,
-            window_height,
-            entry->desc.user_data
-        );
-        drawn[i] = 1;
     }
 
-    for (i = 0u; i < host->count; ++i) {
-        fission_nk_panel_entry_t *entry;
-
-        entry = &host->entries[i];
-        if (drawn[i] != 0 || visible_snapshot[i] == 0 || detached_snapshot[i] == 0) {
-            continue;
-        }
-
-        if (scroll_routing_enabled != 0) {
-            if (i == scroll_target_index) {
-                ctx->input.mouse.scroll_delta.x = original_scroll_x;
-                ctx->input.mouse.scroll_delta.y = original_scroll_y;
-            } else {
-                ctx->input.mouse.scroll_delta.x = 0.0f;
-                ctx->input.mouse.scroll_delta.y = 0.0f;
+    for (pass = 0u; pass < 2u; ++pass) {
+        const fission_nk_panel_mask_word_t *snapshot;
+
+        snapshot = (pass == 0u) ? docked_snapshot : floating_snapshot;
+        for (w = 0u; w < mask_words; ++w) {
+            fission_nk_panel_mask_word_t bits;
+
+            bits = snapshot[w];
+            while (bits != 0u) {
+                i = w * FISSION_NK_PANEL_MASK_WORD_BITS + fission_nk_panel_mask_lowest(bits);
+                bits &= bits - 1u;
+                /* An earlier callback may have unregistered this panel. */
+                if (fission_nk_panel_host_is_live(host, i) == 0) {
+                    continue;
+                }
+
+                if (scroll_routing_enabled != 0) {
+                    if (i == scroll_target_index) {
+                        ctx->input.mouse.scroll_delta.x = original_scroll_x;
+                        ctx->input.mouse.scroll_delta.y = original_scroll_y;
+                    } else {
+                        ctx->input.mouse.scroll_delta.x = 0.0f;
+                        ctx->input.mouse.scroll_delta.y = 0.0f;
+                    }
+                }
+
+                fission_nk_panel_host_draw_entry(host, ctx, i, window_width, window_height);
             }
         }
-
-        entry->desc.draw(
-            ctx,
-            host,
-            entry->desc.id,
-            window_width,
-            window_height,
-            entry->desc.user_data
-        );
-        drawn[i] = 1;
     }
 
     if (scroll_routing_enabled != 0) {
@@ -2943,187 +4945,1115 @@ void fission_nk_panel_workspace_draw_all(
         ctx->input.mouse.scroll_delta.y = original_scroll_y;
     }
 
+    fission_nk_panel_host_keep_hidden_tabs(host, ctx);
+
+    phase_start = FISSION_NK_PANEL_TRACE_MARK(host);
+    fission_nk_panel_host_draw_tab_strips(host, ctx);
+    FISSION_NK_PANEL_TRACE_PHASE(host, "tab_strips", phase_start);
+
+    phase_start = FISSION_NK_PANEL_TRACE_MARK(host);
     fission_nk_panel_host_draw_splitter_overlays(host, ctx);
+    FISSION_NK_PANEL_TRACE_PHASE(host, "splitter_overlays", phase_start);
+
+    phase_start = FISSION_NK_PANEL_TRACE_MARK(host);
     fission_nk_panel_host_draw_drag_overlay(host, ctx);
+    FISSION_NK_PANEL_TRACE_PHASE(host, "drag_overlay", phase_start);
+
+    FISSION_NK_PANEL_TRACE_PHASE(host, "draw_all", frame_start);
+    FISSION_NK_PANEL_TRACE_END_FRAME(host);
+    FISSION_NK_PANEL_COUNTERS_END_FRAME(host);
+    fission_nk_panel_storage_end_frame(host);
+    if (time_draw_all != 0) {
+        host->diagnostics.last_draw_all_ns = fission_nk_clock_now_ns() - draw_all_start_ns;
+    }
 }
 
 void fission_nk_panel_workspace_shutdown(fission_nk_panel_workspace_t *host)
 {
-    size_t i;
+    const struct nk_allocator *allocator;
+    size_t i;
+
+    if (host == NULL) {
+        return;
+    }
+
+    fission_nk_panel_host_poll_init_jobs(host, 1);
+    for (i = host->count; i > 0u; --i) {
+        fission_nk_panel_entry_t *entry;
+
+        /* Panels whose deferred init never ran or failed have nothing to shut down. */
+        entry = &FISSION_NK_PANEL_ENTRIES(host)[i - 1u];
+        if (fission_nk_panel_host_is_live(host, i - 1u) == 0) {
+            continue;
+        }
+        if (fission_nk_panel_entry_desc(entry)->shutdown != NULL && entry->init_state == FISSION_NK_PANEL_INIT_READY) {
+            fission_nk_panel_entry_desc(entry)->shutdown(fission_nk_panel_entry_desc(entry)->user_data);
+        }
+    }
+
+    host->count = 0u;
+    host->free_head = 0u;
+    memset(&host->hot, 0, sizeof(host->hot));
+    memset(&host->id_table, 0, sizeof(host->id_table));
+    if (host->storage.allocator != NULL) {
+        fission_nk_panel_storage_free_block(&host->storage, host->storage.retired_block);
+        fission_nk_panel_storage_free_block(&host->storage, host->storage.block);
+        allocator = host->storage.allocator;
+        memset(&host->storage, 0, sizeof(host->storage));
+        host->storage.allocator = allocator;
+    }
+}
+
+size_t fission_nk_panel_workspace_count(const fission_nk_panel_workspace_t *host)
+{
+    if (host == NULL) {
+        return 0u;
+    }
+    return host->count;
+}
+
+size_t fission_nk_panel_workspace_live_count(const fission_nk_panel_workspace_t *host)
+{
+    const fission_nk_panel_mask_word_t *live;
+    size_t words;
+    size_t count;
+    size_t w;
+
+    if (host == NULL) {
+        return 0u;
+    }
+
+    live = FISSION_NK_PANEL_LIVE(host);
+    words = fission_nk_panel_host_mask_words(host);
+    count = 0u;
+    for (w = 0u; w < words; ++w) {
+        count += fission_nk_panel_mask_popcount(live[w]);
+    }
+    return count;
+}
+
+static void fission_nk_panel_host_unregister_at(fission_nk_panel_workspace_t *host, size_t index)
+{
+    fission_nk_panel_entry_t *entry;
+    fission_nk_panel_desc_t desc;
+    fission_nk_panel_init_state_t init_state;
+    unsigned short generation;
+    size_t i;
+
+    if (FISSION_NK_PANEL_ENTRIES(host)[index].init_state == FISSION_NK_PANEL_INIT_RUNNING) {
+        for (i = 0u; i < (size_t)FISSION_NK_PANEL_INIT_JOB_MAX; ++i) {
+            fission_nk_panel_init_job_t *job;
+
+            job = &host->init_runner.jobs[i];
+            if (job->in_use == 0 || job->index != index) {
+                continue;
+            }
+            fission_nk_panel_wait_init_job(job);
+            job->in_use = 0;
+            fission_nk_panel_host_finish_init(host, index, job->status);
+        }
+    }
+
+    fission_nk_panel_id_table_remove(host, index);
+    fission_nk_panel_mask_assign(FISSION_NK_PANEL_LIVE(host), index, 0);
+    fission_nk_panel_host_invalidate_layout(host);
+    fission_nk_panel_mask_assign(FISSION_NK_PANEL_VISIBLE(host), index, 0);
+    fission_nk_panel_mask_assign(FISSION_NK_PANEL_DETACHED(host), index, 0);
+    fission_nk_panel_mask_assign(
+        FISSION_NK_PANEL_SLOT_MEMBERS(host, FISSION_NK_PANEL_SLOT(host)[index]),
+        index,
+        0
+    );
+    if (host->dragging_panel != 0 && host->dragging_panel_index == index) {
+        host->dragging_panel = 0;
+        host->dragging_has_moved = 0;
+    }
+
+    /* The generation survives so the next registration here invalidates old handles. */
+    entry = &FISSION_NK_PANEL_ENTRIES(host)[index];
+    desc = *fission_nk_panel_entry_desc(entry);
+    init_state = entry->init_state;
+    generation = entry->generation;
+    memset(entry, 0, sizeof(*entry));
+    entry->generation = generation;
+    entry->next_free = host->free_head;
+    host->free_head = index + 1u;
+
+    /* Last, since shutdown may register or unregister panels itself. */
+    if (desc.shutdown != NULL && init_state == FISSION_NK_PANEL_INIT_READY) {
+        desc.shutdown(desc.user_data);
+    }
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_unregister(
+    fission_nk_panel_workspace_t *host,
+    const char *panel_id
+)
+{
+    size_t index;
+
+    if (host == NULL || panel_id == NULL) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    index = fission_nk_panel_find_index(host, panel_id);
+    if (index >= host->count) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    fission_nk_panel_host_unregister_at(host, index);
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_unregister_handle(
+    fission_nk_panel_workspace_t *host,
+    fission_nk_panel_handle_t handle
+)
+{
+    size_t index;
+
+    index = fission_nk_panel_handle_index(host, handle);
+    if (host == NULL || index >= host->count) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    fission_nk_panel_host_unregister_at(host, index);
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+/*
+ * Forgets every entry index of a workspace with no live panels: count and the free list
+ * go back to zero and the id table is emptied. Entry generations are kept, so handles
+ * from before stay stale once the entries are reused.
+ */
+static void fission_nk_panel_host_reset_entries(fission_nk_panel_workspace_t *host)
+{
+    host->count = 0u;
+    host->free_head = 0u;
+    if (host->storage.entries != NULL) {
+        memset(host->storage.id_hashes, 0, host->storage.id_table_size * sizeof(*host->storage.id_hashes));
+        memset(host->storage.id_slots, 0, host->storage.id_table_size * sizeof(*host->storage.id_slots));
+    } else {
+        memset(&host->id_table, 0, sizeof(host->id_table));
+    }
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_adopt_table(
+    fission_nk_panel_workspace_t *host,
+    const fission_nk_panel_table_t *table
+)
+{
+    fission_nk_panel_status_t status;
+    size_t i;
+    size_t j;
+
+    if (host == NULL || table == NULL || (table->rows == NULL && table->count > 0u)) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+    if (fission_nk_panel_workspace_live_count(host) != 0u) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+    if (fission_nk_panel_host_reserve(host, table->count) == 0) {
+        return FISSION_NK_PANEL_STATUS_RUNTIME_ERROR;
+    }
+    /* Row i lands at entry i, so entries left behind by unregister are dropped first. */
+    fission_nk_panel_host_reset_entries(host);
+
+    for (i = 0u; i < table->count; ++i) {
+        unsigned int hash;
+
+        (void)fission_nk_panel_host_setup_entry(host, i, &table->rows[i].desc, 1);
+        hash = table->rows[i].id_hash;
+        if (hash == 0u) {
+            hash = fission_nk_panel_id_hash(table->rows[i].desc.id);
+        }
+        fission_nk_panel_id_table_insert_hashed(host, i, hash);
+    }
+    host->count = table->count;
+    fission_nk_panel_host_touch_slots(host, 0u, table->count);
+    if (host->init_runner.lazy != 0) {
+        return FISSION_NK_PANEL_STATUS_OK;
+    }
+
+    for (i = 0u; i < table->count; ++i) {
+        if (table->rows[i].desc.init == NULL) {
+            continue;
+        }
+        status = table->rows[i].desc.init(table->rows[i].desc.user_data);
+        if (status == FISSION_NK_PANEL_STATUS_OK) {
+            continue;
+        }
+
+        /* Rows from i on never finished init, so only earlier ones get shutdown. */
+        for (j = table->count; j > 0u; --j) {
+            fission_nk_panel_entry_t *entry;
+
+            entry = &FISSION_NK_PANEL_ENTRIES(host)[j - 1u];
+            if (
+                fission_nk_panel_host_is_live(host, j - 1u) == 0 ||
+                entry->static_desc != &table->rows[j - 1u].desc
+            ) {
+                continue;
+            }
+            if (j - 1u >= i && entry->static_desc->init != NULL) {
+                entry->init_state = FISSION_NK_PANEL_INIT_FAILED;
+            }
+            fission_nk_panel_host_unregister_at(host, j - 1u);
+        }
+        /* Leave the workspace empty for a retry, unless an init registered panels of its own. */
+        if (fission_nk_panel_workspace_live_count(host) == 0u) {
+            fission_nk_panel_host_reset_entries(host);
+        }
+        return status;
+    }
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+/*
+ * Follows a next_free link (an entry index + 1, 0 ending the chain). Besides the free list,
+ * register_many chains its batch through next_free in desc order, since the field is
+ * unused while an entry is live.
+ */
+static size_t fission_nk_panel_host_next_link(const fission_nk_panel_workspace_t *host, size_t link)
+{
+    return FISSION_NK_PANEL_ENTRIES(host)[link - 1u].next_free;
+}
+
+/* Touches each slot the batch docks into once, in the order of its last panel. */
+static void fission_nk_panel_host_touch_batch_slots(
+    fission_nk_panel_workspace_t *host,
+    size_t batch_head
+)
+{
+    size_t last_seen[FISSION_NK_PANEL_SLOT_COUNT];
+    size_t position;
+    size_t link;
+    size_t s;
+
+    memset(last_seen, 0, sizeof(last_seen));
+    position = 0u;
+    for (link = batch_head; link != 0u; link = fission_nk_panel_host_next_link(host, link)) {
+        position += 1u;
+        last_seen[(size_t)FISSION_NK_PANEL_SLOT(host)[link - 1u]] = position;
+    }
+    for (;;) {
+        size_t next_slot;
+
+        next_slot = (size_t)FISSION_NK_PANEL_SLOT_COUNT;
+        for (s = 0u; s < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++s) {
+            if (
+                last_seen[s] != 0u &&
+                (next_slot == (size_t)FISSION_NK_PANEL_SLOT_COUNT || last_seen[s] < last_seen[next_slot])
+            ) {
+                next_slot = s;
+            }
+        }
+        if (next_slot == (size_t)FISSION_NK_PANEL_SLOT_COUNT) {
+            break;
+        }
+        last_seen[next_slot] = 0u;
+        fission_nk_panel_touch_slot(host, (fission_nk_panel_slot_t)next_slot);
+    }
+}
+
+/*
+ * Runs the pending inits of the batch, on the scheduler when one is set, and waits for
+ * all of them. Returns the first failure in desc order.
+ */
+static fission_nk_panel_status_t fission_nk_panel_host_run_batch_inits(
+    fission_nk_panel_workspace_t *host,
+    size_t batch_head
+)
+{
+    size_t link;
+    size_t i;
+
+    for (link = batch_head; link != 0u; link = fission_nk_panel_host_next_link(host, link)) {
+        i = link - 1u;
+        if (FISSION_NK_PANEL_ENTRIES(host)[i].init_state != FISSION_NK_PANEL_INIT_PENDING) {
+            continue;
+        }
+        fission_nk_panel_host_start_init(host, i);
+        if (FISSION_NK_PANEL_ENTRIES(host)[i].init_state == FISSION_NK_PANEL_INIT_PENDING) {
+            fission_nk_panel_host_poll_init_jobs(host, 0);
+            fission_nk_panel_host_start_init(host, i);
+        }
+        if (FISSION_NK_PANEL_ENTRIES(host)[i].init_state == FISSION_NK_PANEL_INIT_PENDING) {
+            const fission_nk_panel_desc_t *desc;
+
+            /* Every job slot is still busy; run this one here rather than wait on the scheduler. */
+            desc = fission_nk_panel_entry_desc(&FISSION_NK_PANEL_ENTRIES(host)[i]);
+            fission_nk_panel_host_finish_init(host, i, desc->init(desc->user_data));
+        }
+    }
+    fission_nk_panel_host_poll_init_jobs(host, 1);
+
+    for (link = batch_head; link != 0u; link = fission_nk_panel_host_next_link(host, link)) {
+        if (FISSION_NK_PANEL_ENTRIES(host)[link - 1u].init_state == FISSION_NK_PANEL_INIT_FAILED) {
+            return FISSION_NK_PANEL_ENTRIES(host)[link - 1u].init_status;
+        }
+    }
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+/*
+ * Unregisters a rejected batch, then drops the entries it appended from the end of the
+ * registry again: they were pushed on the free list last, so they sit at its head.
+ */
+static void fission_nk_panel_host_rollback_batch(fission_nk_panel_workspace_t *host, size_t batch_head)
+{
+    size_t link;
+
+    link = batch_head;
+    while (link != 0u) {
+        size_t next;
+
+        next = fission_nk_panel_host_next_link(host, link);
+        if (fission_nk_panel_host_is_live(host, link - 1u) != 0) {
+            fission_nk_panel_host_unregister_at(host, link - 1u);
+        }
+        link = next;
+    }
+    while (host->count > 0u && host->free_head == host->count) {
+        host->free_head = FISSION_NK_PANEL_ENTRIES(host)[host->count - 1u].next_free;
+        host->count -= 1u;
+    }
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_register_many(
+    fission_nk_panel_workspace_t *host,
+    const fission_nk_panel_desc_t *panels,
+    size_t count
+)
+{
+    fission_nk_panel_status_t status;
+    size_t free_count;
+    size_t appended;
+    size_t batch_head;
+    size_t batch_tail;
+    size_t link;
+    size_t i;
+
+    if (host == NULL || (panels == NULL && count > 0u)) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+    if (count == 0u) {
+        return FISSION_NK_PANEL_STATUS_OK;
+    }
+
+    /* Freed entries are filled first; only the rest of the batch is appended. */
+    free_count = 0u;
+    link = host->free_head;
+    while (link != 0u && free_count < count) {
+        free_count += 1u;
+        link = fission_nk_panel_host_next_link(host, link);
+    }
+    appended = count - free_count;
+    if (
+        host->count + appended < host->count ||
+        fission_nk_panel_host_reserve(host, host->count + appended) == 0
+    ) {
+        return FISSION_NK_PANEL_STATUS_RUNTIME_ERROR;
+    }
+
+    /*
+     * One pass: each desc is checked, looked up by hash against the registry (which by
+     * then holds the earlier descs of the batch) and placed. Inits are held back as
+     * PENDING so a rejected batch can be unregistered without any shutdown calls.
+     */
+    batch_head = 0u;
+    batch_tail = 0u;
+    status = FISSION_NK_PANEL_STATUS_OK;
+    for (i = 0u; i < count; ++i) {
+        const fission_nk_panel_desc_t *panel;
+        unsigned int hash;
+        size_t index;
+
+        panel = &panels[i];
+        if (panel->id == NULL || panel->title == NULL || panel->draw == NULL) {
+            status = FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+            break;
+        }
+        hash = fission_nk_panel_id_hash(panel->id);
+        if (fission_nk_panel_find_index_hashed(host, panel->id, hash) < host->count) {
+            status = FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+            break;
+        }
+
+        if (host->free_head != 0u) {
+            index = host->free_head - 1u;
+            host->free_head = FISSION_NK_PANEL_ENTRIES(host)[index].next_free;
+        } else {
+            index = host->count;
+            host->count += 1u;
+        }
+        (void)fission_nk_panel_host_setup_entry(host, index, panel, 0);
+        if (panel->init != NULL) {
+            FISSION_NK_PANEL_ENTRIES(host)[index].init_state = FISSION_NK_PANEL_INIT_PENDING;
+        }
+        fission_nk_panel_id_table_insert_hashed(host, index, hash);
+        if (batch_tail == 0u) {
+            batch_head = index + 1u;
+        } else {
+            FISSION_NK_PANEL_ENTRIES(host)[batch_tail - 1u].next_free = index + 1u;
+        }
+        batch_tail = index + 1u;
+    }
+
+    if (status == FISSION_NK_PANEL_STATUS_OK && host->init_runner.lazy == 0) {
+        status = fission_nk_panel_host_run_batch_inits(host, batch_head);
+    }
+    if (status != FISSION_NK_PANEL_STATUS_OK) {
+        fission_nk_panel_host_rollback_batch(host, batch_head);
+        return status;
+    }
+
+    fission_nk_panel_host_touch_batch_slots(host, batch_head);
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+size_t fission_nk_panel_workspace_visible_count(const fission_nk_panel_workspace_t *host)
+{
+    const fission_nk_panel_mask_word_t *visible;
+    size_t words;
+    size_t count;
+    size_t w;
+
+    if (host == NULL) {
+        return 0u;
+    }
+
+    visible = FISSION_NK_PANEL_VISIBLE(host);
+    words = fission_nk_panel_host_mask_words(host);
+    count = 0u;
+    for (w = 0u; w < words; ++w) {
+        count += fission_nk_panel_mask_popcount(visible[w]);
+    }
+    return count;
+}
+
+const char *fission_nk_panel_workspace_panel_id_at(
+    const fission_nk_panel_workspace_t *host,
+    size_t index
+)
+{
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
+        return NULL;
+    }
+    return fission_nk_panel_entry_desc(&FISSION_NK_PANEL_ENTRIES(host)[index])->id;
+}
+
+const char *fission_nk_panel_workspace_panel_title_at(
+    const fission_nk_panel_workspace_t *host,
+    size_t index
+)
+{
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
+        return NULL;
+    }
+    return fission_nk_panel_entry_desc(&FISSION_NK_PANEL_ENTRIES(host)[index])->title;
+}
+
+int fission_nk_panel_workspace_panel_is_visible_at(
+    const fission_nk_panel_workspace_t *host,
+    size_t index
+)
+{
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
+        return 0;
+    }
+    return fission_nk_panel_mask_test(FISSION_NK_PANEL_VISIBLE(host), index);
+}
+
+int fission_nk_panel_workspace_panel_is_detached_at(
+    const fission_nk_panel_workspace_t *host,
+    size_t index
+)
+{
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
+        return 0;
+    }
+    return fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), index);
+}
+
+int fission_nk_panel_workspace_panel_is_detachable_at(
+    const fission_nk_panel_workspace_t *host,
+    size_t index
+)
+{
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
+        return 0;
+    }
+    return FISSION_NK_PANEL_ENTRIES(host)[index].state.detachable;
+}
+
+fission_nk_panel_slot_t fission_nk_panel_workspace_panel_slot_at(
+    const fission_nk_panel_workspace_t *host,
+    size_t index
+)
+{
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
+        return FISSION_NK_PANEL_SLOT_CENTER;
+    }
+    return (fission_nk_panel_slot_t)FISSION_NK_PANEL_SLOT(host)[index];
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_set_panel_visible_at(
+    fission_nk_panel_workspace_t *host,
+    size_t index,
+    int visible
+)
+{
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    if (fission_nk_panel_mask_test(FISSION_NK_PANEL_VISIBLE(host), index) != (visible != 0)) {
+        fission_nk_panel_host_invalidate_layout(host);
+    }
+    fission_nk_panel_mask_assign(FISSION_NK_PANEL_VISIBLE(host), index, visible);
+    if (visible != 0) {
+        (void)fission_nk_panel_workspace_select_tab_at(host, index);
+    }
+    if (fission_nk_panel_mask_test(FISSION_NK_PANEL_VISIBLE(host), index) == 0) {
+        fission_nk_panel_mask_assign(FISSION_NK_PANEL_DETACHED(host), index, 0);
+        if (host->dragging_panel != 0 && host->dragging_panel_index == index) {
+            host->dragging_panel = 0;
+            host->dragging_has_moved = 0;
+        }
+    }
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_set_panel_detached_at(
+    fission_nk_panel_workspace_t *host,
+    size_t index,
+    int detached
+)
+{
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    if (detached != 0 && FISSION_NK_PANEL_ENTRIES(host)[index].state.detachable == 0) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    if (fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), index) != (detached != 0)) {
+        fission_nk_panel_host_invalidate_layout(host);
+    }
+    fission_nk_panel_mask_assign(FISSION_NK_PANEL_DETACHED(host), index, detached);
+    if (fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), index) != 0) {
+        fission_nk_panel_sanitize_detached_bounds(host, &FISSION_NK_PANEL_ENTRIES(host)[index].state.detached_bounds);
+    }
+    if (host->dragging_panel != 0 && host->dragging_panel_index == index) {
+        host->dragging_panel = 0;
+        host->dragging_has_moved = 0;
+    }
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_set_panel_slot_at(
+    fission_nk_panel_workspace_t *host,
+    size_t index,
+    fission_nk_panel_slot_t slot
+)
+{
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    if (fission_nk_panel_slot_is_valid(slot) == 0) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    fission_nk_panel_mask_assign(
+        FISSION_NK_PANEL_SLOT_MEMBERS(host, FISSION_NK_PANEL_SLOT(host)[index]),
+        index,
+        0
+    );
+    FISSION_NK_PANEL_SLOT(host)[index] = (unsigned char)slot;
+    fission_nk_panel_mask_assign(FISSION_NK_PANEL_SLOT_MEMBERS(host, slot), index, 1);
+    fission_nk_panel_touch_slot(host, slot);
+    (void)fission_nk_panel_workspace_select_tab_at(host, index);
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_set_slot_tabbed(
+    fission_nk_panel_workspace_t *host,
+    fission_nk_panel_slot_t slot,
+    int tabbed
+)
+{
+    if (host == NULL || fission_nk_panel_slot_is_valid(slot) == 0) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    if (host->slot_tabbed[(size_t)slot] != (tabbed != 0)) {
+        host->slot_tabbed[(size_t)slot] = (unsigned char)(tabbed != 0);
+        fission_nk_panel_host_invalidate_layout(host);
+    }
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+int fission_nk_panel_workspace_slot_is_tabbed(
+    const fission_nk_panel_workspace_t *host,
+    fission_nk_panel_slot_t slot
+)
+{
+    if (host == NULL || fission_nk_panel_slot_is_valid(slot) == 0) {
+        return 0;
+    }
+    return host->slot_tabbed[(size_t)slot];
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_select_tab_at(
+    fission_nk_panel_workspace_t *host,
+    size_t index
+)
+{
+    size_t slot;
+
+    if (
+        fission_nk_panel_host_is_live(host, index) == 0 ||
+        fission_nk_panel_mask_test(FISSION_NK_PANEL_VISIBLE(host), index) == 0 ||
+        fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), index) != 0
+    ) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    slot = (size_t)FISSION_NK_PANEL_SLOT(host)[index];
+    if (host->slot_tabbed[slot] != 0 && host->slot_active_tab[slot] != index) {
+        host->slot_active_tab[slot] = index;
+        fission_nk_panel_host_invalidate_layout(host);
+    }
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+size_t fission_nk_panel_workspace_slot_active_tab(
+    const fission_nk_panel_workspace_t *host,
+    fission_nk_panel_slot_t slot
+)
+{
+    size_t active;
+
+    if (host == NULL) {
+        return 0u;
+    }
+    if (fission_nk_panel_slot_is_valid(slot) == 0 || host->slot_tabbed[(size_t)slot] == 0) {
+        return host->count;
+    }
+
+    active = host->slot_active_tab[(size_t)slot];
+    if (
+        fission_nk_panel_host_is_live(host, active) == 0 ||
+        fission_nk_panel_mask_test(FISSION_NK_PANEL_VISIBLE(host), active) == 0 ||
+        fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), active) != 0 ||
+        (size_t)FISSION_NK_PANEL_SLOT(host)[active] != (size_t)slot
+    ) {
+        return host->count;
+    }
+    return active;
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_get_panel_bounds(
+    const fission_nk_panel_workspace_t *host,
+    const char *panel_id,
+    fission_nk_panel_bounds_t *out_bounds
+)
+{
+    size_t index;
+
+    if (host == NULL || panel_id == NULL || out_bounds == NULL) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    index = fission_nk_panel_find_index(host, panel_id);
+    if (index >= host->count) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    *out_bounds = FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[index];
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+unsigned int fission_nk_panel_workspace_layout_generation(const fission_nk_panel_workspace_t *host)
+{
+    if (host == NULL) {
+        return 0u;
+    }
+    return host->layout_generation;
+}
+
+int fission_nk_panel_workspace_layout_dirty(const fission_nk_panel_workspace_t *host)
+{
+    if (host == NULL) {
+        return 0;
+    }
+    return host->layout_dirty;
+}
+
+void fission_nk_panel_workspace_invalidate_layout(fission_nk_panel_workspace_t *host)
+{
+    if (host == NULL) {
+        return;
+    }
+    fission_nk_panel_host_invalidate_layout(host);
+}
+
+void fission_nk_panel_workspace_set_dock_tree(
+    fission_nk_panel_workspace_t *host,
+    struct fission_nk_dock_tree *tree
+)
+{
+    if (host == NULL || host->dock_tree == tree) {
+        return;
+    }
+    host->dock_tree = tree;
+    if (host->active_splitter >= FISSION_NK_PANEL_SPLITTER_TREE) {
+        host->active_splitter = FISSION_NK_PANEL_SPLITTER_NONE;
+    }
+    if (host->hovered_splitter >= FISSION_NK_PANEL_SPLITTER_TREE) {
+        host->hovered_splitter = FISSION_NK_PANEL_SPLITTER_NONE;
+    }
+    fission_nk_panel_host_invalidate_layout(host);
+}
+
+struct fission_nk_dock_tree *fission_nk_panel_workspace_dock_tree(const fission_nk_panel_workspace_t *host)
+{
+    if (host == NULL) {
+        return NULL;
+    }
+    return host->dock_tree;
+}
+
+void fission_nk_panel_workspace_enable_layout_cache(fission_nk_panel_workspace_t *host, int enabled)
+{
+    size_t i;
+
+    if (host == NULL) {
+        return;
+    }
+
+    host->layout_cache.disabled = (enabled == 0);
+    if (enabled == 0) {
+        for (i = 0u; i < (size_t)FISSION_NK_PANEL_LAYOUT_CACHE_SIZE; ++i) {
+            host->layout_cache.entries[i].valid = 0;
+        }
+    }
+}
+
+void fission_nk_panel_workspace_get_layout_cache_stats(
+    const fission_nk_panel_workspace_t *host,
+    unsigned long long *out_hits,
+    unsigned long long *out_misses
+)
+{
+    if (out_hits != NULL) {
+        *out_hits = (host != NULL) ? host->layout_cache.hits : 0u;
+    }
+    if (out_misses != NULL) {
+        *out_misses = (host != NULL) ? host->layout_cache.misses : 0u;
+    }
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_get_layout_input(
+    const fission_nk_panel_workspace_t *host,
+    int window_width,
+    int window_height,
+    fission_nk_panel_layout_input_t *out_input
+)
+{
+    const fission_nk_panel_mask_word_t *visible;
+    const fission_nk_panel_mask_word_t *detached;
+    size_t mask_words;
+    size_t slot;
 
-    if (host == NULL) {
-        return;
+    if (host == NULL || out_input == NULL) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
     }
 
-    for (i = host->count; i > 0u; --i) {
-        fission_nk_panel_desc_t *desc;
+    fission_nk_panel_host_layout_input(host, window_width, window_height, out_input);
+    visible = FISSION_NK_PANEL_VISIBLE(host);
+    detached = FISSION_NK_PANEL_DETACHED(host);
+    mask_words = fission_nk_panel_host_mask_words(host);
+    for (slot = 0u; slot < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++slot) {
+        const fission_nk_panel_mask_word_t *members;
+        size_t count;
+        size_t w;
 
-        desc = &host->entries[i - 1u].desc;
-        if (desc->shutdown != NULL) {
-            desc->shutdown(desc->user_data);
+        members = FISSION_NK_PANEL_SLOT_MEMBERS(host, slot);
+        count = 0u;
+        for (w = 0u; w < mask_words; ++w) {
+            count += fission_nk_panel_mask_popcount(visible[w] & ~detached[w] & members[w]);
+        }
+        if (host->slot_tabbed[slot] != 0 && count > 0u) {
+            count = 1u;
         }
+        out_input->slot_counts[slot] = count;
     }
-
-    host->count = 0u;
+    return FISSION_NK_PANEL_STATUS_OK;
 }
 
-size_t fission_nk_panel_workspace_count(const fission_nk_panel_workspace_t *host)
+fission_nk_panel_handle_t fission_nk_panel_workspace_find_handle(
+    const fission_nk_panel_workspace_t *host,
+    const char *panel_id
+)
 {
-    if (host == NULL) {
-        return 0u;
+    size_t index;
+
+    index = fission_nk_panel_find_index(host, panel_id);
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
+        return FISSION_NK_PANEL_HANDLE_NONE;
     }
-    return host->count;
+    return fission_nk_panel_make_handle(index, FISSION_NK_PANEL_ENTRIES(host)[index].generation);
 }
 
-const char *fission_nk_panel_workspace_panel_id_at(
+fission_nk_panel_handle_t fission_nk_panel_workspace_handle_at(
     const fission_nk_panel_workspace_t *host,
     size_t index
 )
 {
-    if (host == NULL || index >= host->count) {
-        return NULL;
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
+        return FISSION_NK_PANEL_HANDLE_NONE;
     }
-    return host->entries[index].desc.id;
+    return fission_nk_panel_make_handle(index, FISSION_NK_PANEL_ENTRIES(host)[index].generation);
 }
 
-const char *fission_nk_panel_workspace_panel_title_at(
+fission_nk_panel_status_t fission_nk_panel_workspace_get_panel_bounds_handle(
     const fission_nk_panel_workspace_t *host,
-    size_t index
+    fission_nk_panel_handle_t handle,
+    fission_nk_panel_bounds_t *out_bounds
 )
 {
-    if (host == NULL || index >= host->count) {
-        return NULL;
+    size_t index;
+
+    if (host == NULL || out_bounds == NULL) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+
+    index = fission_nk_panel_handle_index(host, handle);
+    if (index >= host->count) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
     }
-    return host->entries[index].desc.title;
+
+    *out_bounds = FISSION_NK_PANEL_RESOLVED_BOUNDS(host)[index];
+    return FISSION_NK_PANEL_STATUS_OK;
 }
 
-int fission_nk_panel_workspace_panel_is_visible_at(
+int fission_nk_panel_workspace_panel_is_visible_handle(
     const fission_nk_panel_workspace_t *host,
-    size_t index
+    fission_nk_panel_handle_t handle
 )
 {
-    if (host == NULL || index >= host->count) {
+    size_t index;
+
+    index = fission_nk_panel_handle_index(host, handle);
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
         return 0;
     }
-    return host->entries[index].state.visible;
+    return fission_nk_panel_mask_test(FISSION_NK_PANEL_VISIBLE(host), index);
 }
 
-int fission_nk_panel_workspace_panel_is_detached_at(
+int fission_nk_panel_workspace_panel_is_detached_handle(
     const fission_nk_panel_workspace_t *host,
-    size_t index
+    fission_nk_panel_handle_t handle
 )
 {
-    if (host == NULL || index >= host->count) {
+    size_t index;
+
+    index = fission_nk_panel_handle_index(host, handle);
+    if (fission_nk_panel_host_is_live(host, index) == 0) {
         return 0;
     }
-    return host->entries[index].state.detached;
+    return fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), index);
 }
 
-int fission_nk_panel_workspace_panel_is_detachable_at(
-    const fission_nk_panel_workspace_t *host,
-    size_t index
+fission_nk_panel_status_t fission_nk_panel_workspace_set_panel_visible_handle(
+    fission_nk_panel_workspace_t *host,
+    fission_nk_panel_handle_t handle,
+    int visible
 )
 {
-    if (host == NULL || index >= host->count) {
-        return 0;
-    }
-    return host->entries[index].state.detachable;
+    return fission_nk_panel_workspace_set_panel_visible_at(
+        host,
+        fission_nk_panel_handle_index(host, handle),
+        visible
+    );
 }
 
-fission_nk_panel_slot_t fission_nk_panel_workspace_panel_slot_at(
-    const fission_nk_panel_workspace_t *host,
-    size_t index
+fission_nk_panel_status_t fission_nk_panel_workspace_set_panel_detached_handle(
+    fission_nk_panel_workspace_t *host,
+    fission_nk_panel_handle_t handle,
+    int detached
 )
 {
-    if (host == NULL || index >= host->count) {
-        return FISSION_NK_PANEL_SLOT_CENTER;
-    }
-    return host->entries[index].state.slot;
+    return fission_nk_panel_workspace_set_panel_detached_at(
+        host,
+        fission_nk_panel_handle_index(host, handle),
+        detached
+    );
 }
 
-fission_nk_panel_status_t fission_nk_panel_workspace_set_panel_visible_at(
+fission_nk_panel_status_t fission_nk_panel_workspace_set_panel_detached_bounds_handle(
     fission_nk_panel_workspace_t *host,
-    size_t index,
-    int visible
+    fission_nk_panel_handle_t handle,
+    const fission_nk_panel_bounds_t *bounds
 )
 {
-    if (host == NULL || index >= host->count) {
+    size_t index;
+
+    if (host == NULL || bounds == NULL) {
         return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
     }
 
-    host->entries[index].state.visible = (visible != 0) ? 1 : 0;
-    if (host->entries[index].state.visible == 0) {
-        host->entries[index].state.detached = 0;
-        if (host->dragging_panel != 0 && host->dragging_panel_index == index) {
-            host->dragging_panel = 0;
-            host->dragging_has_moved = 0;
-        }
+    index = fission_nk_panel_handle_index(host, handle);
+    if (index >= host->count) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
     }
+
+    FISSION_NK_PANEL_ENTRIES(host)[index].state.detached_bounds = *bounds;
+    fission_nk_panel_sanitize_detached_bounds(host, &FISSION_NK_PANEL_ENTRIES(host)[index].state.detached_bounds);
+    fission_nk_panel_host_invalidate_layout(host);
     return FISSION_NK_PANEL_STATUS_OK;
 }
 
-fission_nk_panel_status_t fission_nk_panel_workspace_set_panel_detached_at(
+void fission_nk_panel_workspace_enable_panel_stats(
     fission_nk_panel_workspace_t *host,
-    size_t index,
-    int detached
+    int enabled,
+    const fission_nk_convert_buffers_t *convert
 )
 {
-    if (host == NULL || index >= host->count) {
-        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    if (host == NULL) {
+        return;
     }
 
-    if (detached != 0 && host->entries[index].state.detachable == 0) {
-        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    host->diagnostics.panel_stats_enabled = (enabled != 0) ? 1 : 0;
+    if (convert != NULL) {
+        host->diagnostics.panel_stats_convert = *convert;
+    } else {
+        memset(&host->diagnostics.panel_stats_convert, 0, sizeof(host->diagnostics.panel_stats_convert));
     }
+}
 
-    host->entries[index].state.detached = (detached != 0) ? 1 : 0;
-    if (host->entries[index].state.detached != 0) {
-        fission_nk_panel_sanitize_detached_bounds(host, &host->entries[index].state.detached_bounds);
+int fission_nk_panel_workspace_panel_stats_enabled(const fission_nk_panel_workspace_t *host)
+{
+    if (host == NULL) {
+        return 0;
     }
-    if (host->dragging_panel != 0 && host->dragging_panel_index == index) {
-        host->dragging_panel = 0;
-        host->dragging_has_moved = 0;
+    return host->diagnostics.panel_stats_enabled;
+}
+
+unsigned long long fission_nk_panel_workspace_last_draw_all_ns(
+    const fission_nk_panel_workspace_t *host
+)
+{
+    if (host == NULL) {
+        return 0u;
     }
-    return FISSION_NK_PANEL_STATUS_OK;
+    return host->diagnostics.last_draw_all_ns;
 }
 
-fission_nk_panel_status_t fission_nk_panel_workspace_set_panel_slot_at(
+void fission_nk_panel_workspace_set_trace(
     fission_nk_panel_workspace_t *host,
-    size_t index,
-    fission_nk_panel_slot_t slot
+    fission_nk_trace_t *trace
 )
 {
-    if (host == NULL || index >= host->count) {
-        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    if (host == NULL) {
+        return;
     }
+    host->diagnostics.trace = trace;
+}
 
-    if (fission_nk_panel_slot_is_valid(slot) == 0) {
-        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+int fission_nk_panel_counters_instrumentation_enabled(void)
+{
+#if defined(FISSION_NK_ENABLE_COUNTERS)
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+void fission_nk_panel_counters_reset(fission_nk_panel_counters_t *counters)
+{
+    if (counters == NULL) {
+        return;
     }
+    memset(counters, 0, sizeof(*counters));
+}
 
-    host->entries[index].state.slot = slot;
-    fission_nk_panel_touch_slot(host, slot);
-    return FISSION_NK_PANEL_STATUS_OK;
+const char *fission_nk_panel_counter_name(fission_nk_panel_counter_t counter)
+{
+    switch (counter) {
+    case FISSION_NK_PANEL_COUNTER_PANEL_LOOKUPS:
+        return "panel_lookups";
+    case FISSION_NK_PANEL_COUNTER_PANEL_ID_COMPARES:
+        return "panel_id_compares";
+    case FISSION_NK_PANEL_COUNTER_WINDOW_LOOKUPS:
+        return "window_lookups";
+    case FISSION_NK_PANEL_COUNTER_WINDOW_LIST_STEPS:
+        return "window_list_steps";
+    case FISSION_NK_PANEL_COUNTER_WINDOW_NAME_COMPARES:
+        return "window_name_compares";
+    case FISSION_NK_PANEL_COUNTER_ID_FORMATS:
+        return "id_formats";
+    default:
+        break;
+    }
+    return "unknown";
 }
 
-fission_nk_panel_status_t fission_nk_panel_workspace_get_panel_bounds(
+void fission_nk_panel_workspace_set_counters(
+    fission_nk_panel_workspace_t *host,
+    fission_nk_panel_counters_t *counters
+)
+{
+    if (host == NULL) {
+        return;
+    }
+    host->diagnostics.counters = counters;
+}
+
+void fission_nk_panel_workspace_reset_panel_stats(fission_nk_panel_workspace_t *host)
+{
+    size_t i;
+
+    if (host == NULL) {
+        return;
+    }
+
+    for (i = 0u; i < host->count; ++i) {
+        memset(&FISSION_NK_PANEL_ENTRIES(host)[i].stats, 0, sizeof(FISSION_NK_PANEL_ENTRIES(host)[i].stats));
+    }
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_get_panel_stats(
     const fission_nk_panel_workspace_t *host,
     const char *panel_id,
-    fission_nk_panel_bounds_t *out_bounds
+    fission_nk_panel_stats_t *out_stats
 )
 {
     size_t index;
 
-    if (host == NULL || panel_id == NULL || out_bounds == NULL) {
+    if (host == NULL || panel_id == NULL || out_stats == NULL) {
         return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
     }
 
     index = fission_nk_panel_find_index(host, panel_id);
-    if (index >= host->count) {
+    return fission_nk_panel_workspace_get_panel_stats_at(host, index, out_stats);
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_get_panel_stats_at(
+    const fission_nk_panel_workspace_t *host,
+    size_t index,
+    fission_nk_panel_stats_t *out_stats
+)
+{
+    if (out_stats == NULL || fission_nk_panel_host_is_live(host, index) == 0) {
         return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
     }
 
-    *out_bounds = host->entries[index].state.resolved_bounds;
+    *out_stats = FISSION_NK_PANEL_ENTRIES(host)[index].stats.published;
     return FISSION_NK_PANEL_STATUS_OK;
 }
 
@@ -3143,7 +6073,7 @@ int fission_nk_panel_workspace_panel_is_detached(
         return 0;
     }
 
-    return host->entries[index].state.detached;
+    return fission_nk_panel_mask_test(FISSION_NK_PANEL_DETACHED(host), index);
 }
 
 int fission_nk_panel_workspace_panel_is_detachable(
@@ -3162,7 +6092,7 @@ int fission_nk_panel_workspace_panel_is_detachable(
         return 0;
     }
 
-    return host->entries[index].state.detachable;
+    return FISSION_NK_PANEL_ENTRIES(host)[index].state.detachable;
 }
 
 int fission_nk_panel_workspace_panel_is_visible(
@@ -3181,7 +6111,7 @@ int fission_nk_panel_workspace_panel_is_visible(
         return 0;
     }
 
-    return host->entries[index].state.visible;
+    return fission_nk_panel_mask_test(FISSION_NK_PANEL_VISIBLE(host), index);
 }
 
 fission_nk_panel_status_t fission_nk_panel_workspace_set_panel_detached(
@@ -3221,8 +6151,9 @@ void fission_nk_panel_workspace_set_panel_detached_bounds(
         return;
     }
 
-    host->entries[index].state.detached_bounds = *bounds;
-    fission_nk_panel_sanitize_detached_bounds(host, &host->entries[index].state.detached_bounds);
+    FISSION_NK_PANEL_ENTRIES(host)[index].state.detached_bounds = *bounds;
+    fission_nk_panel_sanitize_detached_bounds(host, &FISSION_NK_PANEL_ENTRIES(host)[index].state.detached_bounds);
+    fission_nk_panel_host_invalidate_layout(host);
 }
 
 void fission_nk_panel_workspace_get_column_ratios(
@@ -3264,6 +6195,9 @@ void fission_nk_panel_workspace_set_column_ratios(
         right_ratio *= scale;
     }
 
+    if (host->left_column_ratio != left_ratio || host->right_column_ratio != right_ratio) {
+        fission_nk_panel_host_invalidate_layout(host);
+    }
     host->left_column_ratio = left_ratio;
     host->right_column_ratio = right_ratio;
 }
@@ -3307,6 +6241,9 @@ void fission_nk_panel_workspace_set_row_ratios(
         bottom_ratio *= scale;
     }
 
+    if (host->top_row_ratio != top_ratio || host->bottom_row_ratio != bottom_ratio) {
+        fission_nk_panel_host_invalidate_layout(host);
+    }
     host->top_row_ratio = top_ratio;
     host->bottom_row_ratio = bottom_ratio;
 }
@@ -3332,28 +6269,32 @@ static float fission_nk_panel_menu_dim_or_default(float value, float fallback)
 
 void fission_nk_panel_workspace_show_all(fission_nk_panel_workspace_t *host)
 {
-    size_t i;
-
     if (host == NULL) {
         return;
     }
 
-    for (i = 0u; i < host->count; ++i) {
-        (void)fission_nk_panel_workspace_set_panel_visible_at(host, i, 1);
-    }
+    memcpy(
+        FISSION_NK_PANEL_VISIBLE(host),
+        FISSION_NK_PANEL_LIVE(host),
+        fission_nk_panel_host_mask_words(host) * sizeof(fission_nk_panel_mask_word_t)
+    );
+    fission_nk_panel_host_invalidate_layout(host);
 }
 
 void fission_nk_panel_workspace_hide_all(fission_nk_panel_workspace_t *host)
 {
-    size_t i;
+    size_t words;
 
     if (host == NULL) {
         return;
     }
 
-    for (i = 0u; i < host->count; ++i) {
-        (void)fission_nk_panel_workspace_set_panel_visible_at(host, i, 0);
-    }
+    words = fission_nk_panel_host_mask_words(host);
+    fission_nk_panel_mask_fill(FISSION_NK_PANEL_VISIBLE(host), words, 0u);
+    fission_nk_panel_mask_fill(FISSION_NK_PANEL_DETACHED(host), words, 0u);
+    fission_nk_panel_host_invalidate_layout(host);
+    host->dragging_panel = 0;
+    host->dragging_has_moved = 0;
 }
 
 void fission_nk_panel_workspace_draw_window_menu(
@@ -3488,13 +6429,8 @@ void fission_nk_panel_workspace_draw_panels_menu(
     }
     fission_nk_panel_focus_root_window_on_scroll(ctx);
 
-    visible_count = 0;
+    visible_count = (int)fission_nk_panel_workspace_visible_count(host);
     total_count = (int)fission_nk_panel_workspace_count(host);
-    for (i = 0u; i < host->count; ++i) {
-        if (fission_nk_panel_workspace_panel_is_visible_at(host, i) != 0) {
-            visible_count += 1;
-        }
-    }
 
     nk_layout_row_dynamic(ctx, 22.0f, 1);
     nk_labelf(ctx, NK_TEXT_LEFT, "Visible: %d / %d", visible_count, total_count);
@@ -3516,6 +6452,7 @@ void fission_nk_panel_workspace_draw_panels_menu(
     if (list_height < 40.0f) {
         list_height = 40.0f;
     }
+    FISSION_NK_PANEL_COUNT(host, FISSION_NK_PANEL_COUNTER_ID_FORMATS, 1u);
     (void)snprintf(list_group_id, sizeof(list_group_id), "__fission_panels_menu_list_%p", (void *)host);
 
     nk_layout_row_dynamic(ctx, list_height, 1);
@@ -3536,6 +6473,7 @@ void fission_nk_panel_workspace_draw_panels_menu(
             visible = fission_nk_panel_workspace_panel_is_visible_at(host, i);
             detached = fission_nk_panel_workspace_panel_is_detached_at(host, i);
 
+            FISSION_NK_PANEL_COUNT(host, FISSION_NK_PANEL_COUNTER_ID_FORMATS, 1u);
             (void)snprintf(
                 label,
                 sizeof(label),
@@ -3776,6 +6714,119 @@ static void fission_nk_panel_workspace_tabs_make_default_name(
     (void)snprintf(out_name, out_name_size, "Workspace %u", ordinal);
 }
 
+/* Tab layouts are sized for the inline registry. */
+static int fission_nk_panel_workspace_tabs_supported(const fission_nk_panel_workspace_t *workspace)
+{
+    return workspace->storage.allocator == NULL;
+}
+
+static void fission_nk_panel_workspace_tabs_capture(
+    fission_nk_panel_tab_layout_t *layout,
+    const fission_nk_panel_workspace_t *workspace
+)
+{
+    size_t i;
+
+    memset(layout, 0, sizeof(*layout));
+    layout->left_column_ratio = workspace->left_column_ratio;
+    layout->right_column_ratio = workspace->right_column_ratio;
+    layout->top_row_ratio = workspace->top_row_ratio;
+    layout->bottom_row_ratio = workspace->bottom_row_ratio;
+    memcpy(layout->slot_touch_serial, workspace->slot_touch_serial, sizeof(layout->slot_touch_serial));
+    layout->next_slot_touch_serial = workspace->next_slot_touch_serial;
+    memcpy(layout->slot_tabbed, workspace->slot_tabbed, sizeof(layout->slot_tabbed));
+    memcpy(layout->slot_active_tab, workspace->slot_active_tab, sizeof(layout->slot_active_tab));
+    memcpy(layout->visible, workspace->hot.visible, sizeof(layout->visible));
+    memcpy(layout->detached, workspace->hot.detached, sizeof(layout->detached));
+    memcpy(layout->slot, workspace->hot.slot, sizeof(layout->slot));
+    for (i = 0u; i < workspace->count; ++i) {
+        if (fission_nk_panel_mask_test(workspace->hot.live, i) == 0) {
+            continue;
+        }
+        layout->generation[i] = workspace->entries[i].generation;
+        layout->detached_bounds[i] = workspace->entries[i].state.detached_bounds;
+    }
+}
+
+static void fission_nk_panel_workspace_tabs_apply(
+    const fission_nk_panel_tab_layout_t *layout,
+    fission_nk_panel_workspace_t *workspace
+)
+{
+    fission_nk_panel_hot_state_t *hot;
+    size_t w;
+    size_t i;
+
+    hot = &workspace->hot;
+    workspace->left_column_ratio = layout->left_column_ratio;
+    workspace->right_column_ratio = layout->right_column_ratio;
+    workspace->top_row_ratio = layout->top_row_ratio;
+    workspace->bottom_row_ratio = layout->bottom_row_ratio;
+    memcpy(workspace->slot_touch_serial, layout->slot_touch_serial, sizeof(workspace->slot_touch_serial));
+    workspace->next_slot_touch_serial = layout->next_slot_touch_serial;
+    memcpy(workspace->slot_tabbed, layout->slot_tabbed, sizeof(workspace->slot_tabbed));
+    memcpy(workspace->slot_active_tab, layout->slot_active_tab, sizeof(workspace->slot_active_tab));
+
+    for (w = 0u; w < FISSION_NK_PANEL_INLINE_MASK_WORDS; ++w) {
+        hot->visible[w] = layout->visible[w] & hot->live[w];
+        hot->detached[w] = layout->detached[w] & hot->live[w];
+    }
+    memset(hot->slot_members, 0, sizeof(hot->slot_members));
+    for (i = 0u; i < workspace->count; ++i) {
+        if (fission_nk_panel_mask_test(hot->live, i) == 0) {
+            continue;
+        }
+        if (layout->generation[i] == workspace->entries[i].generation) {
+            hot->slot[i] = layout->slot[i];
+            workspace->entries[i].state.detached_bounds = layout->detached_bounds[i];
+        } else {
+            fission_nk_panel_mask_assign(hot->visible, i, 0);
+            fission_nk_panel_mask_assign(hot->detached, i, 0);
+        }
+        fission_nk_panel_mask_assign(hot->slot_members[hot->slot[i]], i, 1);
+    }
+
+    fission_nk_panel_host_invalidate_layout(workspace);
+    workspace->active_splitter = FISSION_NK_PANEL_SPLITTER_NONE;
+    workspace->hovered_splitter = FISSION_NK_PANEL_SPLITTER_NONE;
+    workspace->dragging_panel = 0;
+    workspace->dragging_has_moved = 0;
+}
+
+/*
+ * Gives entries [first, first + count) their current workspace placement, minus
+ * detachment, in every tab: newly registered panels start out the same in all tabs.
+ */
+static void fission_nk_panel_workspace_tabs_seed_range(
+    fission_nk_panel_workspace_tabs_t *tabs,
+    const fission_nk_panel_workspace_t *workspace,
+    size_t first,
+    size_t count
+)
+{
+    size_t t;
+    size_t i;
+
+    for (t = 0u; t < tabs->tab_count; ++t) {
+        fission_nk_panel_tab_layout_t *layout;
+
+        layout = &tabs->layouts[t];
+        for (i = first; i < first + count; ++i) {
+            fission_nk_panel_mask_assign(
+                layout->visible,
+                i,
+                fission_nk_panel_mask_test(workspace->hot.visible, i)
+            );
+            fission_nk_panel_mask_assign(layout->detached, i, 0);
+        }
+        memcpy(&layout->slot[first], &workspace->hot.slot[first], count * sizeof(layout->slot[0]));
+        for (i = first; i < first + count; ++i) {
+            layout->generation[i] = workspace->entries[i].generation;
+            layout->detached_bounds[i] = workspace->entries[i].state.detached_bounds;
+        }
+    }
+}
+
 static void fission_nk_panel_workspace_tabs_ensure_main(
     fission_nk_panel_workspace_tabs_t *tabs,
     const fission_nk_panel_workspace_t *active_workspace
@@ -3784,8 +6835,11 @@ static void fission_nk_panel_workspace_tabs_ensure_main(
     if (tabs == NULL || active_workspace == NULL || tabs->tab_count != 0u) {
         return;
     }
+    if (fission_nk_panel_workspace_tabs_supported(active_workspace) == 0) {
+        return;
+    }
 
-    tabs->tabs[0] = *active_workspace;
+    fission_nk_panel_workspace_tabs_capture(&tabs->layouts[0], active_workspace);
     fission_nk_panel_workspace_tabs_copy_name(
         tabs->tab_names[0],
         sizeof(tabs->tab_names[0]),
@@ -3834,7 +6888,7 @@ void fission_nk_panel_workspace_tabs_commit_active(
         return;
     }
 
-    tabs->tabs[tabs->active_tab_index] = *active_workspace;
+    fission_nk_panel_workspace_tabs_capture(&tabs->layouts[tabs->active_tab_index], active_workspace);
 }
 
 void fission_nk_panel_workspace_tabs_load_active(
@@ -3848,8 +6902,11 @@ void fission_nk_panel_workspace_tabs_load_active(
     if (tabs->tab_count == 0u || tabs->active_tab_index >= tabs->tab_count) {
         return;
     }
+    if (fission_nk_panel_workspace_tabs_supported(active_workspace) == 0) {
+        return;
+    }
 
-    *active_workspace = tabs->tabs[tabs->active_tab_index];
+    fission_nk_panel_workspace_tabs_apply(&tabs->layouts[tabs->active_tab_index], active_workspace);
 }
 
 fission_nk_panel_status_t fission_nk_panel_workspace_tabs_register_panel(
@@ -3857,39 +6914,91 @@ fission_nk_panel_status_t fission_nk_panel_workspace_tabs_register_panel(
     fission_nk_panel_workspace_t *active_workspace,
     const fission_nk_panel_desc_t *panel
 )
+{
+    return fission_nk_panel_workspace_tabs_register_panel_handle(tabs, active_workspace, panel, NULL);
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_tabs_register_panel_handle(
+    fission_nk_panel_workspace_tabs_t *tabs,
+    fission_nk_panel_workspace_t *active_workspace,
+    const fission_nk_panel_desc_t *panel,
+    fission_nk_panel_handle_t *out_handle
+)
 {
     fission_nk_panel_status_t status;
+    fission_nk_panel_handle_t handle;
     size_t panel_index;
-    size_t i;
 
+    if (out_handle != NULL) {
+        *out_handle = FISSION_NK_PANEL_HANDLE_NONE;
+    }
     if (tabs == NULL || active_workspace == NULL || panel == NULL) {
         return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
     }
+    if (fission_nk_panel_workspace_tabs_supported(active_workspace) == 0) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
 
-    status = fission_nk_panel_workspace_register(active_workspace, panel);
+    status = fission_nk_panel_workspace_register_handle(active_workspace, panel, &handle);
     if (status != FISSION_NK_PANEL_STATUS_OK) {
         return status;
     }
+    if (out_handle != NULL) {
+        *out_handle = handle;
+    }
 
-    if (active_workspace->count == 0u) {
+    panel_index = fission_nk_panel_handle_index(active_workspace, handle);
+    if (panel_index >= active_workspace->count) {
         return FISSION_NK_PANEL_STATUS_RUNTIME_ERROR;
     }
-
-    panel_index = active_workspace->count - 1u;
     fission_nk_panel_workspace_tabs_ensure_main(tabs, active_workspace);
     if (tabs->tab_count == 0u) {
         return FISSION_NK_PANEL_STATUS_RUNTIME_ERROR;
     }
-    if (tabs->tab_count == 1u && tabs->tabs[0].count == active_workspace->count) {
-        tabs->rename_source_index = (size_t)-1;
-        return FISSION_NK_PANEL_STATUS_OK;
+
+    fission_nk_panel_workspace_tabs_seed_range(tabs, active_workspace, panel_index, 1u);
+    tabs->rename_source_index = (size_t)-1;
+    return FISSION_NK_PANEL_STATUS_OK;
+}
+
+fission_nk_panel_status_t fission_nk_panel_workspace_tabs_register_many(
+    fission_nk_panel_workspace_tabs_t *tabs,
+    fission_nk_panel_workspace_t *active_workspace,
+    const fission_nk_panel_desc_t *panels,
+    size_t count
+)
+{
+    fission_nk_panel_status_t status;
+    size_t first;
+    size_t i;
+
+    if (tabs == NULL || active_workspace == NULL) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
+    if (fission_nk_panel_workspace_tabs_supported(active_workspace) == 0) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
     }
 
-    for (i = 0u; i < tabs->tab_count; ++i) {
-        tabs->tabs[i].entries[panel_index] = active_workspace->entries[panel_index];
-        tabs->tabs[i].count = active_workspace->count;
+    first = active_workspace->count;
+    status = fission_nk_panel_workspace_register_many(active_workspace, panels, count);
+    if (status != FISSION_NK_PANEL_STATUS_OK) {
+        return status;
     }
-    fission_nk_panel_workspace_tabs_commit_active(tabs, active_workspace);
+    fission_nk_panel_workspace_tabs_ensure_main(tabs, active_workspace);
+    if (tabs->tab_count == 0u) {
+        return FISSION_NK_PANEL_STATUS_RUNTIME_ERROR;
+    }
+
+    /* Panels that reused freed entries are seeded one by one, the appended tail in one copy. */
+    for (i = 0u; i < count; ++i) {
+        size_t panel_index;
+
+        panel_index = fission_nk_panel_find_index(active_workspace, panels[i].id);
+        if (panel_index < first) {
+            fission_nk_panel_workspace_tabs_seed_range(tabs, active_workspace, panel_index, 1u);
+        }
+    }
+    fission_nk_panel_workspace_tabs_seed_range(tabs, active_workspace, first, active_workspace->count - first);
     tabs->rename_source_index = (size_t)-1;
     return FISSION_NK_PANEL_STATUS_OK;
 }
@@ -3975,11 +7084,13 @@ fission_nk_panel_status_t fission_nk_panel_workspace_tabs_create(
 )
 {
     size_t new_index;
-    size_t i;
 
     if (tabs == NULL || active_workspace == NULL) {
         return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
     }
+    if (fission_nk_panel_workspace_tabs_supported(active_workspace) == 0) {
+        return FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT;
+    }
     if (tabs->tab_count >= FISSION_NK_MAX_WORKSPACE_TABS) {
         return FISSION_NK_PANEL_STATUS_RUNTIME_ERROR;
     }
@@ -3991,14 +7102,9 @@ fission_nk_panel_status_t fission_nk_panel_workspace_tabs_create(
 
     fission_nk_panel_workspace_tabs_commit_active(tabs, active_workspace);
     new_index = tabs->tab_count;
-    tabs->tabs[new_index] = *active_workspace;
-    for (i = 0u; i < tabs->tabs[new_index].count; ++i) {
-        tabs->tabs[new_index].entries[i].state.visible = 0;
-        tabs->tabs[new_index].entries[i].state.detached = 0;
-    }
-    tabs->tabs[new_index].ui_scroll_block_count = 0u;
-    tabs->tabs[new_index].ui_popup_open = 0;
-    memset(tabs->tabs[new_index].ui_scroll_blocks, 0, sizeof(tabs->tabs[new_index].ui_scroll_blocks));
+    fission_nk_panel_workspace_tabs_capture(&tabs->layouts[new_index], active_workspace);
+    memset(tabs->layouts[new_index].visible, 0, sizeof(tabs->layouts[new_index].visible));
+    memset(tabs->layouts[new_index].detached, 0, sizeof(tabs->layouts[new_index].detached));
     if (name != NULL && name[0] != '\0') {
         fission_nk_panel_workspace_tabs_copy_name(
             tabs->tab_names[new_index],
@@ -4043,12 +7149,12 @@ fission_nk_panel_status_t fission_nk_panel_workspace_tabs_remove(
 
     fission_nk_panel_workspace_tabs_commit_active(tabs, active_workspace);
     for (i = index; i + 1u < tabs->tab_count; ++i) {
-        tabs->tabs[i] = tabs->tabs[i + 1u];
+        tabs->layouts[i] = tabs->layouts[i + 1u];
         memcpy(tabs->tab_names[i], tabs->tab_names[i + 1u], sizeof(tabs->tab_names[i]));
     }
 
     tabs->tab_count -= 1u;
-    memset(&tabs->tabs[tabs->tab_count], 0, sizeof(tabs->tabs[tabs->tab_count]));
+    memset(&tabs->layouts[tabs->tab_count], 0, sizeof(tabs->layouts[tabs->tab_count]));
     memset(tabs->tab_names[tabs->tab_count], 0, sizeof(tabs->tab_names[tabs->tab_count]));
 
     if (tabs->active_tab_index == index) {
@@ -4093,7 +7199,7 @@ fission_nk_panel_status_t fission_nk_panel_workspace_tabs_move(
     size_t to_index
 )
 {
-    fission_nk_panel_workspace_t moved_workspace;
+    fission_nk_panel_tab_layout_t moved_layout;
     char moved_name[FISSION_NK_WORKSPACE_TAB_NAME_MAX];
     size_t i;
 
@@ -4108,22 +7214,22 @@ fission_nk_panel_status_t fission_nk_panel_workspace_tabs_move(
     }
 
     fission_nk_panel_workspace_tabs_commit_active(tabs, active_workspace);
-    moved_workspace = tabs->tabs[from_index];
+    moved_layout = tabs->layouts[from_index];
     memcpy(moved_name, tabs->tab_names[from_index], sizeof(moved_name));
 
     if (from_index < to_index) {
         for (i = from_index; i < to_index; ++i) {
-            tabs->tabs[i] = tabs->tabs[i + 1u];
+            tabs->layouts[i] = tabs->layouts[i + 1u];
             memcpy(tabs->tab_names[i], tabs->tab_names[i + 1u], sizeof(tabs->tab_names[i]));
         }
     } else {
         for (i = from_index; i > to_index; --i) {
-            tabs->tabs[i] = tabs->tabs[i - 1u];
+            tabs->layouts[i] = tabs->layouts[i - 1u];
             memcpy(tabs->tab_names[i], tabs->tab_names[i - 1u], sizeof(tabs->tab_names[i]));
         }
     }
 
-    tabs->tabs[to_index] = moved_workspace;
+    tabs->layouts[to_index] = moved_layout;
     memcpy(tabs->tab_names[to_index], moved_name, sizeof(tabs->tab_names[to_index]));
 
     if (tabs->active_tab_index == from_index) {
@@ -0,0 +1,325 @@
+#include "fission/nuklear_profiler.h"
+
+#include <string.h>
+
+#include "fission/nuklear.h"
+
+typedef struct fission_nk_profiler_summary {
+    float last_ms;
+    float avg_ms;
+    float max_ms;
+} fission_nk_profiler_summary_t;
+
+static size_t fission_nk_profiler_oldest(const fission_nk_profiler_t *profiler)
+{
+    return (
+        profiler->next + (size_t)FISSION_NK_PROFILER_HISTORY - profiler->count
+    ) % (size_t)FISSION_NK_PROFILER_HISTORY;
+}
+
+static float fission_nk_profiler_sample_at(const fission_nk_profiler_t *profiler, size_t age_index)
+{
+    return profiler->frame_ms[
+        (fission_nk_profiler_oldest(profiler) + age_index) % (size_t)FISSION_NK_PROFILER_HISTORY
+    ];
+}
+
+static void fission_nk_profiler_summarize(
+    const fission_nk_profiler_t *profiler,
+    fission_nk_profiler_summary_t *out_summary
+)
+{
+    double sum;
+    size_t i;
+
+    memset(out_summary, 0, sizeof(*out_summary));
+    if (profiler->count == 0u) {
+        return;
+    }
+
+    sum = 0.0;
+    for (i = 0u; i < profiler->count; ++i) {
+        float value;
+
+        value = fission_nk_profiler_sample_at(profiler, i);
+        sum += (double)value;
+        if (value > out_summary->max_ms) {
+            out_summary->max_ms = value;
+        }
+    }
+    out_summary->last_ms = fission_nk_profiler_sample_at(profiler, profiler->count - 1u);
+    out_summary->avg_ms = (float)(sum / (double)profiler->count);
+}
+
+void fission_nk_profiler_init(fission_nk_profiler_t *profiler, size_t top_count)
+{
+    if (profiler == NULL) {
+        return;
+    }
+
+    memset(profiler, 0, sizeof(*profiler));
+    if (top_count == 0u || top_count > (size_t)FISSION_NK_PROFILER_TOP_MAX) {
+        top_count = (size_t)FISSION_NK_PROFILER_TOP_MAX;
+    }
+    profiler->top_count = top_count;
+    profiler->chart_height = 64.0f;
+}
+
+void fission_nk_profiler_clear(fission_nk_profiler_t *profiler)
+{
+    if (profiler == NULL) {
+        return;
+    }
+    profiler->next = 0u;
+    profiler->count = 0u;
+}
+
+void fission_nk_profiler_push_frame_ns(fission_nk_profiler_t *profiler, unsigned long long frame_ns)
+{
+    if (profiler == NULL) {
+        return;
+    }
+
+    profiler->frame_ms[profiler->next] = (float)((double)frame_ns / 1000000.0);
+    profiler->next = (profiler->next + 1u) % (size_t)FISSION_NK_PROFILER_HISTORY;
+    if (profiler->count < (size_t)FISSION_NK_PROFILER_HISTORY) {
+        profiler->count += 1u;
+    }
+}
+
+void fission_nk_profiler_panel_desc(
+    fission_nk_profiler_t *profiler,
+    const char *panel_id,
+    const char *title,
+    fission_nk_panel_desc_t *out_desc
+)
+{
+    if (out_desc == NULL) {
+        return;
+    }
+
+    memset(out_desc, 0, sizeof(*out_desc));
+    out_desc->id = panel_id;
+    out_desc->title = title;
+    out_desc->draw = fission_nk_profiler_draw_panel;
+    out_desc->user_data = profiler;
+    out_desc->default_slot = FISSION_NK_PANEL_SLOT_RIGHT;
+    out_desc->default_visible = 1;
+    out_desc->default_detachable = 1;
+}
+
+/* Max-decimates the history so single-frame spikes survive the downsampling. */
+static void fission_nk_profiler_draw_history(
+    struct nk_context *ctx,
+    const fission_nk_profiler_t *profiler,
+    const fission_nk_profiler_summary_t *summary
+)
+{
+    size_t point_count;
+    size_t point;
+    float scale;
+
+    point_count = profiler->count;
+    if (point_count > (size_t)FISSION_NK_PROFILER_PLOT_POINTS) {
+        point_count = (size_t)FISSION_NK_PROFILER_PLOT_POINTS;
+    }
+    scale = (summary->max_ms > 0.0f) ? summary->max_ms * 1.1f : 1.0f;
+
+    nk_layout_row_dynamic(ctx, profiler->chart_height, 1);
+    if (point_count == 0u) {
+        nk_spacing(ctx, 1);
+        return;
+    }
+    if (nk_chart_begin(ctx, NK_CHART_LINES, (int)point_count, 0.0f, scale) == 0) {
+        return;
+    }
+    for (point = 0u; point < point_count; ++point) {
+        size_t first;
+        size_t last;
+        size_t i;
+        float peak;
+
+        first = point * profiler->count / point_count;
+        last = (point + 1u) * profiler->count / point_count;
+        peak = 0.0f;
+        for (i = first; i < last; ++i) {
+            float value;
+
+            value = fission_nk_profiler_sample_at(profiler, i);
+            if (value > peak) {
+                peak = value;
+            }
+        }
+        (void)nk_chart_push(ctx, peak);
+    }
+    nk_chart_end(ctx);
+}
+
+static void fission_nk_profiler_draw_histogram(
+    struct nk_context *ctx,
+    const fission_nk_profiler_t *profiler,
+    const fission_nk_profiler_summary_t *summary
+)
+{
+    unsigned int bins[FISSION_NK_PROFILER_HISTOGRAM_BINS];
+    unsigned int tallest;
+    size_t i;
+
+    memset(bins, 0, sizeof(bins));
+    tallest = 1u;
+    for (i = 0u; i < profiler->count; ++i) {
+        size_t bin;
+
+        bin = 0u;
+        if (summary->max_ms > 0.0f) {
+            bin = (size_t)(
+                fission_nk_profiler_sample_at(profiler, i) / summary->max_ms *
+                (float)FISSION_NK_PROFILER_HISTOGRAM_BINS
+            );
+        }
+        if (bin >= (size_t)FISSION_NK_PROFILER_HISTOGRAM_BINS) {
+            bin = (size_t)FISSION_NK_PROFILER_HISTOGRAM_BINS - 1u;
+        }
+        bins[bin] += 1u;
+        if (bins[bin] > tallest) {
+            tallest = bins[bin];
+        }
+    }
+
+    nk_layout_row_dynamic(ctx, 18.0f, 1);
+    nk_labelf(ctx, NK_TEXT_LEFT, "distribution 0 - %.2f ms", (double)summary->max_ms);
+    nk_layout_row_dynamic(ctx, profiler->chart_height, 1);
+    if (
+        nk_chart_begin(
+            ctx,
+            NK_CHART_COLUMN,
+            FISSION_NK_PROFILER_HISTOGRAM_BINS,
+            0.0f,
+            (float)tallest
+        ) == 0
+    ) {
+        return;
+    }
+    for (i = 0u; i < (size_t)FISSION_NK_PROFILER_HISTOGRAM_BINS; ++i) {
+        (void)nk_chart_push(ctx, (float)bins[i]);
+    }
+    nk_chart_end(ctx);
+}
+
+static void fission_nk_profiler_draw_top_panels(
+    struct nk_context *ctx,
+    const fission_nk_profiler_t *profiler,
+    const fission_nk_panel_workspace_t *workspace
+)
+{
+    size_t top_index[FISSION_NK_PROFILER_TOP_MAX];
+    fission_nk_panel_stats_t top_stats[FISSION_NK_PROFILER_TOP_MAX];
+    size_t top_used;
+    size_t panel_count;
+    size_t i;
+
+    top_used = 0u;
+    panel_count = fission_nk_panel_workspace_count(workspace);
+    for (i = 0u; i < panel_count; ++i) {
+        fission_nk_panel_stats_t stats;
+        size_t slot;
+
+        if (
+            fission_nk_panel_workspace_get_panel_stats_at(workspace, i, &stats) !=
+                FISSION_NK_PANEL_STATUS_OK ||
+            stats.sample_count == 0u
+        ) {
+            continue;
+        }
+
+        slot = top_used;
+        while (slot > 0u && top_stats[slot - 1u].cpu_ns.avg < stats.cpu_ns.avg) {
+            if (slot < profiler->top_count) {
+                top_index[slot] = top_index[slot - 1u];
+                top_stats[slot] = top_stats[slot - 1u];
+            }
+            slot -= 1u;
+        }
+        if (slot >= profiler->top_count) {
+            continue;
+        }
+        top_index[slot] = i;
+        top_stats[slot] = stats;
+        if (top_used < profiler->top_count) {
+            top_used += 1u;
+        }
+    }
+
+    nk_layout_row_dynamic(ctx, 18.0f, 1);
+    nk_label(ctx, "slowest panels (avg / max)", NK_TEXT_LEFT);
+    for (i = 0u; i < top_used; ++i) {
+        const char *title;
+
+        title = fission_nk_panel_workspace_panel_title_at(workspace, top_index[i]);
+        nk_layout_row_dynamic(ctx, 18.0f, 2);
+        nk_label(ctx, (title != NULL) ? title : "?", NK_TEXT_LEFT);
+        nk_labelf(
+            ctx,
+            NK_TEXT_RIGHT,
+            "%.3f / %.3f ms",
+            top_stats[i].cpu_ns.avg / 1000000.0,
+            top_stats[i].cpu_ns.max / 1000000.0
+        );
+    }
+}
+
+void fission_nk_profiler_draw_panel(
+    struct nk_context *ctx,
+    fission_nk_panel_workspace_t *workspace,
+    const char *panel_id,
+    int window_width,
+    int window_height,
+    void *user_data
+)
+{
+    fission_nk_profiler_t *profiler;
+    fission_nk_profiler_summary_t summary;
+    unsigned long long draw_all_ns;
+
+    (void)window_width;
+    (void)window_height;
+
+    profiler = (fission_nk_profiler_t *)user_data;
+    if (ctx == NULL || workspace == NULL || profiler == NULL) {
+        return;
+    }
+
+    /* Stats stay the host's call: they cost every panel a clock read, so say so instead. */
+    if (fission_nk_panel_workspace_panel_stats_enabled(workspace) == 0) {
+        if (fission_nk_panel_workspace_begin_window(ctx, workspace, panel_id, NULL, 0u, NULL) != 0) {
+            nk_layout_row_dynamic(ctx, 18.0f, 1);
+            nk_label(ctx, "Panel stats are off.", NK_TEXT_LEFT);
+            nk_label(ctx, "Call fission_nk_panel_workspace_enable_panel_stats.", NK_TEXT_LEFT);
+        }
+        fission_nk_panel_workspace_end_window(ctx, workspace, panel_id);
+        return;
+    }
+    draw_all_ns = fission_nk_panel_workspace_last_draw_all_ns(workspace);
+    if (draw_all_ns > 0u) {
+        fission_nk_profiler_push_frame_ns(profiler, draw_all_ns);
+    }
+
+    if (fission_nk_panel_workspace_begin_window(ctx, workspace, panel_id, NULL, 0u, NULL) != 0) {
+        fission_nk_profiler_summarize(profiler, &summary);
+
+        nk_layout_row_dynamic(ctx, 18.0f, 1);
+        nk_labelf(
+            ctx,
+            NK_TEXT_LEFT,
+            "frame %.2f ms  avg %.2f  max %.2f  (%u frames)",
+            (double)summary.last_ms,
+            (double)summary.avg_ms,
+            (double)summary.max_ms,
+            (unsigned int)profiler->count
+        );
+        fission_nk_profiler_draw_history(ctx, profiler, &summary);
+        fission_nk_profiler_draw_histogram(ctx, profiler, &summary);
+        fission_nk_profiler_draw_top_panels(ctx, profiler, workspace);
+    }
+    fission_nk_panel_workspace_end_window(ctx, workspace, panel_id);
+}
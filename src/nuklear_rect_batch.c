@@ -0,0 +1,388 @@
+#include "fission/nuklear_ui.h"
+
+#include "fission/nuklear.h"
+
+#if defined(FISSION_NK_RECT_BATCH_FORCE_SCALAR)
+#define FISSION_NK_RECT_BATCH_SCALAR 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FISSION_NK_RECT_BATCH_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define FISSION_NK_RECT_BATCH_NEON 1
+#include <arm_neon.h>
+#else
+#define FISSION_NK_RECT_BATCH_SCALAR 1
+#endif
+
+/* The vector paths load four nk_rects as a 4x4 float block. */
+typedef char fission_nk_rect_layout_check[
+    (sizeof(struct nk_rect) == 4u * sizeof(float)) ? 1 : -1
+];
+
+static int fission_nk_rect_batch_contains(const struct nk_rect *rect, float x, float y)
+{
+    return (
+        rect->w > 0.0f &&
+        rect->h > 0.0f &&
+        x >= rect->x &&
+        y >= rect->y &&
+        x <= (rect->x + rect->w) &&
+        y <= (rect->y + rect->h)
+    );
+}
+
+static int fission_nk_rect_batch_intersect_one(
+    const struct nk_rect *rect,
+    const struct nk_rect *clip,
+    struct nk_rect *out_rect
+)
+{
+    float left;
+    float top;
+    float right;
+    float bottom;
+    float rect_right;
+    float rect_bottom;
+    float clip_right;
+    float clip_bottom;
+
+    rect_right = rect->x + rect->w;
+    rect_bottom = rect->y + rect->h;
+    clip_right = clip->x + clip->w;
+    clip_bottom = clip->y + clip->h;
+    left = (rect->x > clip->x) ? rect->x : clip->x;
+    top = (rect->y > clip->y) ? rect->y : clip->y;
+    right = (rect_right < clip_right) ? rect_right : clip_right;
+    bottom = (rect_bottom < clip_bottom) ? rect_bottom : clip_bottom;
+
+    if (right <= left || bottom <= top) {
+        *out_rect = nk_rect(0.0f, 0.0f, 0.0f, 0.0f);
+        return 0;
+    }
+    *out_rect = nk_rect(left, top, right - left, bottom - top);
+    return 1;
+}
+
+#if defined(FISSION_NK_RECT_BATCH_SSE2)
+static unsigned int fission_nk_rect_batch_hit_mask4(const struct nk_rect *rects, __m128 px, __m128 py)
+{
+    __m128 x;
+    __m128 y;
+    __m128 w;
+    __m128 h;
+    __m128 zero;
+    __m128 hit;
+
+    x = _mm_loadu_ps(&rects[0].x);
+    y = _mm_loadu_ps(&rects[1].x);
+    w = _mm_loadu_ps(&rects[2].x);
+    h = _mm_loadu_ps(&rects[3].x);
+    _MM_TRANSPOSE4_PS(x, y, w, h);
+
+    zero = _mm_setzero_ps();
+    hit = _mm_and_ps(_mm_cmpgt_ps(w, zero), _mm_cmpgt_ps(h, zero));
+    hit = _mm_and_ps(hit, _mm_cmpge_ps(px, x));
+    hit = _mm_and_ps(hit, _mm_cmpge_ps(py, y));
+    hit = _mm_and_ps(hit, _mm_cmple_ps(px, _mm_add_ps(x, w)));
+    hit = _mm_and_ps(hit, _mm_cmple_ps(py, _mm_add_ps(y, h)));
+    return (unsigned int)_mm_movemask_ps(hit);
+}
+
+static unsigned int fission_nk_rect_batch_intersect4(
+    const struct nk_rect *rects,
+    const __m128 *clip,
+    struct nk_rect *out_rects
+)
+{
+    __m128 x;
+    __m128 y;
+    __m128 w;
+    __m128 h;
+    __m128 left;
+    __m128 top;
+    __m128 right;
+    __m128 bottom;
+    __m128 valid;
+
+    x = _mm_loadu_ps(&rects[0].x);
+    y = _mm_loadu_ps(&rects[1].x);
+    w = _mm_loadu_ps(&rects[2].x);
+    h = _mm_loadu_ps(&rects[3].x);
+    _MM_TRANSPOSE4_PS(x, y, w, h);
+
+    /* Operand order matches the scalar (a > b) ? a : b so NaNs resolve identically. */
+    left = _mm_max_ps(x, clip[0]);
+    top = _mm_max_ps(y, clip[1]);
+    right = _mm_min_ps(_mm_add_ps(x, w), clip[2]);
+    bottom = _mm_min_ps(_mm_add_ps(y, h), clip[3]);
+    /* !(a <= b) rather than a > b: the scalar path only rejects on an ordered <=. */
+    valid = _mm_and_ps(_mm_cmpnle_ps(right, left), _mm_cmpnle_ps(bottom, top));
+
+    x = _mm_and_ps(valid, left);
+    y = _mm_and_ps(valid, top);
+    w = _mm_and_ps(valid, _mm_sub_ps(right, left));
+    h = _mm_and_ps(valid, _mm_sub_ps(bottom, top));
+    _MM_TRANSPOSE4_PS(x, y, w, h);
+    _mm_storeu_ps(&out_rects[0].x, x);
+    _mm_storeu_ps(&out_rects[1].x, y);
+    _mm_storeu_ps(&out_rects[2].x, w);
+    _mm_storeu_ps(&out_rects[3].x, h);
+    return (unsigned int)_mm_movemask_ps(valid);
+}
+#elif defined(FISSION_NK_RECT_BATCH_NEON)
+static unsigned int fission_nk_rect_batch_movemask(uint32x4_t mask)
+{
+    static const uint32_t bits[4] = {1u, 2u, 4u, 8u};
+
+    return (unsigned int)vaddvq_u32(vandq_u32(mask, vld1q_u32(bits)));
+}
+
+static unsigned int fission_nk_rect_batch_hit_mask4(
+    const struct nk_rect *rects,
+    float32x4_t px,
+    float32x4_t py
+)
+{
+    float32x4x4_t r;
+    float32x4_t zero;
+    uint32x4_t hit;
+
+    r = vld4q_f32(&rects[0].x);
+    zero = vdupq_n_f32(0.0f);
+    hit = vandq_u32(vcgtq_f32(r.val[2], zero), vcgtq_f32(r.val[3], zero));
+    hit = vandq_u32(hit, vcgeq_f32(px, r.val[0]));
+    hit = vandq_u32(hit, vcgeq_f32(py, r.val[1]));
+    hit = vandq_u32(hit, vcleq_f32(px, vaddq_f32(r.val[0], r.val[2])));
+    hit = vandq_u32(hit, vcleq_f32(py, vaddq_f32(r.val[1], r.val[3])));
+    return fission_nk_rect_batch_movemask(hit);
+}
+
+static float32x4_t fission_nk_rect_batch_select_max(float32x4_t a, float32x4_t b)
+{
+    return vbslq_f32(vcgtq_f32(a, b), a, b);
+}
+
+static float32x4_t fission_nk_rect_batch_select_min(float32x4_t a, float32x4_t b)
+{
+    return vbslq_f32(vcltq_f32(a, b), a, b);
+}
+
+static unsigned int fission_nk_rect_batch_intersect4(
+    const struct nk_rect *rects,
+    const float32x4_t *clip,
+    struct nk_rect *out_rects
+)
+{
+    float32x4x4_t r;
+    float32x4_t left;
+    float32x4_t top;
+    float32x4_t right;
+    float32x4_t bottom;
+    uint32x4_t valid;
+
+    r = vld4q_f32(&rects[0].x);
+    /* Compare-and-select keeps the scalar (a > b) ? a : b NaN behaviour. */
+    left = fission_nk_rect_batch_select_max(r.val[0], clip[0]);
+    top = fission_nk_rect_batch_select_max(r.val[1], clip[1]);
+    right = fission_nk_rect_batch_select_min(vaddq_f32(r.val[0], r.val[2]), clip[2]);
+    bottom = fission_nk_rect_batch_select_min(vaddq_f32(r.val[1], r.val[3]), clip[3]);
+    /* !(a <= b) rather than a > b: the scalar path only rejects on an ordered <=. */
+    valid = vandq_u32(vmvnq_u32(vcleq_f32(right, left)), vmvnq_u32(vcleq_f32(bottom, top)));
+
+    r.val[0] = vreinterpretq_f32_u32(vandq_u32(valid, vreinterpretq_u32_f32(left)));
+    r.val[1] = vreinterpretq_f32_u32(vandq_u32(valid, vreinterpretq_u32_f32(top)));
+    r.val[2] = vreinterpretq_f32_u32(vandq_u32(valid, vreinterpretq_u32_f32(vsubq_f32(right, left))));
+    r.val[3] = vreinterpretq_f32_u32(vandq_u32(valid, vreinterpretq_u32_f32(vsubq_f32(bottom, top))));
+    vst4q_f32(&out_rects[0].x, r);
+    return fission_nk_rect_batch_movemask(valid);
+}
+#endif
+
+#if !defined(FISSION_NK_RECT_BATCH_SCALAR)
+static unsigned int fission_nk_rect_batch_popcount4(unsigned int mask)
+{
+    return (mask & 1u) + ((mask >> 1) & 1u) + ((mask >> 2) & 1u) + ((mask >> 3) & 1u);
+}
+
+static int fission_nk_rect_batch_first_bit4(unsigned int mask)
+{
+    if ((mask & 1u) != 0u) {
+        return 0;
+    }
+    if ((mask & 2u) != 0u) {
+        return 1;
+    }
+    return ((mask & 4u) != 0u) ? 2 : 3;
+}
+#endif
+
+const char *fission_nk_rect_batch_backend(void)
+{
+#if defined(FISSION_NK_RECT_BATCH_SSE2)
+    return "sse2";
+#elif defined(FISSION_NK_RECT_BATCH_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+int fission_nk_rects_find_point(
+    const struct nk_rect *rects,
+    size_t count,
+    float x,
+    float y
+)
+{
+    size_t i;
+
+    if (rects == NULL) {
+        return -1;
+    }
+
+    i = 0u;
+#if defined(FISSION_NK_RECT_BATCH_SSE2)
+    {
+        __m128 px;
+        __m128 py;
+
+        px = _mm_set1_ps(x);
+        py = _mm_set1_ps(y);
+        for (; i + 4u <= count; i += 4u) {
+            unsigned int mask;
+
+            mask = fission_nk_rect_batch_hit_mask4(&rects[i], px, py);
+            if (mask != 0u) {
+                return (int)i + fission_nk_rect_batch_first_bit4(mask);
+            }
+        }
+    }
+#elif defined(FISSION_NK_RECT_BATCH_NEON)
+    {
+        float32x4_t px;
+        float32x4_t py;
+
+        px = vdupq_n_f32(x);
+        py = vdupq_n_f32(y);
+        for (; i + 4u <= count; i += 4u) {
+            unsigned int mask;
+
+            mask = fission_nk_rect_batch_hit_mask4(&rects[i], px, py);
+            if (mask != 0u) {
+                return (int)i + fission_nk_rect_batch_first_bit4(mask);
+            }
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        if (fission_nk_rect_batch_contains(&rects[i], x, y) != 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+size_t fission_nk_rects_contain_point(
+    const struct nk_rect *rects,
+    size_t count,
+    float x,
+    float y,
+    unsigned char *out_hits
+)
+{
+    size_t hits;
+    size_t i;
+
+    if (rects == NULL || out_hits == NULL) {
+        return 0u;
+    }
+
+    hits = 0u;
+    i = 0u;
+#if defined(FISSION_NK_RECT_BATCH_SSE2) || defined(FISSION_NK_RECT_BATCH_NEON)
+    {
+#if defined(FISSION_NK_RECT_BATCH_SSE2)
+        __m128 px;
+        __m128 py;
+
+        px = _mm_set1_ps(x);
+        py = _mm_set1_ps(y);
+#else
+        float32x4_t px;
+        float32x4_t py;
+
+        px = vdupq_n_f32(x);
+        py = vdupq_n_f32(y);
+#endif
+        for (; i + 4u <= count; i += 4u) {
+            unsigned int mask;
+
+            mask = fission_nk_rect_batch_hit_mask4(&rects[i], px, py);
+            out_hits[i + 0u] = (unsigned char)(mask & 1u);
+            out_hits[i + 1u] = (unsigned char)((mask >> 1) & 1u);
+            out_hits[i + 2u] = (unsigned char)((mask >> 2) & 1u);
+            out_hits[i + 3u] = (unsigned char)((mask >> 3) & 1u);
+            hits += fission_nk_rect_batch_popcount4(mask);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        out_hits[i] = (unsigned char)fission_nk_rect_batch_contains(&rects[i], x, y);
+        hits += out_hits[i];
+    }
+    return hits;
+}
+
+size_t fission_nk_rects_intersect(
+    const struct nk_rect *rects,
+    size_t count,
+    const struct nk_rect *clip,
+    struct nk_rect *out_rects
+)
+{
+    struct nk_rect clip_rect;
+    size_t visible;
+    size_t i;
+
+    if (rects == NULL || clip == NULL || out_rects == NULL) {
+        return 0u;
+    }
+
+    clip_rect = *clip;
+
+    visible = 0u;
+    i = 0u;
+#if defined(FISSION_NK_RECT_BATCH_SSE2)
+    {
+        __m128 clip_v[4];
+
+        clip_v[0] = _mm_set1_ps(clip_rect.x);
+        clip_v[1] = _mm_set1_ps(clip_rect.y);
+        clip_v[2] = _mm_set1_ps(clip_rect.x + clip_rect.w);
+        clip_v[3] = _mm_set1_ps(clip_rect.y + clip_rect.h);
+        for (; i + 4u <= count; i += 4u) {
+            visible += fission_nk_rect_batch_popcount4(
+                fission_nk_rect_batch_intersect4(&rects[i], clip_v, &out_rects[i])
+            );
+        }
+    }
+#elif defined(FISSION_NK_RECT_BATCH_NEON)
+    {
+        float32x4_t clip_v[4];
+
+        clip_v[0] = vdupq_n_f32(clip_rect.x);
+        clip_v[1] = vdupq_n_f32(clip_rect.y);
+        clip_v[2] = vdupq_n_f32(clip_rect.x + clip_rect.w);
+        clip_v[3] = vdupq_n_f32(clip_rect.y + clip_rect.h);
+        for (; i + 4u <= count; i += 4u) {
+            visible += fission_nk_rect_batch_popcount4(
+                fission_nk_rect_batch_intersect4(&rects[i], clip_v, &out_rects[i])
+            );
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        visible += (size_t)fission_nk_rect_batch_intersect_one(&rects[i], &clip_rect, &out_rects[i]);
+    }
+    return visible;
+}
@@ -0,0 +1,161 @@
+#include "fission/nuklear_trace.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "nuklear_clock.h"
+
+int fission_nk_trace_instrumentation_enabled(void)
+{
+#if defined(FISSION_NK_ENABLE_TRACE)
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+void fission_nk_trace_init(
+    fission_nk_trace_t *trace,
+    fission_nk_trace_event_t *events,
+    size_t capacity
+)
+{
+    if (trace == NULL) {
+        return;
+    }
+
+    memset(trace, 0, sizeof(*trace));
+    if (events == NULL) {
+        capacity = 0u;
+    }
+    trace->events = events;
+    trace->capacity = capacity;
+    trace->origin_ns = fission_nk_clock_now_ns();
+}
+
+void fission_nk_trace_clear(fission_nk_trace_t *trace)
+{
+    if (trace == NULL) {
+        return;
+    }
+
+    trace->next = 0u;
+    trace->count = 0u;
+    trace->recorded = 0u;
+    trace->frame = 0u;
+    trace->origin_ns = fission_nk_clock_now_ns();
+}
+
+unsigned long long fission_nk_trace_now_ns(void)
+{
+    return fission_nk_clock_now_ns();
+}
+
+void fission_nk_trace_record(
+    fission_nk_trace_t *trace,
+    const char *name,
+    const char *category,
+    unsigned long long start_ns,
+    unsigned long long end_ns
+)
+{
+    fission_nk_trace_event_t *event;
+    size_t name_len;
+
+    if (trace == NULL || trace->capacity == 0u || name == NULL) {
+        return;
+    }
+
+    event = &trace->events[trace->next];
+    name_len = strlen(name);
+    if (name_len >= sizeof(event->name)) {
+        name_len = sizeof(event->name) - 1u;
+    }
+    memcpy(event->name, name, name_len);
+    event->name[name_len] = '\0';
+    event->category = (category != NULL) ? category : "fission";
+    event->start_ns = start_ns;
+    event->duration_ns = (end_ns > start_ns) ? (end_ns - start_ns) : 0u;
+    event->frame = trace->frame;
+
+    trace->next += 1u;
+    if (trace->next >= trace->capacity) {
+        trace->next = 0u;
+    }
+    if (trace->count < trace->capacity) {
+        trace->count += 1u;
+    }
+    trace->recorded += 1u;
+}
+
+void fission_nk_trace_next_frame(fission_nk_trace_t *trace)
+{
+    if (trace == NULL) {
+        return;
+    }
+    trace->frame += 1u;
+}
+
+static void fission_nk_trace_write_string(FILE *file, const char *text)
+{
+    const unsigned char *c;
+
+    fputc('"', file);
+    for (c = (const unsigned char *)text; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', file);
+            fputc((int)*c, file);
+        } else if (*c < 0x20u) {
+            fprintf(file, "\\u%04x", (unsigned int)*c);
+        } else {
+            fputc((int)*c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+int fission_nk_trace_write_json(const fission_nk_trace_t *trace, const char *path)
+{
+    FILE *file;
+    size_t first;
+    size_t i;
+    int ok;
+
+    if (trace == NULL || path == NULL) {
+        return 0;
+    }
+
+    file = fopen(path, "wb");
+    if (file == NULL) {
+        return 0;
+    }
+
+    first = (trace->count < trace->capacity) ? 0u : trace->next;
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+    for (i = 0u; i < trace->count; ++i) {
+        const fission_nk_trace_event_t *event;
+        unsigned long long relative_ns;
+
+        event = &trace->events[(first + i) % trace->capacity];
+        relative_ns = (event->start_ns > trace->origin_ns) ? (event->start_ns - trace->origin_ns) : 0u;
+
+        fputs((i == 0u) ? "\n{\"name\":" : ",\n{\"name\":", file);
+        fission_nk_trace_write_string(file, event->name);
+        fputs(",\"cat\":", file);
+        fission_nk_trace_write_string(file, event->category);
+        fprintf(
+            file,
+            ",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%llu}}",
+            (double)relative_ns / 1000.0,
+            (double)event->duration_ns / 1000.0,
+            event->frame
+        );
+    }
+    fputs("\n]}\n", file);
+
+    ok = (ferror(file) == 0);
+    if (fclose(file) != 0) {
+        ok = 0;
+    }
+    return ok;
+}
@@ -589,24 +589,6 @@ void fission_nk_build_dock_zones(
     );
 }
 
-static int fission_nk_point_in_rect(
-    const struct nk_rect *rect,
-    float x,
-    float y
-)
-{
-    if (rect == NULL || rect->w <= 0.0f || rect->h <= 0.0f) {
-        return 0;
-    }
-
-    return (
-        x >= rect->x &&
-        y >= rect->y &&
-        x <= (rect->x + rect->w) &&
-        y <= (rect->y + rect->h)
-    );
-}
-
 static const char *fission_nk_dock_zone_label(fission_nk_dock_zone_t zone)
 {
     if (zone == FISSION_NK_DOCK_ZONE_TOP_LEFT) {
@@ -702,36 +684,20 @@ fission_nk_dock_zone_t fission_nk_pick_dock_zone(
     float y
 )
 {
+    int hit;
+
     if (zones == NULL) {
         return FISSION_NK_DOCK_ZONE_NONE;
     }
 
-    if (fission_nk_point_in_rect(&zones[FISSION_NK_DOCK_ZONE_TOP_LEFT], x, y) != 0) {
-        return FISSION_NK_DOCK_ZONE_TOP_LEFT;
-    }
-    if (fission_nk_point_in_rect(&zones[FISSION_NK_DOCK_ZONE_TOP_RIGHT], x, y) != 0) {
-        return FISSION_NK_DOCK_ZONE_TOP_RIGHT;
+    /* Corners win over edges, edges over center: zones 5..8 first, then 0..4. */
+    hit = fission_nk_rects_find_point(&zones[FISSION_NK_DOCK_ZONE_TOP_LEFT], 4u, x, y);
+    if (hit >= 0) {
+        return (fission_nk_dock_zone_t)(FISSION_NK_DOCK_ZONE_TOP_LEFT + hit);
     }
-    if (fission_nk_point_in_rect(&zones[FISSION_NK_DOCK_ZONE_BOTTOM_LEFT], x, y) != 0) {
-        return FISSION_NK_DOCK_ZONE_BOTTOM_LEFT;
-    }
-    if (fission_nk_point_in_rect(&zones[FISSION_NK_DOCK_ZONE_BOTTOM_RIGHT], x, y) != 0) {
-        return FISSION_NK_DOCK_ZONE_BOTTOM_RIGHT;
-    }
-    if (fission_nk_point_in_rect(&zones[FISSION_NK_DOCK_ZONE_LEFT], x, y) != 0) {
-        return FISSION_NK_DOCK_ZONE_LEFT;
-    }
-    if (fission_nk_point_in_rect(&zones[FISSION_NK_DOCK_ZONE_RIGHT], x, y) != 0) {
-        return FISSION_NK_DOCK_ZONE_RIGHT;
-    }
-    if (fission_nk_point_in_rect(&zones[FISSION_NK_DOCK_ZONE_TOP], x, y) != 0) {
-        return FISSION_NK_DOCK_ZONE_TOP;
-    }
-    if (fission_nk_point_in_rect(&zones[FISSION_NK_DOCK_ZONE_BOTTOM], x, y) != 0) {
-        return FISSION_NK_DOCK_ZONE_BOTTOM;
-    }
-    if (fission_nk_point_in_rect(&zones[FISSION_NK_DOCK_ZONE_CENTER], x, y) != 0) {
-        return FISSION_NK_DOCK_ZONE_CENTER;
+    hit = fission_nk_rects_find_point(zones, 5u, x, y);
+    if (hit >= 0) {
+        return (fission_nk_dock_zone_t)hit;
     }
 
     return FISSION_NK_DOCK_ZONE_NONE;
@@ -837,3 +803,227 @@ void fission_nk_draw_dock_zones_overlay(
     nk_end(ctx);
     fission_nk_overlay_style_end(ctx, &style_guard);
 }
+
+static const struct nk_command *fission_nk_command_at(
+    const struct nk_context *ctx,
+    nk_size offset
+)
+{
+    return (const struct nk_command *)(const void *)(
+        (const nk_byte *)ctx->memory.memory.ptr + offset
+    );
+}
+
+/*
+ * Tessellates one window's commands with the real nk_convert. A shallow copy of the context
+ * starts iteration at the window and ends the command buffer at the window's end, so
+ * nk_convert walks exactly this window's commands; the shared command memory is only read.
+ * Once nk_build has relinked the windows the last command may point back into another
+ * window, and the counts are left at zero.
+ */
+static void fission_nk_convert_window(
+    const struct nk_context *ctx,
+    const struct nk_window *window,
+    const fission_nk_convert_buffers_t *convert,
+    fission_nk_window_draw_stats_t *out_totals
+)
+{
+    struct nk_context scratch;
+
+    if (
+        window->seq != ctx->seq ||
+        (window->flags & NK_WINDOW_HIDDEN) != 0u ||
+        fission_nk_command_at(ctx, window->buffer.last)->next < window->buffer.end
+    ) {
+        return;
+    }
+
+    nk_buffer_clear(convert->commands);
+    nk_buffer_clear(convert->vertices);
+    nk_buffer_clear(convert->elements);
+    memcpy(&scratch, ctx, sizeof(scratch));
+    scratch.begin = ctx->begin;
+    while (scratch.begin != NULL && scratch.begin != window) {
+        scratch.begin = scratch.begin->next;
+    }
+    if (scratch.begin == NULL) {
+        return;
+    }
+    scratch.build = nk_true;
+    scratch.memory.allocated = window->buffer.end;
+    (void)nk_convert(&scratch, convert->commands, convert->vertices, convert->elements, convert->config);
+    out_totals->vertex_count = (size_t)scratch.draw_list.vertex_count;
+    out_totals->element_count = (size_t)scratch.draw_list.element_count;
+}
+
+typedef char fission_nk_command_type_count_check[
+    (NK_COMMAND_CUSTOM + 1 == FISSION_NK_COMMAND_TYPE_COUNT) ? 1 : -1
+];
+
+void fission_nk_measure_window_breakdown(
+    const struct nk_context *ctx,
+    const struct nk_window *window,
+    const fission_nk_convert_buffers_t *convert,
+    fission_nk_window_breakdown_t *out_breakdown
+)
+{
+    struct nk_rect clip;
+    nk_size offset;
+
+    if (out_breakdown == NULL) {
+        return;
+    }
+    memset(out_breakdown, 0, sizeof(*out_breakdown));
+    if (window == NULL) {
+        return;
+    }
+    out_breakdown->window = window;
+    out_breakdown->name = window->name_string;
+    out_breakdown->is_chrome = (
+        strncmp(
+            window->name_string,
+            FISSION_NK_CHROME_WINDOW_PREFIX,
+            sizeof(FISSION_NK_CHROME_WINDOW_PREFIX) - 1u
+        ) == 0
+    );
+    if (ctx == NULL || ctx->memory.memory.ptr == NULL) {
+        return;
+    }
+    if (window->buffer.end <= window->buffer.begin) {
+        return;
+    }
+
+    out_breakdown->totals.command_bytes = (size_t)(window->buffer.end - window->buffer.begin);
+    clip = nk_rect(-8192.0f, -8192.0f, 16384.0f, 16384.0f);
+    offset = window->buffer.begin;
+    while (offset < window->buffer.end) {
+        const struct nk_command *cmd;
+
+        cmd = fission_nk_command_at(ctx, offset);
+        out_breakdown->totals.command_count += 1u;
+        if ((int)cmd->type >= 0 && (int)cmd->type < FISSION_NK_COMMAND_TYPE_COUNT) {
+            out_breakdown->commands_by_type[cmd->type] += 1u;
+        }
+        if (cmd->type == NK_COMMAND_TEXT) {
+            const struct nk_command_text *t;
+
+            t = (const struct nk_command_text *)(const void *)cmd;
+            out_breakdown->text_runs += 1u;
+            out_breakdown->text_bytes += (size_t)((t->length > 0) ? t->length : 0);
+        } else if (cmd->type == NK_COMMAND_SCISSOR) {
+            const struct nk_command_scissor *sc;
+
+            sc = (const struct nk_command_scissor *)(const void *)cmd;
+            if (
+                (float)sc->x != clip.x ||
+                (float)sc->y != clip.y ||
+                (float)sc->w != clip.w ||
+                (float)sc->h != clip.h
+            ) {
+                out_breakdown->scissor_changes += 1u;
+            }
+            clip = nk_rect((float)sc->x, (float)sc->y, (float)sc->w, (float)sc->h);
+        }
+        if (cmd->next <= offset) {
+            break;
+        }
+        offset = cmd->next;
+    }
+
+    if (
+        convert != NULL &&
+        convert->config != NULL &&
+        convert->commands != NULL &&
+        convert->vertices != NULL &&
+        convert->elements != NULL
+    ) {
+        fission_nk_convert_window(ctx, window, convert, &out_breakdown->totals);
+    }
+}
+
+void fission_nk_measure_window(
+    const struct nk_context *ctx,
+    const struct nk_window *window,
+    const fission_nk_convert_buffers_t *convert,
+    fission_nk_window_draw_stats_t *out_stats
+)
+{
+    fission_nk_window_breakdown_t breakdown;
+
+    if (out_stats == NULL) {
+        return;
+    }
+
+    fission_nk_measure_window_breakdown(ctx, window, convert, &breakdown);
+    *out_stats = breakdown.totals;
+}
+
+static void fission_nk_accumulate_breakdown(
+    fission_nk_window_breakdown_t *total,
+    const fission_nk_window_breakdown_t *window
+)
+{
+    size_t i;
+
+    total->totals.command_count += window->totals.command_count;
+    total->totals.command_bytes += window->totals.command_bytes;
+    total->totals.vertex_count += window->totals.vertex_count;
+    total->totals.element_count += window->totals.element_count;
+    for (i = 0u; i < FISSION_NK_COMMAND_TYPE_COUNT; ++i) {
+        total->commands_by_type[i] += window->commands_by_type[i];
+    }
+    total->text_runs += window->text_runs;
+    total->text_bytes += window->text_bytes;
+    total->scissor_changes += window->scissor_changes;
+}
+
+size_t fission_nk_measure_frame(
+    const struct nk_context *ctx,
+    const fission_nk_convert_buffers_t *convert,
+    fission_nk_window_breakdown_t *out_windows,
+    size_t window_capacity,
+    fission_nk_frame_breakdown_t *out_summary
+)
+{
+    const struct nk_window *window;
+    size_t count;
+
+    if (out_summary != NULL) {
+        memset(out_summary, 0, sizeof(*out_summary));
+        out_summary->chrome.name = "chrome";
+        out_summary->chrome.is_chrome = 1;
+        out_summary->content.name = "content";
+    }
+    if (ctx == NULL) {
+        return 0u;
+    }
+
+    count = 0u;
+    for (window = ctx->begin; window != NULL; window = window->next) {
+        fission_nk_window_breakdown_t breakdown;
+
+        if (
+            window->seq != ctx->seq ||
+            (window->flags & NK_WINDOW_HIDDEN) != 0u ||
+            window->buffer.end <= window->buffer.begin
+        ) {
+            continue;
+        }
+
+        fission_nk_measure_window_breakdown(ctx, window, convert, &breakdown);
+        if (out_windows != NULL && count < window_capacity) {
+            out_windows[count] = breakdown;
+        }
+        if (out_summary != NULL) {
+            if (breakdown.is_chrome != 0) {
+                out_summary->chrome_window_count += 1u;
+                fission_nk_accumulate_breakdown(&out_summary->chrome, &breakdown);
+            } else {
+                out_summary->content_window_count += 1u;
+                fission_nk_accumulate_breakdown(&out_summary->content, &breakdown);
+            }
+        }
+        count += 1u;
+    }
+    return count;
+}
@@ -0,0 +1,1858 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(FISSION_TEST_HAVE_PTHREAD)
+#include <pthread.h>
+#endif
+
+#include "fission/nuklear.h"
+#include "fission/nuklear_alloc.h"
+#include "fission/nuklear_dock_tree.h"
+#include "fission/nuklear_panels.h"
+
+#define FISSION_TEST_ID_MAX 32
+#define FISSION_TEST_CHAIN_LENGTH 3
+#define FISSION_TEST_DYNAMIC_PANELS 200u
+#define FISSION_TEST_INIT_PANELS 12u
+#define FISSION_TEST_CACHE_PANELS 4u
+#define FISSION_TEST_FONT_HEIGHT 14.0f
+#define FISSION_TEST_GLYPH_WIDTH 7.0f
+
+#define FISSION_TEST_CHECK(condition) \
+    fission_test_check((condition) != 0, #condition, __FILE__, __LINE__)
+
+static int fission_test_failures = 0;
+
+static void fission_test_check(int passed, const char *condition, const char *file, int line)
+{
+    if (passed == 0) {
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, condition);
+        fission_test_failures += 1;
+    }
+}
+
+/* Same FNV-1a hash as the workspace id table, so the test can pick colliding ids. */
+static unsigned int fission_test_id_hash(const char *panel_id)
+{
+    unsigned int hash;
+
+    hash = 2166136261u;
+    while (*panel_id != '\0') {
+        hash ^= (unsigned int)(unsigned char)*panel_id;
+        hash *= 16777619u;
+        ++panel_id;
+    }
+    return hash;
+}
+
+static void fission_test_panel_draw(
+    struct nk_context *ctx,
+    fission_nk_panel_workspace_t *workspace,
+    const char *panel_id,
+    int window_width,
+    int window_height,
+    void *user_data
+)
+{
+    (void)window_width;
+    (void)window_height;
+    (void)user_data;
+
+    if (fission_nk_panel_workspace_begin_window(ctx, workspace, panel_id, NULL, 0u, NULL) != 0) {
+        nk_layout_row_dynamic(ctx, 20.0f, 1);
+        nk_label(ctx, panel_id, NK_TEXT_LEFT);
+    }
+    fission_nk_panel_workspace_end_window(ctx, workspace, panel_id);
+}
+
+static void fission_test_panel_desc(
+    const char *panel_id,
+    fission_nk_panel_slot_t slot,
+    fission_nk_panel_desc_t *out_desc
+)
+{
+    memset(out_desc, 0, sizeof(*out_desc));
+    out_desc->id = panel_id;
+    out_desc->title = panel_id;
+    out_desc->draw = fission_test_panel_draw;
+    out_desc->default_slot = slot;
+    out_desc->default_visible = 1;
+    out_desc->default_detachable = 1;
+    out_desc->default_detached_bounds.x = 80.0f;
+    out_desc->default_detached_bounds.y = 90.0f;
+    out_desc->default_detached_bounds.w = 320.0f;
+    out_desc->default_detached_bounds.h = 240.0f;
+}
+
+/*
+ * Finds ids whose home bucket in the inline id table is `home`, starting the search at
+ * *next so repeated calls never return the same id twice.
+ */
+static int fission_test_find_id(unsigned int home, unsigned int *next, char *out_id)
+{
+    unsigned int mask;
+
+    mask = (unsigned int)FISSION_NK_PANEL_ID_TABLE_SIZE - 1u;
+    while (*next < 1000000u) {
+        (void)snprintf(out_id, FISSION_TEST_ID_MAX, "test.panel.%u", *next);
+        *next += 1u;
+        if ((fission_test_id_hash(out_id) & mask) == home) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void fission_test_id_table(void)
+{
+    static char chain_ids[FISSION_TEST_CHAIN_LENGTH][FISSION_TEST_ID_MAX];
+    static char wrapped_id[FISSION_TEST_ID_MAX];
+    static char spread_ids[FISSION_NK_MAX_PANELS][FISSION_TEST_ID_MAX];
+    fission_nk_panel_workspace_t workspace;
+    fission_nk_panel_desc_t desc;
+    fission_nk_panel_handle_t chain_handles[FISSION_TEST_CHAIN_LENGTH];
+    fission_nk_panel_handle_t wrapped_handle;
+    fission_nk_panel_handle_t spread_handles[FISSION_NK_MAX_PANELS];
+    unsigned int next;
+    size_t spread_count;
+    size_t i;
+
+    /*
+     * Three ids share the last bucket, so their probe chain wraps into bucket 0, where a
+     * fourth id has its home. Removing the middle of the chain must shift the rest back
+     * without stranding either the wrapped entries or the one that lives at bucket 0.
+     */
+    next = 0u;
+    for (i = 0u; i < FISSION_TEST_CHAIN_LENGTH; ++i) {
+        FISSION_TEST_CHECK(
+            fission_test_find_id((unsigned int)FISSION_NK_PANEL_ID_TABLE_SIZE - 1u, &next, chain_ids[i])
+        );
+    }
+    next = 0u;
+    FISSION_TEST_CHECK(fission_test_find_id(0u, &next, wrapped_id));
+
+    fission_nk_panel_workspace_init(&workspace);
+    for (i = 0u; i < FISSION_TEST_CHAIN_LENGTH; ++i) {
+        fission_test_panel_desc(chain_ids[i], FISSION_NK_PANEL_SLOT_CENTER, &desc);
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_register_handle(&workspace, &desc, &chain_handles[i]) ==
+            FISSION_NK_PANEL_STATUS_OK
+        );
+    }
+    fission_test_panel_desc(wrapped_id, FISSION_NK_PANEL_SLOT_LEFT, &desc);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_handle(&workspace, &desc, &wrapped_handle) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+
+    for (i = 0u; i < FISSION_TEST_CHAIN_LENGTH; ++i) {
+        fission_test_panel_desc(chain_ids[i], FISSION_NK_PANEL_SLOT_RIGHT, &desc);
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_register(&workspace, &desc) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+        );
+    }
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_live_count(&workspace) == FISSION_TEST_CHAIN_LENGTH + 1u);
+
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_unregister(&workspace, chain_ids[1]) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, chain_ids[1]) == FISSION_NK_PANEL_HANDLE_NONE);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, chain_ids[0]) == chain_handles[0]);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, chain_ids[2]) == chain_handles[2]);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, wrapped_id) == wrapped_handle);
+
+    /* Ids still in the chain stay duplicates; the removed one registers again. */
+    fission_test_panel_desc(chain_ids[2], FISSION_NK_PANEL_SLOT_RIGHT, &desc);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register(&workspace, &desc) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    fission_test_panel_desc(chain_ids[1], FISSION_NK_PANEL_SLOT_RIGHT, &desc);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_handle(&workspace, &desc, &chain_handles[1]) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    for (i = 0u; i < FISSION_TEST_CHAIN_LENGTH; ++i) {
+        FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, chain_ids[i]) == chain_handles[i]);
+    }
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, wrapped_id) == wrapped_handle);
+    fission_nk_panel_workspace_shutdown(&workspace);
+
+    /* Fill the registry, drop every third panel, and check every id against what is left. */
+    fission_nk_panel_workspace_init(&workspace);
+    spread_count = FISSION_NK_MAX_PANELS;
+    for (i = 0u; i < spread_count; ++i) {
+        (void)snprintf(spread_ids[i], sizeof(spread_ids[i]), "test.spread.%02u", (unsigned int)i);
+        fission_test_panel_desc(spread_ids[i], (fission_nk_panel_slot_t)(i % FISSION_NK_PANEL_SLOT_COUNT), &desc);
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_register_handle(&workspace, &desc, &spread_handles[i]) ==
+            FISSION_NK_PANEL_STATUS_OK
+        );
+    }
+    for (i = 1u; i < spread_count; i += 3u) {
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_unregister(&workspace, spread_ids[i]) == FISSION_NK_PANEL_STATUS_OK
+        );
+    }
+    for (i = 0u; i < spread_count; ++i) {
+        if ((i % 3u) == 1u) {
+            FISSION_TEST_CHECK(
+                fission_nk_panel_workspace_find_handle(&workspace, spread_ids[i]) == FISSION_NK_PANEL_HANDLE_NONE
+            );
+        } else {
+            FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, spread_ids[i]) == spread_handles[i]);
+        }
+    }
+    fission_nk_panel_workspace_shutdown(&workspace);
+}
+
+static void fission_test_handles(void)
+{
+    static const char *const panel_ids[3] = {"test.alpha", "test.beta", "test.gamma"};
+    fission_nk_panel_workspace_t workspace;
+    fission_nk_panel_desc_t desc;
+    fission_nk_panel_handle_t handles[3];
+    fission_nk_panel_handle_t forged;
+    fission_nk_panel_bounds_t bounds;
+    size_t i;
+
+    fission_nk_panel_workspace_init(&workspace);
+    for (i = 0u; i < 3u; ++i) {
+        fission_test_panel_desc(panel_ids[i], FISSION_NK_PANEL_SLOT_CENTER, &desc);
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_register_handle(&workspace, &desc, &handles[i]) == FISSION_NK_PANEL_STATUS_OK
+        );
+        FISSION_TEST_CHECK(handles[i] != FISSION_NK_PANEL_HANDLE_NONE);
+        FISSION_TEST_CHECK((handles[i] & 0xFFFFu) == (unsigned int)i + 1u);
+    }
+    for (i = 0u; i < 3u; ++i) {
+        FISSION_TEST_CHECK(fission_nk_panel_workspace_handle_at(&workspace, i) == handles[i]);
+        FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, panel_ids[i]) == handles[i]);
+    }
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_handle_at(&workspace, 3u) == FISSION_NK_PANEL_HANDLE_NONE);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, "test.missing") == FISSION_NK_PANEL_HANDLE_NONE);
+
+    /* The none handle, an index past the registry and a wrong generation are all rejected. */
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_get_panel_bounds_handle(&workspace, FISSION_NK_PANEL_HANDLE_NONE, &bounds) ==
+        FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    forged = (handles[0] & 0xFFFF0000u) | 200u;
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_get_panel_bounds_handle(&workspace, forged, &bounds) ==
+        FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    forged = handles[1] ^ 0x00010000u;
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_is_visible_handle(&workspace, forged) == 0);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_visible_handle(&workspace, forged, 0) ==
+        FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_is_visible(&workspace, panel_ids[1]) != 0);
+
+    /* Handle setters act on the same entry the id API sees. */
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_visible_handle(&workspace, handles[1], 0) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_is_visible_handle(&workspace, handles[1]) == 0);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_is_visible(&workspace, panel_ids[1]) == 0);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_detached_handle(&workspace, handles[2], 1) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_is_detached_handle(&workspace, handles[2]) != 0);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_is_detached_at(&workspace, 2u) != 0);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_is_detached_handle(&workspace, handles[0]) == 0);
+    fission_nk_panel_workspace_shutdown(&workspace);
+}
+
+/* malloc-backed allocator that fails once `remaining` allocations have been handed out. */
+typedef struct fission_test_budget_allocator {
+    size_t remaining;
+} fission_test_budget_allocator_t;
+
+static void *fission_test_budget_alloc(nk_handle handle, void *old, nk_size size)
+{
+    fission_test_budget_allocator_t *budget;
+
+    (void)old;
+    budget = (fission_test_budget_allocator_t *)handle.ptr;
+    if (budget->remaining == 0u) {
+        return NULL;
+    }
+    budget->remaining -= 1u;
+    return malloc(size);
+}
+
+static void fission_test_budget_free(nk_handle handle, void *old)
+{
+    (void)handle;
+    free(old);
+}
+
+static void fission_test_dynamic_growth(void)
+{
+    static char panel_ids[FISSION_TEST_DYNAMIC_PANELS][FISSION_TEST_ID_MAX];
+    fission_nk_counting_allocator_t counting;
+    fission_nk_alloc_stats_t stats;
+    fission_test_budget_allocator_t budget;
+    struct nk_allocator allocator;
+    fission_nk_panel_workspace_t workspace;
+    fission_nk_panel_desc_t desc;
+    fission_nk_panel_handle_t handles[FISSION_TEST_DYNAMIC_PANELS];
+    size_t i;
+
+    for (i = 0u; i < FISSION_TEST_DYNAMIC_PANELS; ++i) {
+        (void)snprintf(panel_ids[i], sizeof(panel_ids[i]), "test.dynamic.%03u", (unsigned int)i);
+    }
+
+    /* Grow from 16 entries through several storage_reserve calls, past the inline limit. */
+    fission_nk_counting_allocator_init(&counting);
+    fission_nk_counting_allocator_bind(&counting, &allocator);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_init_dynamic(&workspace, &allocator, 4u) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_max_panels(&workspace) > FISSION_NK_MAX_PANELS);
+    for (i = 0u; i < FISSION_TEST_DYNAMIC_PANELS; ++i) {
+        fission_test_panel_desc(panel_ids[i], (fission_nk_panel_slot_t)(i % FISSION_NK_PANEL_SLOT_COUNT), &desc);
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_register_handle(&workspace, &desc, &handles[i]) == FISSION_NK_PANEL_STATUS_OK
+        );
+        /* State set before a reallocation has to survive it. */
+        if (i == 10u) {
+            FISSION_TEST_CHECK(
+                fission_nk_panel_workspace_set_panel_visible_handle(&workspace, handles[5], 0) ==
+                FISSION_NK_PANEL_STATUS_OK
+            );
+            FISSION_TEST_CHECK(
+                fission_nk_panel_workspace_set_panel_detached_handle(&workspace, handles[6], 1) ==
+                FISSION_NK_PANEL_STATUS_OK
+            );
+        }
+    }
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_live_count(&workspace) == FISSION_TEST_DYNAMIC_PANELS);
+    for (i = 0u; i < FISSION_TEST_DYNAMIC_PANELS; ++i) {
+        FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, panel_ids[i]) == handles[i]);
+        FISSION_TEST_CHECK(fission_nk_panel_workspace_handle_at(&workspace, i) == handles[i]);
+        FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_is_visible_at(&workspace, i) == (i != 5u));
+        FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_is_detached_at(&workspace, i) == (i == 6u));
+    }
+
+    /* Growth swaps one storage block for a bigger one; shutdown returns it. */
+    fission_nk_counting_allocator_snapshot(&counting, &stats);
+    FISSION_TEST_CHECK(stats.live_allocations == 1u);
+    FISSION_TEST_CHECK(stats.allocation_count > 1u);
+    fission_nk_panel_workspace_shutdown(&workspace);
+    fission_nk_counting_allocator_snapshot(&counting, &stats);
+    FISSION_TEST_CHECK(stats.live_allocations == 0u);
+    FISSION_TEST_CHECK(stats.live_bytes == 0u);
+
+    /* A failed growth reports RUNTIME_ERROR and leaves the panels already placed intact. */
+    budget.remaining = 1u;
+    allocator.userdata.ptr = &budget;
+    allocator.alloc = fission_test_budget_alloc;
+    allocator.free = fission_test_budget_free;
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_init_dynamic(&workspace, &allocator, 16u) == FISSION_NK_PANEL_STATUS_OK
+    );
+    for (i = 0u; i < 16u; ++i) {
+        fission_test_panel_desc(panel_ids[i], FISSION_NK_PANEL_SLOT_CENTER, &desc);
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_register_handle(&workspace, &desc, &handles[i]) == FISSION_NK_PANEL_STATUS_OK
+        );
+    }
+    fission_test_panel_desc(panel_ids[16], FISSION_NK_PANEL_SLOT_CENTER, &desc);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register(&workspace, &desc) == FISSION_NK_PANEL_STATUS_RUNTIME_ERROR
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_live_count(&workspace) == 16u);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, panel_ids[16]) == FISSION_NK_PANEL_HANDLE_NONE);
+    for (i = 0u; i < 16u; ++i) {
+        FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, panel_ids[i]) == handles[i]);
+    }
+    fission_nk_panel_workspace_shutdown(&workspace);
+
+    budget.remaining = 0u;
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_init_dynamic(&workspace, &allocator, 16u) == FISSION_NK_PANEL_STATUS_RUNTIME_ERROR
+    );
+    fission_nk_panel_workspace_shutdown(&workspace);
+}
+
+/* Per-panel init/shutdown call counts, passed as the panel's user_data. */
+typedef struct fission_test_init_record {
+    int init_calls;
+    int shutdown_calls;
+    fission_nk_panel_status_t init_result;
+} fission_test_init_record_t;
+
+static fission_nk_panel_status_t fission_test_record_init(void *user_data)
+{
+    fission_test_init_record_t *record;
+
+    record = (fission_test_init_record_t *)user_data;
+    record->init_calls += 1;
+    return record->init_result;
+}
+
+static void fission_test_record_shutdown(void *user_data)
+{
+    fission_test_init_record_t *record;
+
+    record = (fission_test_init_record_t *)user_data;
+    record->shutdown_calls += 1;
+}
+
+/* Scheduler that only queues jobs, so the workspace has to claim them itself. */
+typedef struct fission_test_job_queue {
+    fission_nk_panel_job_fn runs[FISSION_TEST_INIT_PANELS];
+    void *jobs[FISSION_TEST_INIT_PANELS];
+    size_t count;
+    int accept;
+} fission_test_job_queue_t;
+
+static int fission_test_queue_schedule(fission_nk_panel_job_fn run, void *job, void *user_data)
+{
+    fission_test_job_queue_t *queue;
+
+    queue = (fission_test_job_queue_t *)user_data;
+    if (queue->accept == 0 || queue->count == FISSION_TEST_INIT_PANELS) {
+        return 0;
+    }
+    queue->runs[queue->count] = run;
+    queue->jobs[queue->count] = job;
+    queue->count += 1u;
+    return 1;
+}
+
+static void fission_test_queue_drain(fission_test_job_queue_t *queue)
+{
+    size_t i;
+
+    for (i = 0u; i < queue->count; ++i) {
+        queue->runs[i](queue->jobs[i]);
+    }
+    queue->count = 0u;
+}
+
+#if defined(FISSION_TEST_HAVE_PTHREAD)
+typedef struct fission_test_thread_job {
+    fission_nk_panel_job_fn run;
+    void *job;
+} fission_test_thread_job_t;
+
+/* Scheduler that starts one thread per job, racing the workspace for each claim. */
+typedef struct fission_test_thread_pool {
+    pthread_t threads[FISSION_TEST_INIT_PANELS];
+    fission_test_thread_job_t jobs[FISSION_TEST_INIT_PANELS];
+    size_t count;
+} fission_test_thread_pool_t;
+
+static void *fission_test_thread_main(void *arg)
+{
+    fission_test_thread_job_t *thread_job;
+
+    thread_job = (fission_test_thread_job_t *)arg;
+    thread_job->run(thread_job->job);
+    return NULL;
+}
+
+static int fission_test_thread_schedule(fission_nk_panel_job_fn run, void *job, void *user_data)
+{
+    fission_test_thread_pool_t *pool;
+
+    pool = (fission_test_thread_pool_t *)user_data;
+    if (pool->count == FISSION_TEST_INIT_PANELS) {
+        return 0;
+    }
+    pool->jobs[pool->count].run = run;
+    pool->jobs[pool->count].job = job;
+    if (
+        pthread_create(
+            &pool->threads[pool->count],
+            NULL,
+            fission_test_thread_main,
+            &pool->jobs[pool->count]
+        ) != 0
+    ) {
+        return 0;
+    }
+    pool->count += 1u;
+    return 1;
+}
+
+static void fission_test_thread_join(fission_test_thread_pool_t *pool)
+{
+    size_t i;
+
+    for (i = 0u; i < pool->count; ++i) {
+        (void)pthread_join(pool->threads[i], NULL);
+    }
+    pool->count = 0u;
+}
+#endif
+
+static void fission_test_init_desc(
+    const char *panel_id,
+    fission_test_init_record_t *record,
+    fission_nk_panel_desc_t *out_desc
+)
+{
+    fission_test_panel_desc(panel_id, FISSION_NK_PANEL_SLOT_CENTER, out_desc);
+    out_desc->init = fission_test_record_init;
+    out_desc->shutdown = fission_test_record_shutdown;
+    out_desc->user_data = record;
+}
+
+static void fission_test_lazy_init(void)
+{
+    static char panel_ids[FISSION_TEST_INIT_PANELS][FISSION_TEST_ID_MAX];
+    fission_test_init_record_t records[FISSION_TEST_INIT_PANELS];
+    fission_nk_panel_desc_t descs[FISSION_TEST_INIT_PANELS];
+    fission_test_job_queue_t queue;
+    fission_nk_panel_workspace_t workspace;
+    size_t i;
+
+    memset(records, 0, sizeof(records));
+    for (i = 0u; i < FISSION_TEST_INIT_PANELS; ++i) {
+        (void)snprintf(panel_ids[i], sizeof(panel_ids[i]), "test.init.%02u", (unsigned int)i);
+        fission_test_init_desc(panel_ids[i], &records[i], &descs[i]);
+    }
+
+    /* Lazy without a scheduler: init waits for the first draw, and a panel never drawn skips shutdown. */
+    fission_nk_panel_workspace_init(&workspace);
+    fission_nk_panel_workspace_set_lazy_init(&workspace, 1, NULL, NULL);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register(&workspace, &descs[0]) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_many(&workspace, &descs[1], 2u) == FISSION_NK_PANEL_STATUS_OK
+    );
+    for (i = 0u; i < 3u; ++i) {
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_panel_init_state_at(&workspace, i) == FISSION_NK_PANEL_INIT_PENDING
+        );
+        FISSION_TEST_CHECK(records[i].init_calls == 0);
+    }
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_unregister(&workspace, panel_ids[0]) == FISSION_NK_PANEL_STATUS_OK);
+    fission_nk_panel_workspace_shutdown(&workspace);
+    for (i = 0u; i < 3u; ++i) {
+        FISSION_TEST_CHECK(records[i].init_calls == 0);
+        FISSION_TEST_CHECK(records[i].shutdown_calls == 0);
+    }
+
+    /*
+     * A scheduler that queues every job and never runs it: register_many claims each job
+     * while waiting and runs it inline, so draining the stale queue afterwards is a no-op.
+     */
+    memset(records, 0, sizeof(records));
+    memset(&queue, 0, sizeof(queue));
+    queue.accept = 1;
+    fission_nk_panel_workspace_init(&workspace);
+    fission_nk_panel_workspace_set_lazy_init(&workspace, 0, fission_test_queue_schedule, &queue);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_many(&workspace, descs, FISSION_TEST_INIT_PANELS) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(queue.count > 0u);
+    fission_test_queue_drain(&queue);
+    for (i = 0u; i < FISSION_TEST_INIT_PANELS; ++i) {
+        FISSION_TEST_CHECK(records[i].init_calls == 1);
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_panel_init_state_at(&workspace, i) == FISSION_NK_PANEL_INIT_READY
+        );
+    }
+    fission_nk_panel_workspace_shutdown(&workspace);
+    for (i = 0u; i < FISSION_TEST_INIT_PANELS; ++i) {
+        FISSION_TEST_CHECK(records[i].shutdown_calls == 1);
+    }
+
+    /* A refusing scheduler runs init inline; a failing init rolls the batch back. */
+    memset(records, 0, sizeof(records));
+    memset(&queue, 0, sizeof(queue));
+    records[2].init_result = FISSION_NK_PANEL_STATUS_RUNTIME_ERROR;
+    fission_nk_panel_workspace_init(&workspace);
+    fission_nk_panel_workspace_set_lazy_init(&workspace, 0, fission_test_queue_schedule, &queue);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_many(&workspace, descs, 4u) == FISSION_NK_PANEL_STATUS_RUNTIME_ERROR
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_live_count(&workspace) == 0u);
+    for (i = 0u; i < 4u; ++i) {
+        FISSION_TEST_CHECK(records[i].init_calls == 1);
+        FISSION_TEST_CHECK(records[i].shutdown_calls == ((i != 2u) ? 1 : 0));
+        FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, panel_ids[i]) == FISSION_NK_PANEL_HANDLE_NONE);
+    }
+    fission_nk_panel_workspace_shutdown(&workspace);
+
+#if defined(FISSION_TEST_HAVE_PTHREAD)
+    {
+        fission_test_thread_pool_t pool;
+        int round;
+
+        /* Workers and the waiting workspace race for every claim; each init still runs once. */
+        for (round = 0; round < 50; ++round) {
+            memset(records, 0, sizeof(records));
+            memset(&pool, 0, sizeof(pool));
+            fission_nk_panel_workspace_init(&workspace);
+            fission_nk_panel_workspace_set_lazy_init(&workspace, 0, fission_test_thread_schedule, &pool);
+            FISSION_TEST_CHECK(
+                fission_nk_panel_workspace_register_many(&workspace, descs, FISSION_TEST_INIT_PANELS) ==
+                FISSION_NK_PANEL_STATUS_OK
+            );
+            fission_test_thread_join(&pool);
+            for (i = 0u; i < FISSION_TEST_INIT_PANELS; ++i) {
+                FISSION_TEST_CHECK(records[i].init_calls == 1);
+                FISSION_TEST_CHECK(
+                    fission_nk_panel_workspace_panel_init_state_at(&workspace, i) == FISSION_NK_PANEL_INIT_READY
+                );
+            }
+            fission_nk_panel_workspace_shutdown(&workspace);
+        }
+    }
+#endif
+}
+
+static void fission_test_stale_handle(void)
+{
+    fission_nk_panel_workspace_t workspace;
+    fission_nk_panel_desc_t desc;
+    fission_nk_panel_handle_t first;
+    fission_nk_panel_handle_t second;
+    fission_nk_panel_bounds_t bounds;
+
+    fission_nk_panel_workspace_init(&workspace);
+    fission_test_panel_desc("test.first", FISSION_NK_PANEL_SLOT_CENTER, &desc);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_handle(&workspace, &desc, &first) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_unregister(&workspace, "test.first") == FISSION_NK_PANEL_STATUS_OK);
+
+    /* The next register reuses the freed entry; only the generation tells the handles apart. */
+    fission_test_panel_desc("test.second", FISSION_NK_PANEL_SLOT_CENTER, &desc);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_handle(&workspace, &desc, &second) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK((second & 0xFFFFu) == (first & 0xFFFFu));
+    FISSION_TEST_CHECK(second != first);
+
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_get_panel_bounds_handle(&workspace, first, &bounds) ==
+        FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_is_visible_handle(&workspace, first) == 0);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_visible_handle(&workspace, first, 0) ==
+        FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_unregister_handle(&workspace, first) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+
+    /* The stale calls above must not have touched the panel now living in that entry. */
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, "test.second") == second);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_is_visible_handle(&workspace, second) != 0);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_get_panel_bounds_handle(&workspace, second, &bounds) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_unregister_handle(&workspace, second) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_live_count(&workspace) == 0u);
+    fission_nk_panel_workspace_shutdown(&workspace);
+}
+
+
+static void fission_test_free_list(void)
+{
+    static char panel_ids[FISSION_NK_MAX_PANELS + 1][FISSION_TEST_ID_MAX];
+    fission_test_init_record_t records[FISSION_NK_MAX_PANELS + 1];
+    fission_nk_panel_workspace_t workspace;
+    fission_nk_panel_desc_t desc;
+    fission_nk_panel_handle_t handles[FISSION_NK_MAX_PANELS + 1];
+    fission_nk_panel_handle_t reused;
+    size_t i;
+    int cycle;
+
+    memset(records, 0, sizeof(records));
+    for (i = 0u; i <= (size_t)FISSION_NK_MAX_PANELS; ++i) {
+        (void)snprintf(panel_ids[i], sizeof(panel_ids[i]), "test.free.%02u", (unsigned int)i);
+    }
+
+    /* Fill the inline registry; one more register has nowhere to go. */
+    fission_nk_panel_workspace_init(&workspace);
+    for (i = 0u; i < (size_t)FISSION_NK_MAX_PANELS; ++i) {
+        fission_test_init_desc(panel_ids[i], &records[i], &desc);
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_register_handle(&workspace, &desc, &handles[i]) == FISSION_NK_PANEL_STATUS_OK
+        );
+    }
+    fission_test_init_desc(panel_ids[FISSION_NK_MAX_PANELS], &records[FISSION_NK_MAX_PANELS], &desc);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register(&workspace, &desc) == FISSION_NK_PANEL_STATUS_RUNTIME_ERROR);
+
+    /* Unregister runs shutdown once and leaves a hole the _at accessors skip. */
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_unregister(&workspace, panel_ids[5]) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(records[5].shutdown_calls == 1);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_unregister(&workspace, panel_ids[5]) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    FISSION_TEST_CHECK(records[5].shutdown_calls == 1);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_count(&workspace) == (size_t)FISSION_NK_MAX_PANELS);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_live_count(&workspace) == (size_t)FISSION_NK_MAX_PANELS - 1u);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_id_at(&workspace, 5u) == NULL);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_handle_at(&workspace, 5u) == FISSION_NK_PANEL_HANDLE_NONE);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, panel_ids[5]) == FISSION_NK_PANEL_HANDLE_NONE);
+
+    /* The full registry takes a new panel in the freed entry. */
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_handle(&workspace, &desc, &reused) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK((reused & 0xFFFFu) == 6u);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_count(&workspace) == (size_t)FISSION_NK_MAX_PANELS);
+
+    /* Freed entries are reused last-in first-out. */
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_unregister_handle(&workspace, handles[2]) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_unregister_handle(&workspace, handles[9]) == FISSION_NK_PANEL_STATUS_OK);
+    fission_test_init_desc(panel_ids[9], &records[9], &desc);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_handle(&workspace, &desc, &handles[9]) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK((handles[9] & 0xFFFFu) == 10u);
+    fission_test_init_desc(panel_ids[2], &records[2], &desc);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_handle(&workspace, &desc, &handles[2]) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK((handles[2] & 0xFFFFu) == 3u);
+
+    /* Hot reload of one panel never grows the registry, and each cycle bumps the generation. */
+    for (cycle = 0; cycle < 100; ++cycle) {
+        fission_nk_panel_handle_t previous;
+
+        previous = handles[0];
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_unregister_handle(&workspace, previous) == FISSION_NK_PANEL_STATUS_OK
+        );
+        fission_test_init_desc(panel_ids[0], &records[0], &desc);
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_register_handle(&workspace, &desc, &handles[0]) == FISSION_NK_PANEL_STATUS_OK
+        );
+        FISSION_TEST_CHECK((handles[0] & 0xFFFFu) == 1u);
+        FISSION_TEST_CHECK(handles[0] != previous);
+        FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, panel_ids[0]) == handles[0]);
+    }
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_count(&workspace) == (size_t)FISSION_NK_MAX_PANELS);
+    FISSION_TEST_CHECK(records[0].init_calls == 101);
+    FISSION_TEST_CHECK(records[0].shutdown_calls == 100);
+    fission_nk_panel_workspace_shutdown(&workspace);
+    FISSION_TEST_CHECK(records[0].shutdown_calls == 101);
+}
+
+static fission_test_init_record_t fission_test_table_records[3];
+
+FISSION_NK_PANEL_TABLE(
+    fission_test_table,
+    FISSION_NK_PANEL_STATIC_DESC(
+        "test.table.scene",
+        .title = "Scene",
+        .init = fission_test_record_init,
+        .shutdown = fission_test_record_shutdown,
+        .draw = fission_test_panel_draw,
+        .user_data = &fission_test_table_records[0],
+        .default_slot = FISSION_NK_PANEL_SLOT_CENTER
+    ),
+    FISSION_NK_PANEL_STATIC_DESC(
+        "test.table.log",
+        .title = "Log",
+        .init = fission_test_record_init,
+        .shutdown = fission_test_record_shutdown,
+        .draw = fission_test_panel_draw,
+        .user_data = &fission_test_table_records[1],
+        .default_slot = FISSION_NK_PANEL_SLOT_BOTTOM
+    ),
+    FISSION_NK_PANEL_STATIC_DESC(
+        "test.table.an.id.longer.than.the.hash.limit",
+        .title = "Long",
+        .init = fission_test_record_init,
+        .shutdown = fission_test_record_shutdown,
+        .draw = fission_test_panel_draw,
+        .user_data = &fission_test_table_records[2],
+        .default_slot = FISSION_NK_PANEL_SLOT_LEFT
+    )
+);
+
+static void fission_test_adopt_table(void)
+{
+    fission_nk_panel_workspace_t workspace;
+    fission_nk_panel_desc_t desc;
+    fission_nk_panel_handle_t handle;
+    size_t i;
+
+    /* The compile-time hash matches the runtime one, or is 0 past the length limit. */
+#if defined(__GNUC__) || defined(__clang__)
+    FISSION_TEST_CHECK(fission_test_table.rows[0].id_hash == fission_test_id_hash("test.table.scene"));
+    FISSION_TEST_CHECK(fission_test_table.rows[1].id_hash == fission_test_id_hash("test.table.log"));
+    FISSION_TEST_CHECK(FISSION_NK_PANEL_ID_HASH("") == fission_test_id_hash(""));
+#endif
+    FISSION_TEST_CHECK(fission_test_table.rows[2].id_hash == 0u);
+    FISSION_TEST_CHECK(fission_test_table.count == 3u);
+
+    /* Row i lands at entry i; long ids are hashed at adopt time and still found. */
+    memset(fission_test_table_records, 0, sizeof(fission_test_table_records));
+    fission_nk_panel_workspace_init(&workspace);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_adopt_table(&workspace, &fission_test_table) == FISSION_NK_PANEL_STATUS_OK
+    );
+    for (i = 0u; i < fission_test_table.count; ++i) {
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_panel_id_at(&workspace, i) == fission_test_table.rows[i].desc.id
+        );
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_find_handle(&workspace, fission_test_table.rows[i].desc.id) ==
+            fission_nk_panel_workspace_handle_at(&workspace, i)
+        );
+        FISSION_TEST_CHECK(fission_test_table_records[i].init_calls == 1);
+    }
+
+    /* Adopted panels unregister like any other, and a second adopt needs an empty workspace. */
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_adopt_table(&workspace, &fission_test_table) ==
+        FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_unregister(&workspace, "test.table.log") == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_test_table_records[1].shutdown_calls == 1);
+    fission_test_panel_desc("test.table.extra", FISSION_NK_PANEL_SLOT_RIGHT, &desc);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_handle(&workspace, &desc, &handle) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK((handle & 0xFFFFu) == 2u);
+    fission_nk_panel_workspace_shutdown(&workspace);
+    FISSION_TEST_CHECK(fission_test_table_records[0].shutdown_calls == 1);
+    FISSION_TEST_CHECK(fission_test_table_records[1].shutdown_calls == 1);
+    FISSION_TEST_CHECK(fission_test_table_records[2].shutdown_calls == 1);
+
+    /* A failed init rolls back to an empty workspace, so a retry can adopt the table again. */
+    memset(fission_test_table_records, 0, sizeof(fission_test_table_records));
+    fission_test_table_records[1].init_result = FISSION_NK_PANEL_STATUS_RUNTIME_ERROR;
+    fission_nk_panel_workspace_init(&workspace);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_adopt_table(&workspace, &fission_test_table) ==
+        FISSION_NK_PANEL_STATUS_RUNTIME_ERROR
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_count(&workspace) == 0u);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_live_count(&workspace) == 0u);
+    FISSION_TEST_CHECK(fission_test_table_records[0].shutdown_calls == 1);
+    FISSION_TEST_CHECK(fission_test_table_records[1].shutdown_calls == 0);
+    FISSION_TEST_CHECK(fission_test_table_records[2].init_calls == 0);
+    FISSION_TEST_CHECK(fission_test_table_records[2].shutdown_calls == 0);
+    for (i = 0u; i < fission_test_table.count; ++i) {
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_find_handle(&workspace, fission_test_table.rows[i].desc.id) ==
+            FISSION_NK_PANEL_HANDLE_NONE
+        );
+    }
+    fission_test_table_records[1].init_result = FISSION_NK_PANEL_STATUS_OK;
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_adopt_table(&workspace, &fission_test_table) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_live_count(&workspace) == fission_test_table.count);
+    FISSION_TEST_CHECK(fission_test_table_records[0].init_calls == 2);
+    fission_nk_panel_workspace_shutdown(&workspace);
+
+    /* Entries freed by unregister do not block an adopt either. */
+    memset(fission_test_table_records, 0, sizeof(fission_test_table_records));
+    fission_nk_panel_workspace_init(&workspace);
+    fission_test_panel_desc("test.table.extra", FISSION_NK_PANEL_SLOT_RIGHT, &desc);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register(&workspace, &desc) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_unregister(&workspace, "test.table.extra") == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_adopt_table(&workspace, &fission_test_table) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_count(&workspace) == fission_test_table.count);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, "test.table.extra") == FISSION_NK_PANEL_HANDLE_NONE);
+    fission_nk_panel_workspace_shutdown(&workspace);
+}
+
+static void fission_test_register_many(void)
+{
+    static char panel_ids[FISSION_TEST_INIT_PANELS][FISSION_TEST_ID_MAX];
+    fission_test_init_record_t records[FISSION_TEST_INIT_PANELS];
+    fission_nk_panel_desc_t descs[FISSION_TEST_INIT_PANELS];
+    fission_nk_panel_workspace_tabs_t tabs;
+    fission_nk_panel_workspace_t workspace;
+    size_t tab_index;
+    size_t i;
+    int cycle;
+
+    memset(records, 0, sizeof(records));
+    for (i = 0u; i < FISSION_TEST_INIT_PANELS; ++i) {
+        (void)snprintf(panel_ids[i], sizeof(panel_ids[i]), "test.many.%02u", (unsigned int)i);
+        fission_test_init_desc(panel_ids[i], &records[i], &descs[i]);
+    }
+
+    /* Invalid descs and duplicate ids, in the batch or already registered, reject the whole batch. */
+    fission_nk_panel_workspace_init(&workspace);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_many(&workspace, NULL, 1u) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register_many(&workspace, NULL, 0u) == FISSION_NK_PANEL_STATUS_OK);
+    descs[2].title = NULL;
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_many(&workspace, descs, 4u) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    descs[2].title = panel_ids[2];
+    descs[3].draw = NULL;
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_many(&workspace, descs, 4u) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    descs[3].draw = fission_test_panel_draw;
+    descs[3].id = panel_ids[1];
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_many(&workspace, descs, 4u) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    descs[3].id = panel_ids[3];
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_count(&workspace) == 0u);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_live_count(&workspace) == 0u);
+    for (i = 0u; i < 4u; ++i) {
+        FISSION_TEST_CHECK(records[i].init_calls == 0);
+        FISSION_TEST_CHECK(records[i].shutdown_calls == 0);
+    }
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register(&workspace, &descs[4]) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_many(&workspace, &descs[3], 3u) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_count(&workspace) == 1u);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, panel_ids[3]) == FISSION_NK_PANEL_HANDLE_NONE);
+
+    /* Freed entries are filled first, most recently freed first, and the rest appended. */
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register_many(&workspace, descs, 3u) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_unregister(&workspace, panel_ids[0]) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_unregister(&workspace, panel_ids[2]) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_many(&workspace, &descs[5], 3u) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_count(&workspace) == 5u);
+    FISSION_TEST_CHECK((fission_nk_panel_workspace_find_handle(&workspace, panel_ids[5]) & 0xFFFFu) == 4u);
+    FISSION_TEST_CHECK((fission_nk_panel_workspace_find_handle(&workspace, panel_ids[6]) & 0xFFFFu) == 2u);
+    FISSION_TEST_CHECK((fission_nk_panel_workspace_find_handle(&workspace, panel_ids[7]) & 0xFFFFu) == 5u);
+
+    /*
+     * A failed init unregisters the batch with shutdown only for inits that succeeded, and
+     * the entries it appended come off the end again, leaving the free list usable.
+     */
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_unregister(&workspace, panel_ids[1]) == FISSION_NK_PANEL_STATUS_OK);
+    memset(records, 0, sizeof(records));
+    records[9].init_result = FISSION_NK_PANEL_STATUS_RUNTIME_ERROR;
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_register_many(&workspace, &descs[8], 3u) == FISSION_NK_PANEL_STATUS_RUNTIME_ERROR
+    );
+    FISSION_TEST_CHECK(records[8].init_calls == 1);
+    FISSION_TEST_CHECK(records[8].shutdown_calls == 1);
+    FISSION_TEST_CHECK(records[9].shutdown_calls == 0);
+    FISSION_TEST_CHECK(records[10].shutdown_calls == ((records[10].init_calls != 0) ? 1 : 0));
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_count(&workspace) == 5u);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_live_count(&workspace) == 4u);
+    for (i = 8u; i < 11u; ++i) {
+        FISSION_TEST_CHECK(fission_nk_panel_workspace_find_handle(&workspace, panel_ids[i]) == FISSION_NK_PANEL_HANDLE_NONE);
+    }
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register(&workspace, &descs[1]) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK((fission_nk_panel_workspace_find_handle(&workspace, panel_ids[1]) & 0xFFFFu) <= 5u);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_count(&workspace) == 5u);
+    fission_nk_panel_workspace_shutdown(&workspace);
+
+    /* Hot load/unload of a batch never exhausts the inline registry. */
+    memset(records, 0, sizeof(records));
+    fission_nk_panel_workspace_init(&workspace);
+    for (cycle = 0; cycle < 100; ++cycle) {
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_register_many(&workspace, descs, FISSION_TEST_INIT_PANELS) ==
+            FISSION_NK_PANEL_STATUS_OK
+        );
+        for (i = 0u; i < FISSION_TEST_INIT_PANELS; ++i) {
+            FISSION_TEST_CHECK(
+                fission_nk_panel_workspace_unregister(&workspace, panel_ids[i]) == FISSION_NK_PANEL_STATUS_OK
+            );
+        }
+    }
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_count(&workspace) == FISSION_TEST_INIT_PANELS);
+    fission_nk_panel_workspace_shutdown(&workspace);
+
+    /* Tabs seed panels that landed in reused entries, not just the appended tail. */
+    fission_nk_panel_workspace_init(&workspace);
+    fission_nk_panel_workspace_tabs_init(&tabs);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_tabs_register_many(&tabs, &workspace, descs, 2u) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_tabs_create(&tabs, &workspace, "Second", &tab_index) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_tabs_set_active(&tabs, &workspace, 0u) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_unregister(&workspace, panel_ids[0]) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_tabs_register_many(&tabs, &workspace, &descs[2], 2u) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_tabs_set_active(&tabs, &workspace, tab_index) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_is_visible(&workspace, panel_ids[2]) != 0);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_is_visible(&workspace, panel_ids[3]) != 0);
+    /* The new tab started with every panel hidden, and seeding leaves older panels alone. */
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_panel_is_visible(&workspace, panel_ids[1]) == 0);
+    fission_nk_panel_workspace_tabs_shutdown(&tabs);
+    fission_nk_panel_workspace_shutdown(&workspace);
+}
+
+static float fission_test_font_width(
+    nk_handle handle,
+    float height,
+    const char *text,
+    int len
+)
+{
+    (void)handle;
+    (void)height;
+    (void)text;
+    return (float)len * FISSION_TEST_GLYPH_WIDTH;
+}
+
+static void fission_test_font_query(
+    nk_handle handle,
+    float font_height,
+    struct nk_user_font_glyph *glyph,
+    nk_rune codepoint,
+    nk_rune next_codepoint
+)
+{
+    (void)handle;
+    (void)codepoint;
+    (void)next_codepoint;
+
+    memset(glyph, 0, sizeof(*glyph));
+    glyph->width = FISSION_TEST_GLYPH_WIDTH;
+    glyph->height = font_height;
+    glyph->xadvance = FISSION_TEST_GLYPH_WIDTH;
+}
+
+static void fission_test_frame(
+    struct nk_context *ctx,
+    fission_nk_panel_workspace_t *workspace,
+    int window_width,
+    int window_height
+)
+{
+    nk_input_begin(ctx);
+    nk_input_end(ctx);
+    fission_nk_panel_workspace_draw_all(workspace, ctx, window_width, window_height);
+    nk_clear(ctx);
+}
+
+/* A context with a fixed-width stub font, enough for panels to lay out and begin windows. */
+static int fission_test_context_init(struct nk_context *ctx, struct nk_user_font *font)
+{
+    memset(font, 0, sizeof(*font));
+    font->height = FISSION_TEST_FONT_HEIGHT;
+    font->width = fission_test_font_width;
+    font->query = fission_test_font_query;
+    if (!nk_init_default(ctx, font)) {
+        FISSION_TEST_CHECK(!"nk_init_default failed");
+        return 0;
+    }
+    return 1;
+}
+
+/* Draws one frame; returns nonzero when it re-resolved the layout and left it clean. */
+static int fission_test_frame_resolves(
+    struct nk_context *ctx,
+    fission_nk_panel_workspace_t *workspace,
+    int window_width,
+    int window_height
+)
+{
+    unsigned int generation;
+
+    generation = fission_nk_panel_workspace_layout_generation(workspace);
+    fission_test_frame(ctx, workspace, window_width, window_height);
+    return fission_nk_panel_workspace_layout_generation(workspace) != generation &&
+        fission_nk_panel_workspace_layout_dirty(workspace) == 0;
+}
+
+static void fission_test_layout_dirty(void)
+{
+    struct nk_context ctx;
+    struct nk_user_font font;
+    fission_nk_panel_workspace_t workspace;
+    fission_nk_panel_desc_t desc;
+    fission_nk_panel_bounds_t bounds;
+    unsigned int generation;
+
+    if (fission_test_context_init(&ctx, &font) == 0) {
+        return;
+    }
+    fission_nk_panel_workspace_init(&workspace);
+    fission_test_panel_desc("test.dirty.left", FISSION_NK_PANEL_SLOT_LEFT, &desc);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register(&workspace, &desc) == FISSION_NK_PANEL_STATUS_OK);
+    fission_test_panel_desc("test.dirty.center", FISSION_NK_PANEL_SLOT_CENTER, &desc);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register(&workspace, &desc) == FISSION_NK_PANEL_STATUS_OK);
+    fission_test_panel_desc("test.dirty.bottom", FISSION_NK_PANEL_SLOT_BOTTOM, &desc);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register(&workspace, &desc) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_layout_dirty(&workspace) != 0);
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1280, 720));
+
+    /* Idle frames at the same size keep the generation. */
+    generation = fission_nk_panel_workspace_layout_generation(&workspace);
+    fission_test_frame(&ctx, &workspace, 1280, 720);
+    fission_test_frame(&ctx, &workspace, 1280, 720);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_layout_generation(&workspace) == generation);
+
+    /* Each layout input marks the layout dirty, and the next frame resolves it. */
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_visible_at(&workspace, 0u, 0) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_layout_dirty(&workspace) != 0);
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_visible_at(&workspace, 0u, 1) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+    fission_nk_panel_workspace_set_column_ratios(&workspace, 0.30f, 0.20f);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_layout_dirty(&workspace) != 0);
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+    fission_nk_panel_workspace_set_row_ratios(&workspace, 0.20f, 0.30f);
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_slot_at(&workspace, 2u, FISSION_NK_PANEL_SLOT_RIGHT) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_detached_at(&workspace, 1u, 1) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+    bounds.x = 40.0f;
+    bounds.y = 50.0f;
+    bounds.w = 300.0f;
+    bounds.h = 200.0f;
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_detached_bounds_handle(
+            &workspace,
+            fission_nk_panel_workspace_handle_at(&workspace, 1u),
+            &bounds
+        ) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+    fission_nk_panel_workspace_invalidate_layout(&workspace);
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_unregister(&workspace, "test.dirty.bottom") == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+
+    /* Setters that leave an input unchanged do not dirty the layout. */
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_visible_at(&workspace, 0u, 1) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_detached_at(&workspace, 1u, 1) == FISSION_NK_PANEL_STATUS_OK
+    );
+    fission_nk_panel_workspace_set_column_ratios(&workspace, 0.30f, 0.20f);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_layout_dirty(&workspace) == 0);
+    generation = fission_nk_panel_workspace_layout_generation(&workspace);
+    fission_test_frame(&ctx, &workspace, 1000, 600);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_layout_generation(&workspace) == generation);
+
+    fission_nk_panel_workspace_shutdown(&workspace);
+    nk_free(&ctx);
+}
+
+static int fission_test_bounds_are(
+    const fission_nk_panel_bounds_t *bounds,
+    float x,
+    float y,
+    float w,
+    float h
+)
+{
+    return bounds->x == x && bounds->y == y && bounds->w == w && bounds->h == h;
+}
+
+static void fission_test_dock_tree_edit(void)
+{
+    fission_nk_dock_tree_t tree;
+    size_t right;
+    size_t added;
+    size_t reused;
+
+    fission_nk_dock_tree_init(&tree, 7);
+    FISSION_TEST_CHECK(tree.node_count == 1u && tree.root == 0u);
+    FISSION_TEST_CHECK(tree.nodes[0].kind == (unsigned char)FISSION_NK_DOCK_NODE_LEAF);
+    FISSION_TEST_CHECK(tree.nodes[0].tag == 7 && tree.nodes[0].occupied == 1u);
+    FISSION_TEST_CHECK(fission_nk_dock_tree_remove(&tree, 0u) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT);
+
+    /* Splitting inserts a split node above the leaf, which keeps its index. */
+    right = fission_nk_dock_tree_split(&tree, 0u, FISSION_NK_DOCK_AXIS_ROW, 0.25f, 8, 0);
+    FISSION_TEST_CHECK(right == 2u);
+    FISSION_TEST_CHECK(tree.root == 1u && tree.nodes[1].kind == (unsigned char)FISSION_NK_DOCK_NODE_SPLIT);
+    FISSION_TEST_CHECK(tree.nodes[1].first == 0u && tree.nodes[1].second == 2u);
+    FISSION_TEST_CHECK(tree.nodes[0].parent == 1u && tree.nodes[2].parent == 1u);
+    FISSION_TEST_CHECK(tree.nodes[1].ratio == 0.25f && tree.nodes[1].occupied == 2u);
+    FISSION_TEST_CHECK(tree.nodes[2].tag == 8 && tree.nodes[2].occupied == 1u);
+
+    /* Only leaves split, and ratios clamp to min_ratio. */
+    FISSION_TEST_CHECK(
+        fission_nk_dock_tree_split(&tree, 1u, FISSION_NK_DOCK_AXIS_ROW, 0.5f, 9, 0) == FISSION_NK_DOCK_NODE_NONE
+    );
+    added = fission_nk_dock_tree_split(&tree, right, FISSION_NK_DOCK_AXIS_COLUMN, 0.0f, 9, 1);
+    FISSION_TEST_CHECK(added == 4u && tree.node_count == 5u);
+    FISSION_TEST_CHECK(tree.nodes[3].first == 4u && tree.nodes[3].second == right);
+    FISSION_TEST_CHECK(tree.nodes[3].ratio == tree.min_ratio);
+    FISSION_TEST_CHECK(tree.nodes[1].second == 3u && tree.nodes[tree.root].occupied == 3u);
+    FISSION_TEST_CHECK(fission_nk_dock_tree_set_ratio(&tree, 3u, 2.0f) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(tree.nodes[3].ratio == 1.0f - tree.min_ratio);
+    FISSION_TEST_CHECK(fission_nk_dock_tree_set_ratio(&tree, right, 0.5f) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT);
+
+    /* Removing a leaf collapses its parent: the sibling takes the parent's place. */
+    FISSION_TEST_CHECK(fission_nk_dock_tree_remove(&tree, 1u) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT);
+    FISSION_TEST_CHECK(fission_nk_dock_tree_remove(&tree, added) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(tree.nodes[1].second == right && tree.nodes[right].parent == 1u);
+    FISSION_TEST_CHECK(tree.nodes[3].kind == (unsigned char)FISSION_NK_DOCK_NODE_FREE);
+    FISSION_TEST_CHECK(tree.nodes[4].kind == (unsigned char)FISSION_NK_DOCK_NODE_FREE);
+    FISSION_TEST_CHECK(tree.nodes[tree.root].occupied == 2u);
+    FISSION_TEST_CHECK(fission_nk_dock_tree_remove(&tree, added) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT);
+
+    /* The freed nodes are reused before the pool grows. */
+    reused = fission_nk_dock_tree_split(&tree, 0u, FISSION_NK_DOCK_AXIS_COLUMN, 0.5f, 10, 0);
+    FISSION_TEST_CHECK((reused == 3u || reused == 4u) && tree.node_count == 5u);
+    FISSION_TEST_CHECK(tree.nodes[reused].tag == 10 && tree.nodes[tree.nodes[reused].parent].first == 0u);
+
+    /* Removing the root's child makes the sibling the root. */
+    FISSION_TEST_CHECK(fission_nk_dock_tree_remove(&tree, right) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(tree.root == tree.nodes[reused].parent);
+    FISSION_TEST_CHECK(tree.nodes[tree.root].parent == FISSION_NK_DOCK_NODE_NONE);
+}
+
+static void fission_test_dock_tree_layout(void)
+{
+    fission_nk_dock_tree_t tree;
+    fission_nk_panel_bounds_t bounds;
+    size_t left;
+    size_t right;
+    size_t bottom;
+    size_t row_split;
+    size_t column_split;
+
+    /* Left leaf | right leaf over bottom leaf, in a 410x210 area with the 10px gap. */
+    fission_nk_dock_tree_init(&tree, 0);
+    left = tree.root;
+    right = fission_nk_dock_tree_split(&tree, left, FISSION_NK_DOCK_AXIS_ROW, 0.25f, 1, 0);
+    bottom = fission_nk_dock_tree_split(&tree, right, FISSION_NK_DOCK_AXIS_COLUMN, 0.5f, 2, 0);
+    row_split = tree.root;
+    column_split = tree.nodes[right].parent;
+    bounds.x = 0.0f;
+    bounds.y = 0.0f;
+    bounds.w = 410.0f;
+    bounds.h = 210.0f;
+    fission_nk_dock_tree_resolve(&tree, &bounds);
+    FISSION_TEST_CHECK(fission_test_bounds_are(&tree.nodes[left].bounds, 0.0f, 0.0f, 100.0f, 210.0f));
+    FISSION_TEST_CHECK(fission_test_bounds_are(&tree.nodes[row_split].splitter, 100.0f, 0.0f, 10.0f, 210.0f));
+    FISSION_TEST_CHECK(fission_test_bounds_are(&tree.nodes[right].bounds, 110.0f, 0.0f, 300.0f, 100.0f));
+    FISSION_TEST_CHECK(fission_test_bounds_are(&tree.nodes[column_split].splitter, 110.0f, 100.0f, 300.0f, 10.0f));
+    FISSION_TEST_CHECK(fission_test_bounds_are(&tree.nodes[bottom].bounds, 110.0f, 110.0f, 300.0f, 100.0f));
+
+    FISSION_TEST_CHECK(fission_nk_dock_tree_hit_splitter(&tree, 105.0f, 50.0f) == row_split);
+    FISSION_TEST_CHECK(fission_nk_dock_tree_hit_splitter(&tree, 200.0f, 105.0f) == column_split);
+    FISSION_TEST_CHECK(fission_nk_dock_tree_hit_splitter(&tree, 50.0f, 50.0f) == FISSION_NK_DOCK_NODE_NONE);
+
+    /* An empty leaf hands its space to its sibling and its split loses the splitter. */
+    FISSION_TEST_CHECK(fission_nk_dock_tree_set_occupied(&tree, bottom, 0) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(fission_nk_dock_tree_set_occupied(&tree, bottom, 0) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(tree.nodes[row_split].occupied == 2u);
+    fission_nk_dock_tree_resolve(&tree, &bounds);
+    FISSION_TEST_CHECK(fission_test_bounds_are(&tree.nodes[right].bounds, 110.0f, 0.0f, 300.0f, 210.0f));
+    FISSION_TEST_CHECK(fission_test_bounds_are(&tree.nodes[bottom].bounds, 0.0f, 0.0f, 0.0f, 0.0f));
+    FISSION_TEST_CHECK(fission_nk_dock_tree_hit_splitter(&tree, 200.0f, 105.0f) == FISSION_NK_DOCK_NODE_NONE);
+    FISSION_TEST_CHECK(fission_nk_dock_tree_drag_splitter(&tree, column_split, 20.0f) == 0);
+
+    /* A whole empty subtree collapses too. */
+    FISSION_TEST_CHECK(fission_nk_dock_tree_set_occupied(&tree, right, 0) == FISSION_NK_PANEL_STATUS_OK);
+    fission_nk_dock_tree_resolve(&tree, &bounds);
+    FISSION_TEST_CHECK(fission_test_bounds_are(&tree.nodes[left].bounds, 0.0f, 0.0f, 410.0f, 210.0f));
+    FISSION_TEST_CHECK(fission_test_bounds_are(&tree.nodes[right].bounds, 0.0f, 0.0f, 0.0f, 0.0f));
+    FISSION_TEST_CHECK(fission_nk_dock_tree_hit_splitter(&tree, 105.0f, 50.0f) == FISSION_NK_DOCK_NODE_NONE);
+    FISSION_TEST_CHECK(
+        fission_nk_dock_tree_set_occupied(&tree, row_split, 1) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+
+    /* Dragging moves the ratio by delta over the split's extent and clamps at min_ratio. */
+    FISSION_TEST_CHECK(fission_nk_dock_tree_set_occupied(&tree, right, 1) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(fission_nk_dock_tree_set_occupied(&tree, bottom, 1) == FISSION_NK_PANEL_STATUS_OK);
+    fission_nk_dock_tree_resolve(&tree, &bounds);
+    FISSION_TEST_CHECK(fission_nk_dock_tree_drag_splitter(&tree, row_split, 100.0f) == 1);
+    FISSION_TEST_CHECK(tree.nodes[row_split].ratio == 0.5f);
+    fission_nk_dock_tree_resolve(&tree, &bounds);
+    FISSION_TEST_CHECK(fission_test_bounds_are(&tree.nodes[left].bounds, 0.0f, 0.0f, 200.0f, 210.0f));
+    FISSION_TEST_CHECK(fission_test_bounds_are(&tree.nodes[right].bounds, 210.0f, 0.0f, 200.0f, 100.0f));
+    FISSION_TEST_CHECK(fission_nk_dock_tree_drag_splitter(&tree, row_split, -1000.0f) == 1);
+    FISSION_TEST_CHECK(tree.nodes[row_split].ratio == tree.min_ratio);
+    FISSION_TEST_CHECK(fission_nk_dock_tree_drag_splitter(&tree, row_split, -10.0f) == 0);
+    FISSION_TEST_CHECK(fission_nk_dock_tree_drag_splitter(&tree, left, 10.0f) == 0);
+}
+
+/* Draws a workspace docked on a two-leaf tree, then returns it to the grid. */
+static void fission_test_dock_tree_workspace(void)
+{
+    struct nk_context ctx;
+    struct nk_user_font font;
+    fission_nk_panel_workspace_t workspace;
+    fission_nk_dock_tree_t tree;
+    fission_nk_panel_desc_t desc;
+    fission_nk_panel_bounds_t left_bounds;
+    fission_nk_panel_bounds_t center_bounds;
+    size_t center;
+    size_t left;
+
+    if (fission_test_context_init(&ctx, &font) == 0) {
+        return;
+    }
+    fission_nk_panel_workspace_init(&workspace);
+    fission_test_panel_desc("test.tree.left", FISSION_NK_PANEL_SLOT_LEFT, &desc);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register(&workspace, &desc) == FISSION_NK_PANEL_STATUS_OK);
+    fission_test_panel_desc("test.tree.center", FISSION_NK_PANEL_SLOT_CENTER, &desc);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register(&workspace, &desc) == FISSION_NK_PANEL_STATUS_OK);
+
+    fission_nk_dock_tree_init(&tree, (int)FISSION_NK_PANEL_SLOT_CENTER);
+    center = tree.root;
+    left = fission_nk_dock_tree_split(
+        &tree,
+        center,
+        FISSION_NK_DOCK_AXIS_ROW,
+        0.4f,
+        (int)FISSION_NK_PANEL_SLOT_LEFT,
+        1
+    );
+    /* A slot leaf with no docked panels collapses. */
+    (void)fission_nk_dock_tree_split(
+        &tree,
+        center,
+        FISSION_NK_DOCK_AXIS_COLUMN,
+        0.5f,
+        (int)FISSION_NK_PANEL_SLOT_BOTTOM,
+        0
+    );
+    fission_nk_panel_workspace_set_dock_tree(&workspace, &tree);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_dock_tree(&workspace) == &tree);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_layout_dirty(&workspace) != 0);
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_get_panel_bounds(&workspace, "test.tree.left", &left_bounds) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_get_panel_bounds(&workspace, "test.tree.center", &center_bounds) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(memcmp(&left_bounds, &tree.nodes[left].bounds, sizeof(left_bounds)) == 0);
+    FISSION_TEST_CHECK(memcmp(&center_bounds, &tree.nodes[center].bounds, sizeof(center_bounds)) == 0);
+    FISSION_TEST_CHECK(tree.nodes[tree.nodes[center].parent].occupied == 1u);
+    FISSION_TEST_CHECK(left_bounds.x + left_bounds.w + FISSION_NK_DOCK_TREE_GAP == center_bounds.x);
+    FISSION_TEST_CHECK(left_bounds.h == center_bounds.h);
+
+    /* Hiding the left panel gives its leaf's space to the center. */
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_visible_at(&workspace, 0u, 0) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+    FISSION_TEST_CHECK(tree.nodes[left].occupied == 0u);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_get_panel_bounds(&workspace, "test.tree.center", &center_bounds) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(center_bounds.x == left_bounds.x);
+    FISSION_TEST_CHECK(center_bounds.w == tree.nodes[tree.root].bounds.w);
+
+    /* A tree edited directly takes effect after invalidate_layout. */
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_visible_at(&workspace, 0u, 1) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+    FISSION_TEST_CHECK(fission_nk_dock_tree_set_ratio(&tree, tree.root, 0.2f) == FISSION_NK_PANEL_STATUS_OK);
+    fission_nk_panel_workspace_invalidate_layout(&workspace);
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_get_panel_bounds(&workspace, "test.tree.left", &left_bounds) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(memcmp(&left_bounds, &tree.nodes[left].bounds, sizeof(left_bounds)) == 0);
+
+    fission_nk_panel_workspace_set_dock_tree(&workspace, NULL);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_dock_tree(&workspace) == NULL);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_layout_dirty(&workspace) != 0);
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1000, 600));
+
+    fission_nk_panel_workspace_shutdown(&workspace);
+    nk_free(&ctx);
+}
+
+static void fission_test_tabbed_slot(void)
+{
+    struct nk_context ctx;
+    struct nk_user_font font;
+    fission_nk_panel_workspace_t workspace;
+    fission_nk_panel_desc_t desc;
+    fission_nk_panel_bounds_t first_bounds;
+    fission_nk_panel_bounds_t second_bounds;
+    struct nk_window *window;
+
+    if (fission_test_context_init(&ctx, &font) == 0) {
+        return;
+    }
+    fission_nk_panel_workspace_init(&workspace);
+    fission_test_panel_desc("test.tab.first", FISSION_NK_PANEL_SLOT_LEFT, &desc);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register(&workspace, &desc) == FISSION_NK_PANEL_STATUS_OK);
+    fission_test_panel_desc("test.tab.second", FISSION_NK_PANEL_SLOT_LEFT, &desc);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register(&workspace, &desc) == FISSION_NK_PANEL_STATUS_OK);
+    fission_test_panel_desc("test.tab.center", FISSION_NK_PANEL_SLOT_CENTER, &desc);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_register(&workspace, &desc) == FISSION_NK_PANEL_STATUS_OK);
+
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_slot_is_tabbed(&workspace, FISSION_NK_PANEL_SLOT_LEFT) == 0);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_slot_active_tab(&workspace, FISSION_NK_PANEL_SLOT_LEFT) == 3u);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_slot_tabbed(&workspace, FISSION_NK_PANEL_SLOT_COUNT, 1) ==
+        FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_slot_tabbed(&workspace, FISSION_NK_PANEL_SLOT_LEFT, 1) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_slot_is_tabbed(&workspace, FISSION_NK_PANEL_SLOT_LEFT) != 0);
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1280, 720));
+
+    /* The first docked panel starts selected, and every tab shares the slot's content rect. */
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_slot_active_tab(&workspace, FISSION_NK_PANEL_SLOT_LEFT) == 0u);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_slot_active_tab(&workspace, FISSION_NK_PANEL_SLOT_CENTER) == 3u
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_get_panel_bounds(&workspace, "test.tab.first", &first_bounds) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_get_panel_bounds(&workspace, "test.tab.second", &second_bounds) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(memcmp(&first_bounds, &second_bounds, sizeof(first_bounds)) == 0);
+    FISSION_TEST_CHECK(nk_window_find(&ctx, "test.tab.first") != NULL);
+    FISSION_TEST_CHECK(nk_window_find(&ctx, "test.tab.second") == NULL);
+
+    /* A deselected tab keeps its window, hidden, with its scroll offset across frames. */
+    window = nk_window_find(&ctx, "test.tab.first");
+    if (window != NULL) {
+        window->scrollbar.y = 40u;
+    }
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_select_tab_at(&workspace, 1u) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_slot_active_tab(&workspace, FISSION_NK_PANEL_SLOT_LEFT) == 1u);
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1280, 720));
+    fission_test_frame(&ctx, &workspace, 1280, 720);
+    fission_test_frame(&ctx, &workspace, 1280, 720);
+    FISSION_TEST_CHECK(nk_window_find(&ctx, "test.tab.first") == window);
+    if (window != NULL) {
+        FISSION_TEST_CHECK((window->flags & NK_WINDOW_HIDDEN) != 0u);
+        FISSION_TEST_CHECK(window->scrollbar.y == 40u);
+    }
+    FISSION_TEST_CHECK(nk_window_find(&ctx, "test.tab.second") != NULL);
+
+    /* Selecting it again shows the same window. */
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_select_tab_at(&workspace, 0u) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1280, 720));
+    FISSION_TEST_CHECK(nk_window_find(&ctx, "test.tab.first") == window);
+    if (window != NULL) {
+        FISSION_TEST_CHECK((window->flags & NK_WINDOW_HIDDEN) == 0u);
+    }
+
+    /* Hiding the selected tab hands the slot to the first remaining one; showing it reselects it. */
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_visible_at(&workspace, 0u, 0) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1280, 720));
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_slot_active_tab(&workspace, FISSION_NK_PANEL_SLOT_LEFT) == 1u);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_visible_at(&workspace, 0u, 1) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_slot_active_tab(&workspace, FISSION_NK_PANEL_SLOT_LEFT) == 0u);
+
+    /* Docking a panel into the slot selects it; hidden or floating panels cannot be selected. */
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_slot_at(&workspace, 2u, FISSION_NK_PANEL_SLOT_LEFT) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_slot_active_tab(&workspace, FISSION_NK_PANEL_SLOT_LEFT) == 2u);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_detached_at(&workspace, 1u, 1) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_select_tab_at(&workspace, 1u) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_visible_at(&workspace, 1u, 0) == FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_select_tab_at(&workspace, 1u) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+
+    /* Untabbing the slot stacks its panels again. */
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_slot_tabbed(&workspace, FISSION_NK_PANEL_SLOT_LEFT, 0) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_slot_active_tab(&workspace, FISSION_NK_PANEL_SLOT_LEFT) == 3u);
+    FISSION_TEST_CHECK(fission_test_frame_resolves(&ctx, &workspace, 1280, 720));
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_get_panel_bounds(&workspace, "test.tab.first", &first_bounds) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_get_panel_bounds(&workspace, "test.tab.center", &second_bounds) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(second_bounds.y > first_bounds.y);
+
+    fission_nk_panel_workspace_shutdown(&workspace);
+    nk_free(&ctx);
+}
+
+static void fission_test_capture_bounds(
+    const fission_nk_panel_workspace_t *workspace,
+    const char *const *panel_ids,
+    fission_nk_panel_bounds_t *out_bounds
+)
+{
+    size_t i;
+
+    for (i = 0u; i < FISSION_TEST_CACHE_PANELS; ++i) {
+        memset(&out_bounds[i], 0, sizeof(out_bounds[i]));
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_get_panel_bounds(workspace, panel_ids[i], &out_bounds[i]) ==
+            FISSION_NK_PANEL_STATUS_OK
+        );
+    }
+}
+
+/* Hidden panels keep whatever bounds they last had, so only visible ones are compared. */
+static int fission_test_bounds_match(
+    const fission_nk_panel_workspace_t *workspace,
+    const char *const *panel_ids,
+    const fission_nk_panel_bounds_t *expected
+)
+{
+    fission_nk_panel_bounds_t actual[FISSION_TEST_CACHE_PANELS];
+    size_t i;
+
+    fission_test_capture_bounds(workspace, panel_ids, actual);
+    for (i = 0u; i < FISSION_TEST_CACHE_PANELS; ++i) {
+        if (fission_nk_panel_workspace_panel_is_visible(workspace, panel_ids[i]) == 0) {
+            continue;
+        }
+        if (
+            actual[i].x != expected[i].x ||
+            actual[i].y != expected[i].y ||
+            actual[i].w != expected[i].w ||
+            actual[i].h != expected[i].h
+        ) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void fission_test_layout_cache(void)
+{
+    static const char *const panel_ids[FISSION_TEST_CACHE_PANELS] = {
+        "test.left",
+        "test.center",
+        "test.right",
+        "test.bottom"
+    };
+    static const fission_nk_panel_slot_t panel_slots[FISSION_TEST_CACHE_PANELS] = {
+        FISSION_NK_PANEL_SLOT_LEFT,
+        FISSION_NK_PANEL_SLOT_CENTER,
+        FISSION_NK_PANEL_SLOT_RIGHT,
+        FISSION_NK_PANEL_SLOT_BOTTOM
+    };
+    struct nk_context ctx;
+    struct nk_user_font font;
+    fission_nk_panel_workspace_t workspace;
+    fission_nk_panel_desc_t desc;
+    fission_nk_panel_bounds_t shown[FISSION_TEST_CACHE_PANELS];
+    fission_nk_panel_bounds_t hidden[FISSION_TEST_CACHE_PANELS];
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long hits_before;
+    unsigned long long misses_before;
+    size_t right;
+    size_t i;
+
+    if (fission_test_context_init(&ctx, &font) == 0) {
+        return;
+    }
+
+    fission_nk_panel_workspace_init(&workspace);
+    for (i = 0u; i < FISSION_TEST_CACHE_PANELS; ++i) {
+        fission_test_panel_desc(panel_ids[i], panel_slots[i], &desc);
+        FISSION_TEST_CHECK(fission_nk_panel_workspace_register(&workspace, &desc) == FISSION_NK_PANEL_STATUS_OK);
+    }
+    right = 2u;
+
+    /* Both configurations are resolved once from scratch and land in the cache. */
+    fission_test_frame(&ctx, &workspace, 1280, 720);
+    fission_test_capture_bounds(&workspace, panel_ids, shown);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_visible_at(&workspace, right, 0) == FISSION_NK_PANEL_STATUS_OK
+    );
+    fission_test_frame(&ctx, &workspace, 1280, 720);
+    fission_test_capture_bounds(&workspace, panel_ids, hidden);
+    FISSION_TEST_CHECK(shown[1].w != hidden[1].w);
+
+    /* Toggling back and forth revisits them, and every revisit must be a hit. */
+    fission_nk_panel_workspace_get_layout_cache_stats(&workspace, &hits_before, &misses_before);
+    for (i = 0u; i < 3u; ++i) {
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_set_panel_visible_at(&workspace, right, 1) == FISSION_NK_PANEL_STATUS_OK
+        );
+        fission_test_frame(&ctx, &workspace, 1280, 720);
+        FISSION_TEST_CHECK(fission_test_bounds_match(&workspace, panel_ids, shown));
+        FISSION_TEST_CHECK(
+            fission_nk_panel_workspace_set_panel_visible_at(&workspace, right, 0) == FISSION_NK_PANEL_STATUS_OK
+        );
+        fission_test_frame(&ctx, &workspace, 1280, 720);
+        FISSION_TEST_CHECK(fission_test_bounds_match(&workspace, panel_ids, hidden));
+    }
+    fission_nk_panel_workspace_get_layout_cache_stats(&workspace, &hits, &misses);
+    FISSION_TEST_CHECK(hits >= hits_before + 6u);
+    FISSION_TEST_CHECK(misses == misses_before);
+
+    /* A resize away and back is a hit as well. */
+    fission_test_frame(&ctx, &workspace, 1000, 600);
+    fission_nk_panel_workspace_get_layout_cache_stats(&workspace, &hits_before, &misses_before);
+    fission_test_frame(&ctx, &workspace, 1280, 720);
+    FISSION_TEST_CHECK(fission_test_bounds_match(&workspace, panel_ids, hidden));
+    fission_nk_panel_workspace_get_layout_cache_stats(&workspace, &hits, &misses);
+    FISSION_TEST_CHECK(hits == hits_before + 1u && misses == misses_before);
+
+    /* With the cache off, fresh resolves must agree with what the hits returned. */
+    fission_nk_panel_workspace_enable_layout_cache(&workspace, 0);
+    fission_nk_panel_workspace_get_layout_cache_stats(&workspace, &hits_before, &misses);
+    fission_nk_panel_workspace_invalidate_layout(&workspace);
+    fission_test_frame(&ctx, &workspace, 1280, 720);
+    FISSION_TEST_CHECK(fission_test_bounds_match(&workspace, panel_ids, hidden));
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_visible_at(&workspace, right, 1) == FISSION_NK_PANEL_STATUS_OK
+    );
+    fission_test_frame(&ctx, &workspace, 1280, 720);
+    FISSION_TEST_CHECK(fission_test_bounds_match(&workspace, panel_ids, shown));
+    fission_nk_panel_workspace_get_layout_cache_stats(&workspace, &hits, &misses);
+    FISSION_TEST_CHECK(hits == hits_before);
+
+    /* The same visible set with a different tab selection is a different layout. */
+    fission_nk_panel_workspace_enable_layout_cache(&workspace, 1);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_slot_tabbed(&workspace, FISSION_NK_PANEL_SLOT_CENTER, 1) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_set_panel_slot_at(&workspace, 0u, FISSION_NK_PANEL_SLOT_CENTER) ==
+        FISSION_NK_PANEL_STATUS_OK
+    );
+    fission_test_frame(&ctx, &workspace, 1280, 720);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_select_tab_at(&workspace, 1u) == FISSION_NK_PANEL_STATUS_OK
+    );
+    fission_nk_panel_workspace_get_layout_cache_stats(&workspace, &hits_before, &misses_before);
+    fission_test_frame(&ctx, &workspace, 1280, 720);
+    fission_nk_panel_workspace_get_layout_cache_stats(&workspace, &hits, &misses);
+    FISSION_TEST_CHECK(misses == misses_before + 1u);
+    FISSION_TEST_CHECK(fission_nk_panel_workspace_slot_active_tab(&workspace, FISSION_NK_PANEL_SLOT_CENTER) == 1u);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_workspace_select_tab_at(&workspace, 0u) == FISSION_NK_PANEL_STATUS_OK
+    );
+    fission_test_frame(&ctx, &workspace, 1280, 720);
+    fission_nk_panel_workspace_get_layout_cache_stats(&workspace, &hits, &misses);
+    FISSION_TEST_CHECK(hits == hits_before + 1u);
+
+    fission_nk_panel_workspace_shutdown(&workspace);
+    nk_free(&ctx);
+}
+
+static int fission_test_near(float value, float expected)
+{
+    float diff;
+
+    diff = value - expected;
+    return diff < 0.01f && diff > -0.01f;
+}
+
+static void fission_test_layout_input(
+    int window_width,
+    int window_height,
+    fission_nk_panel_layout_input_t *out_input
+)
+{
+    memset(out_input, 0, sizeof(*out_input));
+    out_input->window_width = window_width;
+    out_input->window_height = window_height;
+    out_input->left_column_ratio = 0.25f;
+    out_input->right_column_ratio = 0.25f;
+    out_input->top_row_ratio = 0.25f;
+    out_input->bottom_row_ratio = 0.25f;
+}
+
+/*
+ * A 1612x946 window leaves a 1588x888 dock area at (12, 46) after the margins and the menu
+ * bar, and splits reserve a 10px gap; the ratios below keep every extent exact in float.
+ */
+static void fission_test_layout_solve(void)
+{
+    fission_nk_panel_layout_input_t input;
+    fission_nk_panel_layout_input_t input_copy;
+    fission_nk_panel_layout_result_t result;
+    fission_nk_panel_layout_result_t again;
+    fission_nk_panel_bounds_t panels[5];
+    const fission_nk_panel_bounds_t *slot;
+    size_t i;
+
+    fission_test_layout_input(1612, 946, &input);
+    FISSION_TEST_CHECK(
+        fission_nk_panel_layout_solve(NULL, &result, NULL) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+    FISSION_TEST_CHECK(
+        fission_nk_panel_layout_solve(&input, NULL, NULL) == FISSION_NK_PANEL_STATUS_INVALID_ARGUMENT
+    );
+
+    /* Nothing docked: only the dock area is filled in. */
+    FISSION_TEST_CHECK(fission_nk_panel_layout_solve(&input, &result, NULL) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(fission_test_bounds_are(&result.dock_workspace_bounds, 12.0f, 46.0f, 1588.0f, 888.0f));
+    for (i = 0u; i < (size_t)FISSION_NK_PANEL_SLOT_COUNT; ++i) {
+        FISSION_TEST_CHECK(fission_test_bounds_are(&result.slot_bounds[i], 0.0f, 0.0f, 0.0f, 0.0f));
+    }
+    FISSION_TEST_CHECK(fission_test_bounds_are(&result.splitter_left_bounds, 0.0f, 0.0f, 0.0f, 0.0f));
+    FISSION_TEST_CHECK(fission_test_bounds_are(&result.splitter_top_bounds, 0.0f, 0.0f, 0.0f, 0.0f));
+
+    /* A lone center slot fills the dock area. */
+    input.slot_counts[FISSION_NK_PANEL_SLOT_CENTER] = 1u;
+    FISSION_TEST_CHECK(fission_nk_panel_layout_solve(&input, &result, NULL) == FISSION_NK_PANEL_STATUS_OK);
+    slot = &result.slot_bounds[FISSION_NK_PANEL_SLOT_CENTER];
+    FISSION_TEST_CHECK(memcmp(slot, &result.dock_workspace_bounds, sizeof(*slot)) == 0);
+    FISSION_TEST_CHECK(fission_test_bounds_are(&result.splitter_left_bounds, 0.0f, 0.0f, 0.0f, 0.0f));
+
+    /* Left column: 25% of the width left after the gap, with a splitter in the gap. */
+    input.slot_counts[FISSION_NK_PANEL_SLOT_LEFT] = 1u;
+    FISSION_TEST_CHECK(fission_nk_panel_layout_solve(&input, &result, NULL) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(
+        fission_test_bounds_are(&result.slot_bounds[FISSION_NK_PANEL_SLOT_LEFT], 12.0f, 46.0f, 394.5f, 888.0f)
+    );
+    FISSION_TEST_CHECK(fission_test_bounds_are(&result.splitter_left_bounds, 406.5f, 46.0f, 10.0f, 888.0f));
+    FISSION_TEST_CHECK(
+        fission_test_bounds_are(&result.slot_bounds[FISSION_NK_PANEL_SLOT_CENTER], 416.5f, 46.0f, 1183.5f, 888.0f)
+    );
+    FISSION_TEST_CHECK(fission_test_bounds_are(&result.splitter_right_bounds, 0.0f, 0.0f, 0.0f, 0.0f));
+
+    /* A column below its minimum width takes the difference from the center. */
+    input.left_column_ratio = 0.01f;
+    FISSION_TEST_CHECK(fission_nk_panel_layout_solve(&input, &result, NULL) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(result.slot_bounds[FISSION_NK_PANEL_SLOT_LEFT].w == 220.0f);
+    slot = &result.slot_bounds[FISSION_NK_PANEL_SLOT_CENTER];
+    FISSION_TEST_CHECK(fission_test_near(slot->x, 242.0f) && fission_test_near(slot->x + slot->w, 1600.0f));
+    input.left_column_ratio = 0.25f;
+
+    /*
+     * With the top-left corner empty, the more recently docked of left and top takes it
+     * (left on a tie). The top band is 25% of the height left after the gap.
+     */
+    input.slot_counts[FISSION_NK_PANEL_SLOT_TOP] = 1u;
+    input.slot_touch_serial[FISSION_NK_PANEL_SLOT_LEFT] = 2u;
+    input.slot_touch_serial[FISSION_NK_PANEL_SLOT_TOP] = 1u;
+    FISSION_TEST_CHECK(fission_nk_panel_layout_solve(&input, &result, NULL) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(
+        fission_test_bounds_are(&result.slot_bounds[FISSION_NK_PANEL_SLOT_LEFT], 12.0f, 46.0f, 394.5f, 888.0f)
+    );
+    FISSION_TEST_CHECK(
+        fission_test_bounds_are(&result.slot_bounds[FISSION_NK_PANEL_SLOT_TOP], 416.5f, 46.0f, 1183.5f, 219.5f)
+    );
+    FISSION_TEST_CHECK(fission_test_bounds_are(&result.splitter_top_bounds, 12.0f, 265.5f, 1588.0f, 10.0f));
+    FISSION_TEST_CHECK(fission_test_bounds_are(&result.splitter_left_bounds, 406.5f, 275.5f, 10.0f, 658.5f));
+    FISSION_TEST_CHECK(
+        fission_test_bounds_are(&result.slot_bounds[FISSION_NK_PANEL_SLOT_CENTER], 416.5f, 275.5f, 1183.5f, 658.5f)
+    );
+    input.slot_touch_serial[FISSION_NK_PANEL_SLOT_TOP] = 3u;
+    FISSION_TEST_CHECK(fission_nk_panel_layout_solve(&input, &result, NULL) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(
+        fission_test_bounds_are(&result.slot_bounds[FISSION_NK_PANEL_SLOT_TOP], 12.0f, 46.0f, 1588.0f, 219.5f)
+    );
+    FISSION_TEST_CHECK(
+        fission_test_bounds_are(&result.slot_bounds[FISSION_NK_PANEL_SLOT_LEFT], 12.0f, 275.5f, 394.5f, 658.5f)
+    );
+    input.slot_touch_serial[FISSION_NK_PANEL_SLOT_TOP] = 2u;
+    FISSION_TEST_CHECK(fission_nk_panel_layout_solve(&input, &result, NULL) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(result.slot_bounds[FISSION_NK_PANEL_SLOT_LEFT].y == 46.0f);
+
+    /* A docked corner slot belongs to neither neighbour. */
+    input.slot_counts[FISSION_NK_PANEL_SLOT_TOP_LEFT] = 1u;
+    FISSION_TEST_CHECK(fission_nk_panel_layout_solve(&input, &result, NULL) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(
+        fission_test_bounds_are(&result.slot_bounds[FISSION_NK_PANEL_SLOT_TOP_LEFT], 12.0f, 46.0f, 394.5f, 219.5f)
+    );
+    FISSION_TEST_CHECK(result.slot_bounds[FISSION_NK_PANEL_SLOT_LEFT].y == 275.5f);
+    FISSION_TEST_CHECK(result.slot_bounds[FISSION_NK_PANEL_SLOT_TOP].x == 416.5f);
+
+    /*
+     * Per-panel rects come slot by slot: two in the left slot stacked top to bottom, one in
+     * the center, two in the bottom slot side by side.
+     */
+    fission_test_layout_input(1612, 946, &input);
+    input.slot_counts[FISSION_NK_PANEL_SLOT_LEFT] = 2u;
+    input.slot_counts[FISSION_NK_PANEL_SLOT_CENTER] = 1u;
+    input.slot_counts[FISSION_NK_PANEL_SLOT_BOTTOM] = 2u;
+    input_copy = input;
+    FISSION_TEST_CHECK(fission_nk_panel_layout_solve(&input, &result, panels) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(memcmp(&input, &input_copy, sizeof(input)) == 0);
+    slot = &result.slot_bounds[FISSION_NK_PANEL_SLOT_LEFT];
+    FISSION_TEST_CHECK(panels[0].x == slot->x && panels[0].w == slot->w && panels[0].y == slot->y);
+    FISSION_TEST_CHECK(panels[1].x == slot->x && panels[1].w == slot->w && panels[1].h == panels[0].h);
+    FISSION_TEST_CHECK(fission_test_near(panels[1].y, panels[0].y + panels[0].h + 10.0f));
+    FISSION_TEST_CHECK(fission_test_near(panels[1].y + panels[1].h, slot->y + slot->h));
+    FISSION_TEST_CHECK(
+        memcmp(&panels[2], &result.slot_bounds[FISSION_NK_PANEL_SLOT_CENTER], sizeof(panels[2])) == 0
+    );
+    slot = &result.slot_bounds[FISSION_NK_PANEL_SLOT_BOTTOM];
+    FISSION_TEST_CHECK(panels[3].y == slot->y && panels[3].h == slot->h && panels[3].x == slot->x);
+    FISSION_TEST_CHECK(panels[4].y == slot->y && panels[4].h == slot->h && panels[4].w == panels[3].w);
+    FISSION_TEST_CHECK(fission_test_near(panels[4].x, panels[3].x + panels[3].w + 10.0f));
+    FISSION_TEST_CHECK(fission_test_near(panels[4].x + panels[4].w, slot->x + slot->w));
+
+    /* Pure: the same input always gives the same result. */
+    FISSION_TEST_CHECK(fission_nk_panel_layout_solve(&input, &again, NULL) == FISSION_NK_PANEL_STATUS_OK);
+    FISSION_TEST_CHECK(memcmp(&result, &again, sizeof(result)) == 0);
+}
+
+int main(void)
+{
+    fission_test_id_table();
+    fission_test_handles();
+    fission_test_dynamic_growth();
+    fission_test_lazy_init();
+    fission_test_stale_handle();
+    fission_test_free_list();
+    fission_test_adopt_table();
+    fission_test_register_many();
+    fission_test_layout_dirty();
+    fission_test_dock_tree_edit();
+    fission_test_dock_tree_layout();
+    fission_test_dock_tree_workspace();
+    fission_test_tabbed_slot();
+    fission_test_layout_cache();
+    fission_test_layout_solve();
+
+    if (fission_test_failures != 0) {
+        fprintf(stderr, "fission_panels_test: %d check(s) failed\n", fission_test_failures);
+        return 1;
+    }
+    printf("fission_panels_test: all checks passed\n");
+    return 0;
+}